@@ -0,0 +1,93 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#endif
+
+//
+// CRC-32C (Castagnoli), for running digests of long streams. Builds with
+// SSE4.2 enabled use the CRC32 instruction, and everything else uses a
+// slicing-by-8 table. Both produce the same values, so digests can be
+// compared across machines.
+//
+
+namespace BlocksCRC
+{
+    namespace detail
+    {
+        struct CRC32CTables
+        {
+            std::uint32_t table[8][256];
+
+            CRC32CTables()
+            {
+                static constexpr std::uint32_t Polynomial = 0x82f63b78; // Reflected
+
+                for(std::uint32_t byte = 0; byte < 256; ++byte)
+                {
+                    auto crc = byte;
+                    for(int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ ((crc & 1) ? Polynomial : 0);
+                    table[0][byte] = crc;
+                }
+                for(size_t slice = 1; slice < 8; ++slice)
+                {
+                    for(size_t byte = 0; byte < 256; ++byte)
+                    {
+                        const auto prev = table[slice-1][byte];
+                        table[slice][byte] = (prev >> 8) ^ table[0][prev & 0xff];
+                    }
+                }
+            }
+        };
+
+        inline const CRC32CTables& crc32cTables()
+        {
+            static const CRC32CTables tables;
+            return tables;
+        }
+    }
+
+    // Continues the CRC of everything before this data. Start with 0.
+    inline std::uint32_t crc32c(std::uint32_t crc, const void* data, size_t len)
+    {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        crc = ~crc;
+
+#ifdef __SSE4_2__
+        for(; len >= 8; len -= 8, bytes += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, sizeof(word));
+            crc = std::uint32_t(_mm_crc32_u64(crc, word));
+        }
+        for(; len > 0; --len, ++bytes)
+        {
+            crc = _mm_crc32_u8(crc, *bytes);
+        }
+#else
+        const auto& table = detail::crc32cTables().table;
+        for(; len >= 8; len -= 8, bytes += 8)
+        {
+            const auto lo = crc ^ (std::uint32_t(bytes[0]) | (std::uint32_t(bytes[1]) << 8) |
+                                   (std::uint32_t(bytes[2]) << 16) | (std::uint32_t(bytes[3]) << 24));
+            crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+                  table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+                  table[3][bytes[4]] ^ table[2][bytes[5]] ^
+                  table[1][bytes[6]] ^ table[0][bytes[7]];
+        }
+        for(; len > 0; --len, ++bytes)
+        {
+            crc = (crc >> 8) ^ table[0][(crc ^ *bytes) & 0xff];
+        }
+#endif
+
+        return ~crc;
+    }
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//
+// Pseudo-random binary sequences, as used for bit error rate testing.
+//
+// Each sequence comes from a primitive trinomial x^order + x^tap + 1, so it
+// repeats every 2^order - 1 bits. Since every bit only depends on bits at
+// least tap bits back, tap bits are produced per step instead of one. Bits
+// are packed into bytes most significant bit first.
+//
+
+namespace BlocksPRBS
+{
+    struct Polynomial
+    {
+        size_t order;
+        size_t tap;
+    };
+
+    // The polynomials of ITU-T O.150 and common test equipment, without
+    // the output inversion some of them specify
+    static constexpr Polynomial Polynomials[] =
+    {
+        {7, 6},
+        {9, 5},
+        {11, 9},
+        {15, 14},
+        {20, 17},
+        {23, 18},
+        {29, 27},
+        {31, 28},
+    };
+
+    // Returns false for orders without a polynomial here
+    inline bool findPolynomial(size_t order, Polynomial& polynomial)
+    {
+        for(const auto& candidate: Polynomials)
+        {
+            if(candidate.order != order) continue;
+            polynomial = candidate;
+            return true;
+        }
+
+        return false;
+    }
+
+    class Generator
+    {
+    public:
+        // The order must have a polynomial (see findPolynomial()).
+        explicit Generator(size_t order = 31, std::uint64_t seed = 1):
+            _polynomial{31, 28}
+        {
+            findPolynomial(order, _polynomial);
+            this->seed(seed);
+        }
+
+        size_t order() const
+        {
+            return _polynomial.order;
+        }
+
+        // The register's initial bits, which cannot all be zero
+        void seed(std::uint64_t seed)
+        {
+            _history = seed & this->mask(_polynomial.order);
+            if(0 == _history) _history = this->mask(_polynomial.order);
+
+            _acc = 0;
+            _accBits = 0;
+        }
+
+        // Starts after the given bits, oldest in the most significant
+        // position, such as the last order bits received.
+        void setHistory(std::uint64_t history)
+        {
+            this->seed(history);
+        }
+
+        // The next tap bits of the sequence, oldest in the most significant position
+        std::uint64_t nextBits()
+        {
+            const auto order = _polynomial.order;
+            const auto tap = _polynomial.tap;
+
+            const auto bits = ((_history >> (order - tap)) ^ _history) & this->mask(tap);
+            _history = ((_history << tap) | bits) & this->mask(order);
+
+            return bits;
+        }
+
+        size_t bitsPerStep() const
+        {
+            return _polynomial.tap;
+        }
+
+        void generateBytes(void* out, size_t len)
+        {
+            auto* outBytes = static_cast<std::uint8_t*>(out);
+            const auto tap = _polynomial.tap;
+
+            for(size_t byte = 0; byte < len; ++byte)
+            {
+                while(_accBits < 8)
+                {
+                    _acc = (_acc << tap) | this->nextBits();
+                    _accBits += tap;
+                }
+
+                _accBits -= 8;
+                outBytes[byte] = std::uint8_t(_acc >> _accBits);
+                _acc &= this->mask(_accBits);
+            }
+        }
+
+    private:
+        Polynomial _polynomial;
+        std::uint64_t _history; // Newest bit in the least significant position
+
+        // Generated bits that have not been written out yet
+        std::uint64_t _acc;
+        size_t _accBits;
+
+        static constexpr std::uint64_t mask(size_t bits)
+        {
+            return (bits >= 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << bits) - 1);
+        }
+    };
+}
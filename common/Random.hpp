@@ -0,0 +1,211 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+
+//
+// A seedable xoshiro256++ generator for the random tester blocks.
+//
+// The generator runs several independent streams side by side, stored as
+// one array per state word, so each step is a plain loop over the lanes
+// that the compiler can vectorize. Outputs are interleaved across lanes,
+// so a given seed always produces the same sequence, whether values are
+// drawn one at a time or in bulk. It meets the UniformRandomBitGenerator
+// requirements, so it also works with the standard distributions.
+//
+
+namespace BlocksRandom
+{
+    // A seed for blocks that were not given one
+    inline std::uint64_t randomSeed()
+    {
+        std::random_device rd;
+        return (std::uint64_t(rd()) << 32) ^ std::uint64_t(rd());
+    }
+
+    class Xoshiro256
+    {
+    public:
+        using result_type = std::uint64_t;
+
+        static constexpr size_t Lanes = 4;
+
+        explicit Xoshiro256(std::uint64_t seed = randomSeed())
+        {
+            this->seed(seed);
+        }
+
+        static constexpr result_type min()
+        {
+            return 0;
+        }
+
+        static constexpr result_type max()
+        {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        // Each lane's state is expanded from the seed with splitmix64, as
+        // recommended by the xoshiro authors, so no lane starts at zero.
+        void seed(std::uint64_t seed)
+        {
+            for(size_t lane = 0; lane < Lanes; ++lane)
+            {
+                for(size_t word = 0; word < 4; ++word)
+                {
+                    seed += 0x9e3779b97f4a7c15ULL;
+
+                    auto z = seed;
+                    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                    _state[word][lane] = z ^ (z >> 31);
+                }
+            }
+
+            _blockPos = Lanes;
+        }
+
+        result_type operator()()
+        {
+            if(Lanes == _blockPos)
+            {
+                this->step(_block);
+                _blockPos = 0;
+            }
+
+            return _block[_blockPos++];
+        }
+
+        // Equivalent to calling operator() len times
+        void fill(result_type* out, size_t len)
+        {
+            while((len > 0) && (_blockPos < Lanes))
+            {
+                *out++ = _block[_blockPos++];
+                --len;
+            }
+            for(; len >= Lanes; len -= Lanes, out += Lanes)
+            {
+                this->step(out);
+            }
+            for(; len > 0; --len)
+            {
+                *out++ = (*this)();
+            }
+        }
+
+        void fillBytes(void* out, size_t len)
+        {
+            auto* outBytes = static_cast<std::uint8_t*>(out);
+
+            result_type words[64];
+            while(len > 0)
+            {
+                const auto numBytes = std::min(len, sizeof(words));
+                const auto numWords = (numBytes + sizeof(result_type) - 1) / sizeof(result_type);
+
+                this->fill(words, numWords);
+                std::memcpy(outBytes, words, numBytes);
+
+                outBytes += numBytes;
+                len -= numBytes;
+            }
+        }
+
+        // Uniform in [0, range), by rejection, so unlike the standard
+        // distributions, the result is the same with any standard library.
+        // A range of 0 means the full 64 bits.
+        result_type below(result_type range)
+        {
+            if(0 == range) return (*this)();
+
+            // The largest multiple of the range that fits, so there is no modulo bias
+            const auto limit = std::numeric_limits<result_type>::max() - (std::numeric_limits<result_type>::max() % range);
+
+            result_type value;
+            do value = (*this)();
+            while(value >= limit);
+
+            return value % range;
+        }
+
+        // Uniform in [0.0, 1.0), from the top 53 bits of the output
+        double uniform()
+        {
+            return toUniform((*this)());
+        }
+
+        void fillUniform(double* out, size_t len)
+        {
+            result_type words[64];
+            while(len > 0)
+            {
+                const auto numWords = std::min(len, (sizeof(words) / sizeof(words[0])));
+
+                this->fill(words, numWords);
+                for(size_t elem = 0; elem < numWords; ++elem) out[elem] = toUniform(words[elem]);
+
+                out += numWords;
+                len -= numWords;
+            }
+        }
+
+        // How many Bernoulli trials with the given probability fail before
+        // the next success, so callers can skip straight to it.
+        size_t geometric(double probability)
+        {
+            if(probability >= 1.0) return 0;
+            if(probability <= 0.0) return std::numeric_limits<size_t>::max();
+
+            // 1-u is in (0.0, 1.0], so the log is finite.
+            const auto skip = std::floor(std::log(1.0 - this->uniform()) / std::log1p(-probability));
+
+            return (skip >= double(std::numeric_limits<size_t>::max())) ? std::numeric_limits<size_t>::max()
+                                                                          : size_t(skip);
+        }
+
+    private:
+        result_type _state[4][Lanes];
+
+        result_type _block[Lanes];
+        size_t _blockPos;
+
+        static inline result_type rotl(result_type x, int k)
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        static inline double toUniform(result_type x)
+        {
+            return double(x >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        void step(result_type* out)
+        {
+            auto* s0 = _state[0];
+            auto* s1 = _state[1];
+            auto* s2 = _state[2];
+            auto* s3 = _state[3];
+
+            for(size_t lane = 0; lane < Lanes; ++lane)
+            {
+                out[lane] = rotl(s0[lane] + s3[lane], 23) + s0[lane];
+
+                const auto t = s1[lane] << 17;
+                s2[lane] ^= s0[lane];
+                s3[lane] ^= s1[lane];
+                s1[lane] ^= s2[lane];
+                s0[lane] ^= s3[lane];
+                s2[lane] ^= t;
+                s3[lane] = rotl(s3[lane], 45);
+            }
+        }
+    };
+}
@@ -0,0 +1,116 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+//
+// Included by SIMD source files after POTHOS_SIMD_NAMESPACE is checked.
+// Everything here is built once per architecture, so it must stay in
+// that architecture's namespace.
+//
+// Kernels are split into a scalar head that runs until the input is
+// aligned, a SIMD body that uses aligned loads (and aligned stores if the
+// output ended up aligned too), and a scalar tail. Pothos buffers start
+// aligned, so unless a block consumed a partial frame, the head is empty.
+//
+
+#include <xsimd/xsimd.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace PothosBlocksSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    // Tags selecting the load and store instructions
+    struct AlignedMode {};
+    struct UnalignedMode {};
+
+    template <typename T>
+    static inline auto simdLoad(const T* in, AlignedMode) -> decltype(xsimd::load_aligned(in))
+    {
+        return xsimd::load_aligned(in);
+    }
+
+    template <typename T>
+    static inline auto simdLoad(const T* in, UnalignedMode) -> decltype(xsimd::load_unaligned(in))
+    {
+        return xsimd::load_unaligned(in);
+    }
+
+    template <typename T, typename Batch>
+    static inline void simdStore(T* out, const Batch& reg, AlignedMode)
+    {
+        reg.store_aligned(out);
+    }
+
+    template <typename T, typename Batch>
+    static inline void simdStore(T* out, const Batch& reg, UnalignedMode)
+    {
+        reg.store_unaligned(out);
+    }
+
+    template <typename T>
+    static inline bool isSIMDAligned(const T* ptr)
+    {
+        static constexpr size_t Alignment = xsimd::simd_traits<T>::size * sizeof(T);
+
+        return (0 == (reinterpret_cast<std::uintptr_t>(ptr) % Alignment));
+    }
+
+    // How a buffer of len elements is divided between the head, body, and
+    // tail. Body lengths are always a multiple of the register size.
+    struct SIMDSplit
+    {
+        size_t head;
+        size_t body;
+        size_t tail;
+        bool inAligned;
+        bool outAligned;
+    };
+
+    // The head only aligns the input. Pointers that aren't aligned to
+    // their own element size can never be aligned, so they get no head.
+    template <typename InT, typename OutT>
+    static inline SIMDSplit splitForSIMD(const InT* in, const OutT* out, size_t len)
+    {
+        static constexpr size_t SIMDSize = xsimd::simd_traits<InT>::size;
+        static constexpr size_t Alignment = SIMDSize * sizeof(InT);
+
+        const auto misalignment = reinterpret_cast<std::uintptr_t>(in) % Alignment;
+
+        SIMDSplit split;
+        split.head = ((0 == misalignment) || (0 != (misalignment % sizeof(InT)))) ? 0 :
+                     std::min(len, ((Alignment - misalignment) / sizeof(InT)));
+        split.body = ((len - split.head) / SIMDSize) * SIMDSize;
+        split.tail = len - split.head - split.body;
+        split.inAligned = isSIMDAligned(in + split.head);
+        split.outAligned = isSIMDAligned(out + split.head);
+
+        return split;
+    }
+
+    // Calls Body::run<InMode, OutMode>(in, out, len, args...) with the
+    // modes matching the split, and pointers already past the head.
+    template <typename Body, typename InT, typename OutT, typename... Args>
+    static inline void runSIMDBody(const SIMDSplit& split, const InT* in, OutT* out, Args&&... args)
+    {
+        in += split.head;
+        out += split.head;
+
+        if(split.inAligned)
+        {
+            if(split.outAligned) Body::template run<AlignedMode, AlignedMode>(in, out, split.body, args...);
+            else                 Body::template run<AlignedMode, UnalignedMode>(in, out, split.body, args...);
+        }
+        else
+        {
+            if(split.outAligned) Body::template run<UnalignedMode, AlignedMode>(in, out, split.body, args...);
+            else                 Body::template run<UnalignedMode, UnalignedMode>(in, out, split.body, args...);
+        }
+    }
+}
+
+}}
@@ -0,0 +1,219 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include "common/SIMDRegistry.hpp"
+
+#include <Pothos/Exception.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+//
+// Blocks resolve their SIMD implementation on construction. By default,
+// this is what the generated dispatcher picks for the current CPU. The
+// POTHOS_BLOCKS_SIMD_ARCH environment variable overrides the default for
+// every block that has an implementation for that architecture, and each
+// block can be overridden at runtime. The "scalar" implementation is
+// built with the baseline compiler flags and is always available.
+//
+
+namespace BlocksSIMD
+{
+    static const std::string ScalarArch = "scalar";
+    static const std::string UnknownArch = "unknown";
+    static const char* const ArchEnvironmentVariable = "POTHOS_BLOCKS_SIMD_ARCH";
+
+    // The largest register alignment of any architecture (AVX-512)
+    static constexpr size_t MaxSIMDAlignment = 64;
+
+    // The smallest number of elements of the given size that spans a
+    // multiple of MaxSIMDAlignment bytes.
+    //
+    // Blocks with a setSIMDAligned() option reserve and consume only
+    // multiples of this, so their buffers stay as aligned as they started
+    // and kernels skip their scalar heads. The cost is that elements past
+    // the last multiple wait for more input.
+    inline size_t simdAlignedElements(size_t elemSize)
+    {
+        size_t a = MaxSIMDAlignment;
+        size_t b = elemSize;
+        while(0 != b)
+        {
+            const auto remainder = a % b;
+            a = b;
+            b = remainder;
+        }
+
+        return MaxSIMDAlignment / a;
+    }
+
+    // Whether the current CPU can run code built for the given architecture.
+    // Architectures that cannot be checked are treated as unsupported.
+    inline bool isArchSupported(std::string arch)
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+
+        std::transform(arch.begin(), arch.end(), arch.begin(), ::tolower);
+
+        // Architectures can combine features, like "fma3_avx2".
+        for(const auto& feature: {"sse4_1", "sse4_2"})
+        {
+            const auto pos = arch.find(feature);
+            if(std::string::npos != pos) arch.erase(pos + 4, 1);
+        }
+
+        size_t start = 0;
+        do
+        {
+            const auto end = std::min(arch.find('_', start), arch.size());
+            const auto token = arch.substr(start, (end - start));
+            start = end + 1;
+
+            bool supported = false;
+            if("sse2" == token)         supported = __builtin_cpu_supports("sse2");
+            else if("sse3" == token)    supported = __builtin_cpu_supports("sse3");
+            else if("ssse3" == token)   supported = __builtin_cpu_supports("ssse3");
+            else if("sse41" == token)   supported = __builtin_cpu_supports("sse4.1");
+            else if("sse42" == token)   supported = __builtin_cpu_supports("sse4.2");
+            else if("avx" == token)     supported = __builtin_cpu_supports("avx");
+            else if("avx2" == token)    supported = __builtin_cpu_supports("avx2");
+            else if("fma3" == token)    supported = __builtin_cpu_supports("fma");
+            else if("fma4" == token)    supported = __builtin_cpu_supports("fma4");
+            else if("avx512f" == token) supported = __builtin_cpu_supports("avx512f");
+            else if("avx512bw" == token) supported = __builtin_cpu_supports("avx512bw");
+            else if("avx512cd" == token) supported = __builtin_cpu_supports("avx512cd");
+            else if("avx512dq" == token) supported = __builtin_cpu_supports("avx512dq");
+            else if("avx512vl" == token) supported = __builtin_cpu_supports("avx512vl");
+
+            if(!supported) return false;
+        } while(start < arch.size());
+
+        return true;
+#else
+        (void)arch;
+        return false;
+#endif
+    }
+
+    template <typename FcnType>
+    class SIMDFunction
+    {
+    public:
+        SIMDFunction(const std::string& name, FcnType defaultFcn, FcnType scalarFcn):
+            _name(name),
+            _defaultFcn(defaultFcn),
+            _scalarFcn(scalarFcn)
+        {
+            _defaultArch = (_defaultFcn == _scalarFcn) ? ScalarArch : this->findArch(_defaultFcn);
+            this->setArch("");
+
+            // Architectures this function was not built for are ignored.
+            const char* envArch = std::getenv(ArchEnvironmentVariable);
+            if(envArch)
+            {
+                const auto archs = this->archs();
+                if(std::find(archs.begin(), archs.end(), envArch) != archs.end()) this->setArch(envArch);
+            }
+        }
+
+        template <typename... Args>
+        inline auto operator()(Args&&... args) const -> decltype(std::declval<FcnType>()(std::forward<Args>(args)...))
+        {
+            return _fcn(std::forward<Args>(args)...);
+        }
+
+        const std::string& arch() const
+        {
+            return _arch;
+        }
+
+        // An empty string restores the default implementation.
+        void setArch(const std::string& arch)
+        {
+            if(arch.empty() || (arch == _defaultArch))
+            {
+                _fcn = _defaultFcn;
+                _arch = _defaultArch;
+            }
+            else if(ScalarArch == arch)
+            {
+                _fcn = _scalarFcn;
+                _arch = ScalarArch;
+            }
+            else
+            {
+                const auto& implementations = this->implementations();
+                const auto iter = implementations.find(arch);
+                if(implementations.end() == iter)
+                {
+                    throw Pothos::InvalidArgumentException(
+                              "No "+_name+" implementation for the given SIMD architecture",
+                              arch);
+                }
+                if(!isArchSupported(arch))
+                {
+                    throw Pothos::InvalidArgumentException(
+                              "The given SIMD architecture is not supported by this CPU",
+                              arch);
+                }
+
+                _fcn = reinterpret_cast<FcnType>(iter->second);
+                _arch = arch;
+            }
+        }
+
+        // The architectures that can be used on this CPU
+        std::vector<std::string> archs() const
+        {
+            std::vector<std::string> archs{ScalarArch};
+            if(ScalarArch != _defaultArch) archs.emplace_back(_defaultArch);
+
+            for(const auto& implementation: this->implementations())
+            {
+                if((implementation.first != _defaultArch) && isArchSupported(implementation.first))
+                {
+                    archs.emplace_back(implementation.first);
+                }
+            }
+
+            return archs;
+        }
+
+    private:
+        std::string _name;
+
+        FcnType _defaultFcn;
+        FcnType _scalarFcn;
+        std::string _defaultArch;
+
+        FcnType _fcn;
+        std::string _arch;
+
+        const std::map<std::string, GenericFcn>& implementations() const
+        {
+            static const std::map<std::string, GenericFcn> empty;
+
+            const auto& allImplementations = getSIMDImplementations();
+            const auto iter = allImplementations.find(SIMDImplementationKey(_name, std::type_index(typeid(FcnType))));
+
+            return (allImplementations.end() == iter) ? empty : iter->second;
+        }
+
+        std::string findArch(FcnType fcn) const
+        {
+            for(const auto& implementation: this->implementations())
+            {
+                if(reinterpret_cast<FcnType>(implementation.second) == fcn) return implementation.first;
+            }
+
+            return UnknownArch;
+        }
+    };
+}
@@ -0,0 +1,31 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "common/SIMDRegistry.hpp"
+
+//
+// Built with the baseline compiler flags, like any other module source,
+// so registering from any architecture's static initializers is safe.
+//
+
+namespace BlocksSIMD
+{
+    static SIMDImplementationMap& getMutableSIMDImplementations()
+    {
+        static SIMDImplementationMap implementations;
+        return implementations;
+    }
+
+    const SIMDImplementationMap& getSIMDImplementations()
+    {
+        return getMutableSIMDImplementations();
+    }
+
+    bool registerSIMDImplementation(const char* name, const std::type_info& fcnType, const char* arch, GenericFcn fcn)
+    {
+        const SIMDImplementationKey key(name, std::type_index(fcnType));
+        getMutableSIMDImplementations()[key][arch] = fcn;
+
+        return true;
+    }
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+//
+// Included by SIMD source files, which are built once per architecture,
+// so this file must not depend on anything built for a single architecture.
+//
+// Anything inline or templated here would be compiled into every
+// architecture's source file, and the linker keeps an arbitrary copy, so
+// the registry is only declared here and is built once in SIMDRegistry.cpp,
+// with the baseline flags. Registration passes it only plain data.
+//
+
+#include <map>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+namespace BlocksSIMD
+{
+    using GenericFcn = void(*)();
+
+    // Key: function name and function pointer type
+    // Value: architecture name -> implementation
+    using SIMDImplementationKey = std::pair<std::string, std::type_index>;
+    using SIMDImplementationMap = std::map<SIMDImplementationKey, std::map<std::string, GenericFcn>>;
+
+    // Filled in by the static initializers in each SIMD source file
+    const SIMDImplementationMap& getSIMDImplementations();
+
+    // Always returns true, so it can initialize a static
+    bool registerSIMDImplementation(const char* name, const std::type_info& fcnType, const char* arch, GenericFcn fcn);
+}
+
+#define BLOCKS_SIMD_STRINGIFY_IMPL(x) #x
+#define BLOCKS_SIMD_STRINGIFY(x) BLOCKS_SIMD_STRINGIFY_IMPL(x)
+
+#define BLOCKS_SIMD_CONCAT_IMPL(x, y) x ## y
+#define BLOCKS_SIMD_CONCAT(x, y) BLOCKS_SIMD_CONCAT_IMPL(x, y)
+
+// Registers an instantiated function under the architecture being built.
+#define BLOCKS_SIMD_REGISTER(name, ...) \
+    static const bool BLOCKS_SIMD_CONCAT(simdImplementationRegistered, __COUNTER__) = \
+        BlocksSIMD::registerSIMDImplementation( \
+            name, \
+            typeid(decltype(&__VA_ARGS__)), \
+            BLOCKS_SIMD_STRINGIFY(POTHOS_SIMD_NAMESPACE), \
+            reinterpret_cast<BlocksSIMD::GenericFcn>(&__VA_ARGS__));
@@ -8,6 +8,7 @@
 #include <cctype> //toupper
 #include <string>
 #include <map>
+#include <memory>
 #include <set>
 #include <iostream>
 
@@ -56,9 +57,22 @@
  * |default {}
  * |preview valid
  *
+ * |param coalesce[Coalesce] Evaluate once per batch of slot updates.
+ * When enabled, slot updates that arrive together are applied first,
+ * and the expression is evaluated once with the latest values.
+ * Use this when upstream updates faster than downstream needs results.
+ * When disabled, every slot update triggers an evaluation.
+ * The evaluationCount probe counts the evaluations; results reused
+ * because no binding changed are not counted.
+ * |option [Enabled] true
+ * |option [Disabled] false
+ * |default false
+ * |preview valid
+ *
  * |factory /blocks/evaluator(vars)
  * |setter setExpression(expr)
  * |setter setGlobals(globals)
+ * |setter setCoalesce(coalesce)
  **********************************************************************/
 class Evaluator : public Pothos::Block
 {
@@ -68,7 +82,13 @@ public:
         return new Evaluator(varNames);
     }
 
-    Evaluator(const std::vector<std::string> &varNames)
+    Evaluator(const std::vector<std::string> &varNames):
+        _evalEnv(std::make_shared<Pothos::Util::EvalEnvironment>()),
+        _expandList(false),
+        _coalesce(false),
+        _resultValid(false),
+        _evalPending(false),
+        _evaluationCount(0)
     {
         for (const auto &name : varNames)
         {
@@ -81,17 +101,22 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(Evaluator, setExpression));
         this->registerCall(this, POTHOS_FCN_TUPLE(Evaluator, getExpression));
         this->registerCall(this, POTHOS_FCN_TUPLE(Evaluator, setGlobals));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Evaluator, setCoalesce));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Evaluator, getCoalesce));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Evaluator, evaluationCount));
+        this->registerProbe("evaluationCount");
     }
 
     void setExpression(const std::string &expr)
     {
         _expr = expr;
 
-        //check that all slots specified are ready
-        for (const auto &pair : _slotNameToVarName)
-        {
-            if (_varsReady.count(pair.second) == 0) return;
-        }
+        //list expansion mode evaluates the list without the leading asterisk
+        _expandList = (_expr.size() > 2 and _expr.substr(0, 2) == "*[");
+        _evalExpr = _expandList ? _expr.substr(1) : _expr;
+        _resultValid = false;
+
+        if (not this->allVarsReady()) return;
 
         //perform the evaluation and emit the result
         const auto args = this->peformEval();
@@ -105,7 +130,37 @@ public:
 
     void setGlobals(const Pothos::ObjectKwargs &globals)
     {
+        for (const auto &pair : _globals)
+        {
+            _evalEnv->unregisterConstant(pair.first);
+        }
         _globals = globals;
+
+        //variables are registered last so they still shadow any globals
+        for (const auto &pair : _globals)
+        {
+            _evalEnv->registerConstantObj(pair.first, pair.second);
+        }
+        for (const auto &pair : _varValues)
+        {
+            _evalEnv->registerConstantObj(pair.first, pair.second);
+        }
+        _resultValid = false;
+    }
+
+    void setCoalesce(const bool coalesce)
+    {
+        _coalesce = coalesce;
+    }
+
+    bool getCoalesce(void) const
+    {
+        return _coalesce;
+    }
+
+    unsigned long long evaluationCount(void) const
+    {
+        return _evaluationCount;
     }
 
     //Pothos is cool because you can have advanced overload hooks like this,
@@ -116,18 +171,26 @@ public:
         auto it = _slotNameToVarName.find(name);
         if (it == _slotNameToVarName.end()) return Pothos::Block::opaqueCallHandler(name, inputArgs, numArgs);
 
-        //stash the values from the slot arguments
+        //stash the values from the slot arguments,
+        //only rebinding the constants that actually changed
         for (size_t i = 0; i < numArgs; i++)
         {
-            if (numArgs == 1) _varValues[it->second] = inputArgs[i];
-            else _varValues[Poco::format("%s%z", it->second, i)] = inputArgs[i];
+            const auto varName = (numArgs == 1) ? it->second : Poco::format("%s%z", it->second, i);
+            auto &value = _varValues[varName];
+            if (value and value.equals(inputArgs[i])) continue;
+            value = inputArgs[i];
+            _evalEnv->registerConstantObj(varName, value);
+            _resultValid = false;
         }
         _varsReady.insert(it->second);
 
-        //check that all slots specified are ready
-        for (const auto &pair : _slotNameToVarName)
+        if (not this->allVarsReady()) return Pothos::Object();
+
+        //defer to work(), which runs once the pending slot calls are handled
+        if (_coalesce)
         {
-            if (_varsReady.count(pair.second) == 0) return Pothos::Object();
+            _evalPending = true;
+            return Pothos::Object();
         }
 
         //perform the evaluation and emit the result
@@ -136,38 +199,55 @@ public:
         return Pothos::Object();
     }
 
-    //make an instance of the the evaluator in Pothos::Util
-    //register the input arguments as constants
-    //then evaluate the user-specified expression
+    void work(void)
+    {
+        if (not _evalPending) return;
+        _evalPending = false;
+
+        const auto args = this->peformEval();
+        this->opaqueCallMethod("triggered", args.data(), args.size());
+    }
+
+    //evaluate the user-specified expression in the persistent environment,
+    //which already holds the globals and the latest slot arguments as constants,
+    //unless nothing changed since the last evaluation
     Pothos::ObjectVector peformEval(void)
     {
-        Pothos::Util::EvalEnvironment evalEnv;
-        for (const auto &pair : _globals)
-        {
-            evalEnv.registerConstantObj(pair.first, pair.second);
-        }
-        for (const auto &pair : _varValues)
-        {
-            evalEnv.registerConstantObj(pair.first, pair.second);
-        }
+        if (_resultValid) return _lastResult;
 
-        //list expansion mode
-        if (_expr.size() > 2 and _expr.substr(0, 2) == "*[")
-        {
-            const auto result = evalEnv.eval(_expr.substr(1));
-            return result.convert<Pothos::ObjectVector>();
-        }
+        const auto result = _evalEnv->eval(_evalExpr);
+        _evaluationCount++;
 
-        //regular mode, return 1 argument
-        return Pothos::ObjectVector(1, evalEnv.eval(_expr));
+        //list expansion mode, or regular mode returning 1 argument
+        _lastResult = _expandList ? result.convert<Pothos::ObjectVector>() : Pothos::ObjectVector(1, result);
+        _resultValid = true;
+        return _lastResult;
     }
 
 private:
+    bool allVarsReady(void) const
+    {
+        for (const auto &pair : _slotNameToVarName)
+        {
+            if (_varsReady.count(pair.second) == 0) return false;
+        }
+        return true;
+    }
+
+    std::shared_ptr<Pothos::Util::EvalEnvironment> _evalEnv;
     std::string _expr;
+    std::string _evalExpr;
+    bool _expandList;
+    bool _coalesce;
     Pothos::ObjectKwargs _globals;
     std::map<std::string, std::string> _slotNameToVarName;
     Pothos::ObjectKwargs _varValues;
     std::set<std::string> _varsReady;
+
+    Pothos::ObjectVector _lastResult;
+    bool _resultValid;
+    bool _evalPending;
+    unsigned long long _evaluationCount;
 };
 
 static Pothos::BlockRegistry registerEvaluator(
@@ -0,0 +1,130 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include "TimerService.hpp"
+
+#include <Pothos/Exception.hpp>
+#include <Pothos/Object/Containers.hpp>
+
+#include <chrono>
+#include <functional>
+#include <utility>
+
+//
+// Latest-value-wins rate limiting for the signal/slot bridge blocks.
+//
+// The first event forwards right away. Events arriving less than the
+// minimum interval after the last forwarded one are held, each replacing
+// the one held before it. Once the interval has passed, the timer service
+// calls the block's wake function, and the block forwards the held event
+// from its own thread through takeDue().
+//
+class EventThrottle
+{
+public:
+    using Clock = TimerService::Clock;
+
+    // Called on the timer service thread, so it should only wake the block.
+    explicit EventThrottle(const std::function<void()>& wake):
+        _wake(wake),
+        _minInterval(Clock::duration::zero()),
+        _hasPending(false),
+        _coalescedCount(0),
+        _timerID(0)
+    {
+    }
+
+    ~EventThrottle()
+    {
+        this->stopTimer();
+    }
+
+    // In seconds, 0 to forward every event
+    void setMinInterval(double seconds)
+    {
+        if(seconds < 0.0)
+        {
+            throw Pothos::RangeException("EventThrottle::setMinInterval()", "interval cannot be negative");
+        }
+        _minInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    }
+
+    double getMinInterval() const
+    {
+        return std::chrono::duration<double>(_minInterval).count();
+    }
+
+    unsigned long long coalescedCount() const
+    {
+        return _coalescedCount;
+    }
+
+    // True if the event should be forwarded now. Otherwise it is held.
+    bool offer(const Pothos::ObjectVector& args)
+    {
+        const auto now = Clock::now();
+        if(!_hasPending && ((_minInterval == Clock::duration::zero()) || (now >= _lastForward + _minInterval)))
+        {
+            _lastForward = now;
+            return true;
+        }
+
+        if(_hasPending) ++_coalescedCount;
+        _pending = args;
+        _hasPending = true;
+
+        if(0 == _timerID)
+        {
+            _timerID = TimerService::global().start(_lastForward, _minInterval, [this](size_t, Clock::time_point)
+            {
+                _wake();
+            });
+        }
+
+        return false;
+    }
+
+    // True, with the held event, if it is due to be forwarded
+    bool takeDue(Pothos::ObjectVector& args)
+    {
+        const auto now = Clock::now();
+        if(!_hasPending || (now < _lastForward + _minInterval)) return false;
+
+        this->stopTimer();
+        args = std::move(_pending);
+        _pending.clear();
+        _hasPending = false;
+        _lastForward = now;
+
+        return true;
+    }
+
+    // Drops any held event, such as on deactivate()
+    void reset()
+    {
+        this->stopTimer();
+        _pending.clear();
+        _hasPending = false;
+        _lastForward = Clock::time_point();
+    }
+
+private:
+    std::function<void()> _wake;
+    Clock::duration _minInterval;
+    Clock::time_point _lastForward;
+
+    Pothos::ObjectVector _pending;
+    bool _hasPending;
+    unsigned long long _coalescedCount;
+
+    size_t _timerID;
+
+    void stopTimer()
+    {
+        if(0 == _timerID) return;
+        TimerService::global().stop(_timerID);
+        _timerID = 0;
+    }
+};
@@ -1,7 +1,12 @@
 // Copyright (c) 2014-2015 Josh Blum
+//                    2021 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/Framework.hpp>
+#include <Pothos/Object/Containers.hpp>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 /***********************************************************************
  * |PothosDoc Label To Message
@@ -17,7 +22,31 @@
  * |param id[Label ID] The id of the label to respond to.
  * |default "test"
  *
+ * |param labelIDs[Extra Label IDs] More label IDs to respond to, along with the Label ID.
+ * Setting this replaces the previous extra IDs; the Label ID is always matched.
+ * |default []
+ * |preview valid
+ *
+ * |param batch[Batch] Post one message per batch of input instead of one per label.
+ * When enabled, all matching labels found in one pass over the input
+ * are posted together as a single list message.
+ * |option [Enabled] true
+ * |option [Disabled] false
+ * |default false
+ * |preview valid
+ *
+ * |param includeIndices[Include Indices] Post the whole label instead of its data.
+ * The label's index is the absolute element index in the input stream,
+ * so matches can be placed in the stream, and its ID tells which label ID matched.
+ * |option [Enabled] true
+ * |option [Disabled] false
+ * |default false
+ * |preview valid
+ *
  * |factory /blocks/label_to_message(id)
+ * |setter setLabelIDs(labelIDs)
+ * |setter setBatch(batch)
+ * |setter setIncludeIndices(includeIndices)
  **********************************************************************/
 class LabelToMessage : public Pothos::Block
 {
@@ -28,32 +57,95 @@ public:
     }
 
     LabelToMessage(const std::string &id):
-        _labelId(id)
+        _id(id),
+        _labelIds({id}),
+        _batch(false),
+        _includeIndices(false)
     {
         this->setupInput(0);
         this->setupOutput(0);
 
         this->input(0)->setReserve(1);
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(LabelToMessage, setLabelIDs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LabelToMessage, getLabelIDs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LabelToMessage, setBatch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LabelToMessage, getBatch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LabelToMessage, setIncludeIndices));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LabelToMessage, getIncludeIndices));
+    }
+
+    //the factory ID is always matched along with these
+    void setLabelIDs(const std::vector<std::string> &ids)
+    {
+        _extraIds = ids;
+        _labelIds = std::unordered_set<std::string>(ids.begin(), ids.end());
+        _labelIds.insert(_id);
+    }
+
+    std::vector<std::string> getLabelIDs(void) const
+    {
+        return _extraIds;
+    }
+
+    void setBatch(const bool batch)
+    {
+        _batch = batch;
+    }
+
+    bool getBatch(void) const
+    {
+        return _batch;
+    }
+
+    void setIncludeIndices(const bool includeIndices)
+    {
+        _includeIndices = includeIndices;
+    }
+
+    bool getIncludeIndices(void) const
+    {
+        return _includeIndices;
     }
 
     void work(void)
     {
         auto inPort = this->input(0);
+        auto outPort = this->output(0);
 
         const size_t available = inPort->elements();
 
+        Pothos::ObjectVector matches;
         for (const auto &label : inPort->labels())
         {
             if (label.index >= available) break;
-            if (label.id == _labelId)
-                this->output(0)->postMessage(label.data);
+            if (_labelIds.count(label.id) == 0) continue;
+
+            auto msg = this->labelToObject(label, inPort->totalElements());
+            if (_batch) matches.push_back(std::move(msg));
+            else outPort->postMessage(std::move(msg));
         }
 
+        if (not matches.empty()) outPort->postMessage(std::move(matches));
+
         inPort->consume(available);
     }
 
 private:
-    std::string const _labelId;
+    const std::string _id;
+    std::vector<std::string> _extraIds;
+    std::unordered_set<std::string> _labelIds;
+    bool _batch;
+    bool _includeIndices;
+
+    Pothos::Object labelToObject(const Pothos::Label &label, const unsigned long long totalElements) const
+    {
+        if (not _includeIndices) return label.data;
+
+        auto absLabel = label;
+        absLabel.index += totalElements; //rel -> abs
+        return Pothos::Object(absLabel);
+    }
 };
 
 static Pothos::BlockRegistry registerLabelToMessage(
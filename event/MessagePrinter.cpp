@@ -1,10 +1,74 @@
 // Copyright (c) 2016-2017 Josh Blum
+//                    2021 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/Framework.hpp>
 #include <Poco/Logger.h>
 #include <Poco/Format.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************************
+ * A bounded single-producer single-consumer queue, so the block thread
+ * never waits on the writer thread
+ **********************************************************************/
+template <typename T>
+class SPSCQueue
+{
+public:
+    SPSCQueue(const size_t capacity):
+        _slots(capacity+1),
+        _head(0),
+        _tail(0)
+    {
+        return;
+    }
+
+    //called from the producer only, false when full
+    bool push(T &&value)
+    {
+        const auto tail = _tail.load(std::memory_order_relaxed);
+        const auto next = this->increment(tail);
+        if (next == _head.load(std::memory_order_acquire)) return false;
+        _slots[tail] = std::move(value);
+        _tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    //called from the consumer only, false when empty
+    bool pop(T &value)
+    {
+        const auto head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) return false;
+        value = std::move(_slots[head]);
+        _slots[head] = T();
+        _head.store(this->increment(head), std::memory_order_release);
+        return true;
+    }
+
+    //called from the consumer only
+    bool empty(void) const
+    {
+        return _head.load(std::memory_order_relaxed) == _tail.load(std::memory_order_acquire);
+    }
+
+private:
+    size_t increment(const size_t index) const
+    {
+        return (index+1 == _slots.size()) ? 0 : index+1;
+    }
+
+    std::vector<T> _slots;
+    std::atomic<size_t> _head;
+    std::atomic<size_t> _tail;
+};
 
 /***********************************************************************
  * |PothosDoc Message Printer
@@ -12,6 +76,21 @@
  * Print each input message to stdout or the logger.
  * The message will be converted to a string using Object::toString().
  *
+ * <h2>Asynchronous mode</h2>
+ * When enabled, messages are handed off to a background writer thread,
+ * which converts them to strings and prints them in batches,
+ * flushing once per batch instead of once per line.
+ * If the writer falls too far behind, new messages are dropped
+ * instead of slowing down the topology. Packets and buffers are
+ * converted to strings before they are handed off, so that queued
+ * messages never hold on to upstream buffers.
+ *
+ * <h2>Sampling and rate limiting</h2>
+ * To keep a busy stream of messages readable, only one in every
+ * N messages can be printed, and the printed messages can be limited
+ * to a maximum rate. The suppressedCount probe counts messages
+ * that were not printed for any of these reasons.
+ *
  * |category /Event
  * |category /Debug
  * |keywords message print log
@@ -33,33 +112,76 @@
  * |default ""
  * |widget StringEntry()
  *
+ * |param async[Asynchronous] Print from a background writer thread.
+ * |option [Enabled] true
+ * |option [Disabled] false
+ * |default false
+ * |preview valid
+ *
+ * |param sampleInterval[Sample Interval] Print one in every N messages.
+ * |default 1
+ * |widget SpinBox(minimum=1)
+ * |preview valid
+ *
+ * |param maxRate[Max Rate] The maximum number of messages printed per second.
+ * Use 0 for no limit.
+ * |default 0.0
+ * |units messages/sec
+ * |preview valid
+ *
  * |factory /blocks/message_printer()
  * |setter setDestination(dest)
  * |setter setSourceName(srcName)
+ * |setter setAsync(async)
+ * |setter setSampleInterval(sampleInterval)
+ * |setter setMaxRate(maxRate)
  **********************************************************************/
 class MessagePrinter : public Pothos::Block
 {
 public:
+    using Clock = std::chrono::steady_clock;
+
     static Block *make(void)
     {
         return new MessagePrinter();
     }
 
     MessagePrinter(void):
-        _logger(nullptr)
+        _async(false),
+        _sampleInterval(1),
+        _sampleCount(0),
+        _maxRate(0.0),
+        _tokens(0.0),
+        _suppressedCount(0),
+        _writerDone(false),
+        _writerWaiting(false)
     {
         this->setupInput(0);
         this->registerCall(this, POTHOS_FCN_TUPLE(MessagePrinter, setDestination));
         this->registerCall(this, POTHOS_FCN_TUPLE(MessagePrinter, getDestination));
         this->registerCall(this, POTHOS_FCN_TUPLE(MessagePrinter, setSourceName));
         this->registerCall(this, POTHOS_FCN_TUPLE(MessagePrinter, getSourceName));
+        this->registerCall(this, POTHOS_FCN_TUPLE(MessagePrinter, setAsync));
+        this->registerCall(this, POTHOS_FCN_TUPLE(MessagePrinter, getAsync));
+        this->registerCall(this, POTHOS_FCN_TUPLE(MessagePrinter, setSampleInterval));
+        this->registerCall(this, POTHOS_FCN_TUPLE(MessagePrinter, getSampleInterval));
+        this->registerCall(this, POTHOS_FCN_TUPLE(MessagePrinter, setMaxRate));
+        this->registerCall(this, POTHOS_FCN_TUPLE(MessagePrinter, getMaxRate));
+        this->registerCall(this, POTHOS_FCN_TUPLE(MessagePrinter, suppressedCount));
+        this->registerProbe("suppressedCount");
         this->setDestination("STDOUT");
         this->setSourceName("");
     }
 
+    ~MessagePrinter(void)
+    {
+        this->stopWriter();
+    }
+
     void setDestination(const std::string &dest)
     {
         _dest = dest;
+        this->updateConfig();
     }
 
     std::string getDestination(void) const
@@ -70,7 +192,7 @@ public:
     void setSourceName(const std::string &name)
     {
         _srcName = name;
-        _logger = &Poco::Logger::get(_srcName);
+        this->updateConfig();
     }
 
     std::string getSourceName(void) const
@@ -78,24 +200,87 @@ public:
         return _srcName;
     }
 
+    void setAsync(const bool async)
+    {
+        _async = async;
+        if (not this->isActive()) return;
+        if (_async) this->startWriter();
+        else this->stopWriter();
+    }
+
+    bool getAsync(void) const
+    {
+        return _async;
+    }
+
+    void setSampleInterval(const size_t interval)
+    {
+        if (interval == 0) throw Pothos::RangeException("MessagePrinter::setSampleInterval()", "interval must be positive");
+        _sampleInterval = interval;
+        _sampleCount = 0;
+    }
+
+    size_t getSampleInterval(void) const
+    {
+        return _sampleInterval;
+    }
+
+    void setMaxRate(const double rate)
+    {
+        if (rate < 0.0) throw Pothos::RangeException("MessagePrinter::setMaxRate()", "rate cannot be negative");
+        _maxRate = rate;
+        _tokens = this->burstSize();
+        _lastRefill = Clock::now();
+    }
+
+    double getMaxRate(void) const
+    {
+        return _maxRate;
+    }
+
+    unsigned long long suppressedCount(void) const
+    {
+        return _suppressedCount;
+    }
+
+    void activate(void)
+    {
+        _sampleCount = 0;
+        _tokens = this->burstSize();
+        _lastRefill = Clock::now();
+        if (_async) this->startWriter();
+    }
+
+    void deactivate(void)
+    {
+        this->stopWriter();
+    }
+
     void work(void)
     {
         auto input = this->input(0);
 
-        std::string msg;
+        Entry entry;
+        entry.config = _config;
 
         //got an input buffer, print type and size
         if (input->elements() != 0)
         {
             const auto &buff = input->buffer();
             input->consume(input->elements());
-            msg = Poco::format("%s[%d]", buff.dtype.toString(), int(buff.elements()));
+            entry.text = Poco::format("%s[%d]", buff.dtype.toString(), int(buff.elements()));
         }
 
-        //got an input message, convert to string
+        //got an input message, convert to string when printing,
+        //except for buffers that would keep upstream pool memory queued
         else if (input->hasMessage())
         {
-            msg = input->popMessage().toString();
+            entry.msg = input->popMessage();
+            if (_queue and (entry.msg.type() == typeid(Pothos::Packet) or entry.msg.type() == typeid(Pothos::BufferChunk)))
+            {
+                entry.text = entry.msg.toString();
+                entry.msg = Pothos::Object();
+            }
         }
 
         //got nothing, just return
@@ -104,20 +289,161 @@ public:
             return;
         }
 
-        if      (_dest == "STDOUT")      std::cout << (_srcName.empty()?"":(_srcName+": ")) << msg << std::endl;
-        else if (_dest == "STDERR")      std::cerr << (_srcName.empty()?"":(_srcName+": ")) << msg << std::endl;
-        else if (_dest == "ERROR")       {poco_error(*_logger, msg);}
-        else if (_dest == "WARNING")     {poco_warning(*_logger, msg);}
-        else if (_dest == "INFORMATION") {poco_information(*_logger, msg);}
-        else if (_dest == "DEBUG")       {poco_debug(*_logger, msg);}
-        else                             {poco_information(*_logger, msg);}
+        if (not this->admit()) _suppressedCount++;
+        else if (not _queue) print(entry);
+        else if (not _queue->push(std::move(entry))) _suppressedCount++;
+        else this->wakeWriter();
     }
 
 private:
+    struct Config
+    {
+        std::string dest;
+        std::string prefix;
+        Poco::Logger *logger;
+    };
+
+    struct Entry
+    {
+        std::shared_ptr<const Config> config;
+        Pothos::Object msg;
+        std::string text; //used instead of msg when set
+
+        std::string toString(void) const
+        {
+            return msg ? msg.toString() : text;
+        }
+    };
+
+    static constexpr size_t QueueCapacity = 4096;
+
     std::string _dest;
     std::string _srcName;
-    Poco::Logger *_logger;
+    std::shared_ptr<const Config> _config;
+
+    bool _async;
+    size_t _sampleInterval;
+    size_t _sampleCount;
+    double _maxRate;
+    double _tokens;
+    Clock::time_point _lastRefill;
+    unsigned long long _suppressedCount;
+
+    std::unique_ptr<SPSCQueue<Entry>> _queue;
+    std::atomic<bool> _writerDone;
+    std::atomic<bool> _writerWaiting;
+    std::mutex _writerMutex;
+    std::condition_variable _writerCond;
+    std::thread _writer;
+
+    void updateConfig(void)
+    {
+        std::shared_ptr<Config> config(new Config());
+        config->dest = _dest;
+        config->prefix = _srcName.empty()?"":(_srcName+": ");
+        config->logger = &Poco::Logger::get(_srcName);
+        _config = config;
+    }
+
+    double burstSize(void) const
+    {
+        return std::max(1.0, _maxRate);
+    }
+
+    //apply sampling, then the token bucket rate limit
+    bool admit(void)
+    {
+        const bool sampled = (_sampleCount++ % _sampleInterval) == 0;
+        if (not sampled) return false;
+        if (_maxRate == 0.0) return true;
+
+        const auto now = Clock::now();
+        _tokens = std::min(this->burstSize(), _tokens + _maxRate*std::chrono::duration<double>(now - _lastRefill).count());
+        _lastRefill = now;
+        if (_tokens < 1.0) return false;
+        _tokens -= 1.0;
+        return true;
+    }
+
+    static void print(const Entry &entry)
+    {
+        const auto &config = *entry.config;
+        const auto msg = entry.toString();
+        if      (config.dest == "STDOUT")      std::cout << config.prefix << msg << std::endl;
+        else if (config.dest == "STDERR")      std::cerr << config.prefix << msg << std::endl;
+        else if (config.dest == "ERROR")       {poco_error(*config.logger, msg);}
+        else if (config.dest == "WARNING")     {poco_warning(*config.logger, msg);}
+        else if (config.dest == "INFORMATION") {poco_information(*config.logger, msg);}
+        else if (config.dest == "DEBUG")       {poco_debug(*config.logger, msg);}
+        else                                   {poco_information(*config.logger, msg);}
+    }
+
+    void startWriter(void)
+    {
+        if (_queue) return;
+        _queue.reset(new SPSCQueue<Entry>(QueueCapacity));
+        _writerDone = false;
+        _writer = std::thread(&MessagePrinter::writerLoop, this);
+    }
+
+    //the writer drains everything queued before it exits
+    void stopWriter(void)
+    {
+        if (not _queue) return;
+        _writerDone = true;
+        {
+            std::lock_guard<std::mutex> lock(_writerMutex);
+            _writerCond.notify_one();
+        }
+        _writer.join();
+        _queue.reset();
+    }
+
+    //only locks when the writer is waiting on an empty queue
+    void wakeWriter(void)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (not _writerWaiting.load(std::memory_order_relaxed)) return;
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        _writerCond.notify_one();
+    }
+
+    void writerLoop(void)
+    {
+        std::string outBatch, errBatch;
+        Entry entry;
+        while (true)
+        {
+            //check before draining so that nothing pushed before stopping is lost
+            const bool done = _writerDone.load();
+
+            while (_queue->pop(entry))
+            {
+                const auto &config = *entry.config;
+                if      (config.dest == "STDOUT") outBatch += config.prefix + entry.toString() + "\n";
+                else if (config.dest == "STDERR") errBatch += config.prefix + entry.toString() + "\n";
+                else print(entry);
+            }
+
+            if (not outBatch.empty()) std::cout << outBatch << std::flush;
+            if (not errBatch.empty()) std::cerr << errBatch << std::flush;
+            outBatch.clear();
+            errBatch.clear();
+
+            if (done) return;
+
+            //the fences pair with wakeWriter(), so either the writer sees the
+            //new entry here, or the producer sees that the writer is waiting
+            std::unique_lock<std::mutex> lock(_writerMutex);
+            _writerWaiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            _writerCond.wait(lock, [this]{return _writerDone.load() or not _queue->empty();});
+            _writerWaiting.store(false, std::memory_order_relaxed);
+        }
+    }
 };
 
+constexpr size_t MessagePrinter::QueueCapacity;
+
 static Pothos::BlockRegistry registerMessagePrinter(
     "/blocks/message_printer", &MessagePrinter::make);
@@ -1,6 +1,9 @@
 // Copyright (c) 2014-2016 Josh Blum
+//                    2021 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
+#include "EventThrottle.hpp"
+
 #include <Pothos/Framework.hpp>
 #include <iostream>
 
@@ -18,7 +21,16 @@
  * |param name[Signal Name] The name of the signal to emit.
  * |default "itChanged"
  *
+ * |param minInterval[Min Interval] The minimum time between emitted signals.
+ * Messages that arrive sooner are coalesced, and only the newest
+ * is emitted once the interval has passed. Use 0 to emit every message.
+ * The coalescedCount probe counts the messages that were replaced.
+ * |default 0.0
+ * |units seconds
+ * |preview valid
+ *
  * |factory /blocks/message_to_signal(name)
+ * |setter setMinInterval(minInterval)
  **********************************************************************/
 class MessageToSignal : public Pothos::Block
 {
@@ -29,10 +41,43 @@ public:
     }
 
     MessageToSignal(const std::string &name):
-        _emitName(name)
+        _emitName(name),
+        _throttle([this]{this->input("flushCoalesced")->pushMessage(Pothos::Object(Pothos::ObjectVector()));})
     {
         this->setupInput(0);
         this->registerSignal(name);
+        this->registerCall(this, POTHOS_FCN_TUPLE(MessageToSignal, setMinInterval));
+        this->registerCall(this, POTHOS_FCN_TUPLE(MessageToSignal, getMinInterval));
+        this->registerCall(this, POTHOS_FCN_TUPLE(MessageToSignal, coalescedCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(MessageToSignal, flushCoalesced));
+        this->registerProbe("coalescedCount");
+        this->registerSlot("flushCoalesced"); //woken by the throttle
+    }
+
+    void setMinInterval(const double interval)
+    {
+        _throttle.setMinInterval(interval);
+    }
+
+    double getMinInterval(void) const
+    {
+        return _throttle.getMinInterval();
+    }
+
+    unsigned long long coalescedCount(void) const
+    {
+        return _throttle.coalescedCount();
+    }
+
+    void flushCoalesced(void)
+    {
+        Pothos::ObjectVector args;
+        if (_throttle.takeDue(args)) this->emitSignal(_emitName, args.front());
+    }
+
+    void deactivate(void)
+    {
+        _throttle.reset();
     }
 
     void work(void)
@@ -40,12 +85,14 @@ public:
         auto input = this->input(0);
         if (input->hasMessage())
         {
-            this->emitSignal(_emitName, input->popMessage());
+            auto msg = input->popMessage();
+            if (_throttle.offer(Pothos::ObjectVector(1, msg))) this->emitSignal(_emitName, msg);
         }
     }
 
 private:
     const std::string _emitName;
+    EventThrottle _throttle;
 };
 
 static Pothos::BlockRegistry registerMessageToSignal(
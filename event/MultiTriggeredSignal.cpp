@@ -0,0 +1,191 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <Pothos/Object/Containers.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/***********************************************************************
+ * |PothosDoc Multi Triggered Signal
+ *
+ * The multi triggered signal block watches for many trigger events at once,
+ * and emits a different signal for each of them. It works like several
+ * Triggered Signal blocks sharing one input, but checks each label and
+ * message once with a hash lookup, instead of once per trigger.
+ *
+ * Triggers are matched against labels in the input stream and in
+ * input packets, and against input messages.
+ * Each signal passes its arguments from setArgs(), or when none are set,
+ * the matching label's data or the matching message itself.
+ *
+ * |category /Event
+ * |keywords label packet message equals condition
+ *
+ * |param labelTriggers[Label Triggers] A map of label IDs to the names of the signals they emit.
+ * Example: {"rxTime": "timeChanged", "rxFreq": "freqChanged"}
+ * |default {}
+ * |preview valid
+ *
+ * |param messageTriggers[Message Triggers] A list of [value, signal name] pairs.
+ * Input messages equal to a value emit its signal. Values are matched by type
+ * as well as value, so an integer message does not match a floating point value.
+ * Example: [[0, "stopped"], [1, "started"]]
+ * |default []
+ * |preview valid
+ *
+ * |param args Arguments to pass into each signal, as a map of signal names to argument lists.
+ * |default {}
+ * |preview valid
+ *
+ * |factory /blocks/multi_triggered_signal(labelTriggers, messageTriggers)
+ * |setter setArgs(args)
+ **********************************************************************/
+class MultiTriggeredSignal : public Pothos::Block
+{
+public:
+    static Block *make(const Pothos::ObjectKwargs &labelTriggers, const Pothos::ObjectVector &messageTriggers)
+    {
+        return new MultiTriggeredSignal(labelTriggers, messageTriggers);
+    }
+
+    MultiTriggeredSignal(const Pothos::ObjectKwargs &labelTriggers, const Pothos::ObjectVector &messageTriggers)
+    {
+        this->setupInput(0);
+
+        for (const auto &pair : labelTriggers)
+        {
+            _labelTriggers[pair.first] = this->addSignal(pair.second.convert<std::string>());
+        }
+        for (const auto &trigger : messageTriggers)
+        {
+            const auto pair = trigger.convert<Pothos::ObjectVector>();
+            if (pair.size() != 2) throw Pothos::InvalidArgumentException(
+                "MultiTriggeredSignal()", "message triggers must be [value, signal name] pairs");
+            _messageTriggers.emplace(pair[0].hashCode(), MessageTrigger{pair[0], this->addSignal(pair[1].convert<std::string>())});
+        }
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(MultiTriggeredSignal, setArgs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(MultiTriggeredSignal, getArgs));
+    }
+
+    void setArgs(const Pothos::ObjectKwargs &args)
+    {
+        for (auto &signal : _signals) signal.hasArgs = false;
+        for (const auto &pair : args)
+        {
+            auto &signal = _signals.at(this->findSignal(pair.first));
+            signal.args = pair.second.convert<Pothos::ObjectVector>();
+            signal.hasArgs = true;
+        }
+    }
+
+    Pothos::ObjectKwargs getArgs(void) const
+    {
+        Pothos::ObjectKwargs args;
+        for (const auto &signal : _signals)
+        {
+            if (signal.hasArgs) args[signal.name] = Pothos::Object(signal.args);
+        }
+        return args;
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+
+        if (inPort->hasMessage())
+        {
+            const auto msg = inPort->popMessage();
+            //check input labels on packet messages
+            if (msg.type() == typeid(Pothos::Packet))
+            {
+                const auto &pkt = msg.extract<Pothos::Packet>();
+                for (const auto &label : pkt.labels) this->checkLabel(label);
+            }
+            //otherwise look up the message value
+            else this->checkMessage(msg);
+        }
+
+        //check for input stream data
+        const size_t available = inPort->elements();
+        if (available == 0) return;
+
+        //check input labels for matches
+        for (const auto &label : inPort->labels())
+        {
+            if (label.index >= available) break;
+            this->checkLabel(label);
+        }
+
+        //consume all input stream data
+        inPort->consume(available);
+    }
+
+private:
+    struct Signal
+    {
+        std::string name;
+        Pothos::ObjectVector args;
+        bool hasArgs;
+    };
+
+    struct MessageTrigger
+    {
+        Pothos::Object value;
+        size_t signalIndex;
+    };
+
+    std::vector<Signal> _signals;
+    std::unordered_map<std::string, size_t> _labelTriggers;
+    std::unordered_multimap<size_t, MessageTrigger> _messageTriggers;
+
+    size_t findSignal(const std::string &name) const
+    {
+        for (size_t i = 0; i < _signals.size(); i++)
+        {
+            if (_signals[i].name == name) return i;
+        }
+        throw Pothos::InvalidArgumentException("MultiTriggeredSignal::setArgs()", "no trigger emits signal " + name);
+    }
+
+    //several triggers may share one signal
+    size_t addSignal(const std::string &name)
+    {
+        for (size_t i = 0; i < _signals.size(); i++)
+        {
+            if (_signals[i].name == name) return i;
+        }
+        this->registerSignal(name);
+        _signals.push_back(Signal{name, Pothos::ObjectVector(), false});
+        return _signals.size()-1;
+    }
+
+    void emit(const size_t signalIndex, const Pothos::Object &matched)
+    {
+        const auto &signal = _signals[signalIndex];
+        if (signal.hasArgs) this->opaqueCallMethod(signal.name, signal.args.data(), signal.args.size());
+        else this->opaqueCallMethod(signal.name, &matched, 1);
+    }
+
+    void checkLabel(const Pothos::Label &label)
+    {
+        const auto it = _labelTriggers.find(label.id);
+        if (it != _labelTriggers.end()) this->emit(it->second, label.data);
+    }
+
+    void checkMessage(const Pothos::Object &msg)
+    {
+        const auto range = _messageTriggers.equal_range(msg.hashCode());
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            //confirm, since different values can share a hash
+            if (msg.type() != it->second.value.type()) continue;
+            if (msg.equals(it->second.value)) this->emit(it->second.signalIndex, msg);
+        }
+    }
+};
+
+static Pothos::BlockRegistry registerMultiTriggeredSignal(
+    "/blocks/multi_triggered_signal", &MultiTriggeredSignal::make);
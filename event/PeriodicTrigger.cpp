@@ -1,10 +1,15 @@
 // Copyright (c) 2014-2015 Josh Blum
+//                    2021 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
+#include "TimerService.hpp"
+
 #include <Pothos/Framework.hpp>
 #include <chrono>
-#include <thread>
-#include <iostream>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <utility> //swap
 #include <algorithm> //min/max
 
 /***********************************************************************
@@ -12,6 +17,16 @@
  *
  * The periodic trigger block emits a signal named "triggered" at the specified interval.
  *
+ * Deadlines are kept by a timer service shared by every periodic trigger
+ * in the process, so waiting for the next deadline does not hold a thread.
+ * Deadlines stay on a fixed schedule from activation, so late triggers
+ * do not cause drift.
+ *
+ * The jitter of each trigger, the time between its deadline and the signal
+ * being emitted, is available through the meanJitter, maxJitter, and
+ * jitterStdDev probes, in seconds. The triggerCount and missedCount probes
+ * count emitted triggers and deadlines that passed without their own wakeup.
+ *
  * |category /Event
  *
  * |param rate[Trigger Rate] The rate of triggers per second
@@ -21,31 +36,76 @@
  * |default []
  * |preview valid
  *
+ * |param missedPolicy[Missed Policy] What to do when deadlines pass
+ * before the trigger could be emitted, such as under heavy load.
+ * <ul>
+ * <li><b>CATCH_UP:</b> Emit one trigger for every deadline that passed.</li>
+ * <li><b>SKIP:</b> Emit a single trigger for the latest deadline.</li>
+ * </ul>
+ * |option [Catch Up] "CATCH_UP"
+ * |option [Skip] "SKIP"
+ * |default "CATCH_UP"
+ * |preview valid
+ *
  * |factory /blocks/periodic_trigger()
  * |setter setRate(rate)
  * |setter setArgs(args)
+ * |setter setMissedPolicy(missedPolicy)
  **********************************************************************/
 class PeriodicTrigger : public Pothos::Block
 {
 public:
+    using Clock = TimerService::Clock;
+
     static Block *make(void)
     {
         return new PeriodicTrigger();
     }
 
     PeriodicTrigger(void):
-        _rate(1.0)
+        _rate(1.0),
+        _missedPolicy("CATCH_UP"),
+        _timerID(0),
+        _wakePending(false),
+        _pendingTriggers(0),
+        _missedCount(0)
     {
         this->registerSignal("triggered");
+        this->registerSlot("handleTimer"); //woken by the timer service
         this->registerCall(this, POTHOS_FCN_TUPLE(PeriodicTrigger, setRate));
         this->registerCall(this, POTHOS_FCN_TUPLE(PeriodicTrigger, getRate));
         this->registerCall(this, POTHOS_FCN_TUPLE(PeriodicTrigger, setArgs));
         this->registerCall(this, POTHOS_FCN_TUPLE(PeriodicTrigger, getArgs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PeriodicTrigger, setMissedPolicy));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PeriodicTrigger, getMissedPolicy));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PeriodicTrigger, handleTimer));
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(PeriodicTrigger, triggerCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PeriodicTrigger, missedCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PeriodicTrigger, meanJitter));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PeriodicTrigger, maxJitter));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PeriodicTrigger, jitterStdDev));
+        this->registerProbe("triggerCount");
+        this->registerProbe("missedCount");
+        this->registerProbe("meanJitter");
+        this->registerProbe("maxJitter");
+        this->registerProbe("jitterStdDev");
+
+        this->resetStats();
+    }
+
+    ~PeriodicTrigger(void)
+    {
+        this->stopTimer();
     }
 
     void setRate(const double rate)
     {
+        if (not (rate > 0.0)) throw Pothos::RangeException("PeriodicTrigger::setRate()", "rate must be positive");
         _rate = rate;
+
+        //restart on the new schedule
+        if (this->isActive()) this->startTimer();
     }
 
     double getRate(void) const
@@ -63,41 +123,165 @@ public:
         return _args;
     }
 
-    void activate(void)
+    void setMissedPolicy(const std::string &policy)
+    {
+        if ((policy != "CATCH_UP") and (policy != "SKIP"))
+        {
+            throw Pothos::InvalidArgumentException("PeriodicTrigger::setMissedPolicy()", "unknown policy: " + policy);
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        _missedPolicy = policy;
+    }
+
+    std::string getMissedPolicy(void) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _missedPolicy;
+    }
+
+    unsigned long long triggerCount(void) const
+    {
+        return _triggerCount;
+    }
+
+    unsigned long long missedCount(void) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _missedCount;
+    }
+
+    double meanJitter(void) const
+    {
+        return _jitterMean;
+    }
+
+    double maxJitter(void) const
+    {
+        return _jitterMax;
+    }
+
+    double jitterStdDev(void) const
     {
-        _nextTrigger = std::chrono::high_resolution_clock::now();
-        this->incrementNext();
+        return (_triggerCount < 2) ? 0.0 : std::sqrt(_jitterM2/(_triggerCount-1));
     }
 
-    void incrementNext(void)
+    void activate(void)
     {
-        const auto tps = std::chrono::nanoseconds((long long)(1e9/_rate));
-        _nextTrigger += std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(tps);
+        this->resetStats();
+        this->startTimer();
     }
 
-    void work(void)
+    void deactivate(void)
     {
-        auto currentTime = std::chrono::high_resolution_clock::now();
+        this->stopTimer();
+    }
 
-        if (currentTime > _nextTrigger)
+    //emit the triggers that the timer service left for us
+    void handleTimer(void)
+    {
+        size_t numTriggers = 0;
+        Clock::time_point deadline;
         {
-            this->opaqueCallMethod("triggered", _args.data(), _args.size());
-            this->incrementNext();
+            std::lock_guard<std::mutex> lock(_mutex);
+            numTriggers = _pendingTriggers;
+            deadline = _latestDeadline;
+            _pendingTriggers = 0;
+            _wakePending = false;
         }
-        else
+
+        for (size_t i = 0; i < numTriggers; i++)
         {
-            const auto maxSleepTime = std::chrono::nanoseconds(this->workInfo().maxTimeoutNs);
-            const std::chrono::nanoseconds deltaNextTrig(_nextTrigger-currentTime);
-            std::this_thread::sleep_for(std::min(maxSleepTime, deltaNextTrig));
+            this->opaqueCallMethod("triggered", _args.data(), _args.size());
         }
-
-        return this->yield();
+        if (numTriggers != 0) this->recordJitter(numTriggers, Clock::now() - deadline);
     }
 
 private:
     double _rate;
     Pothos::ObjectVector _args;
-    std::chrono::high_resolution_clock::time_point _nextTrigger;
+
+    //shared with the timer service thread
+    mutable std::mutex _mutex;
+    std::string _missedPolicy;
+    size_t _timerID;
+    bool _wakePending;
+    size_t _pendingTriggers;
+    Clock::time_point _latestDeadline;
+    unsigned long long _missedCount;
+
+    //jitter statistics, in seconds
+    unsigned long long _triggerCount;
+    double _jitterMean;
+    double _jitterM2;
+    double _jitterMax;
+
+    void startTimer(void)
+    {
+        this->stopTimer();
+
+        const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0/_rate));
+        const auto timerID = TimerService::global().start(Clock::now(), std::max(period, Clock::duration(1)),
+            [this](const size_t numDeadlines, const Clock::time_point deadline)
+            {
+                this->handleDeadlines(numDeadlines, deadline);
+            });
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _timerID = timerID;
+        _pendingTriggers = 0;
+    }
+
+    void stopTimer(void)
+    {
+        size_t timerID = 0;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::swap(timerID, _timerID);
+        }
+        if (timerID != 0) TimerService::global().stop(timerID);
+    }
+
+    //called on the timer service thread
+    void handleDeadlines(const size_t numDeadlines, const Clock::time_point deadline)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _missedCount += numDeadlines-1;
+        if (_missedPolicy == "SKIP") _pendingTriggers = 1;
+        else _pendingTriggers += numDeadlines;
+        _latestDeadline = deadline;
+
+        //one wakeup at a time, so a slow block sees the policy applied
+        //instead of a backlog of wakeups in its slot queue
+        if (_wakePending) return;
+        _wakePending = true;
+        this->input("handleTimer")->pushMessage(Pothos::Object(Pothos::ObjectVector()));
+    }
+
+    void resetStats(void)
+    {
+        _triggerCount = 0;
+        _jitterMean = 0.0;
+        _jitterM2 = 0.0;
+        _jitterMax = 0.0;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _missedCount = 0;
+    }
+
+    //catch-up triggers emitted together share the latest deadline's jitter
+    void recordJitter(const size_t numTriggers, const Clock::duration &late)
+    {
+        const auto jitter = std::chrono::duration<double>(late).count();
+        for (size_t i = 0; i < numTriggers; i++)
+        {
+            _triggerCount++;
+            const auto delta = jitter - _jitterMean;
+            _jitterMean += delta/_triggerCount;
+            _jitterM2 += delta*(jitter - _jitterMean);
+        }
+        _jitterMax = std::max(_jitterMax, jitter);
+    }
 };
 
 static Pothos::BlockRegistry registerPeriodicTrigger(
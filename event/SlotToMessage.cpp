@@ -1,6 +1,9 @@
 // Copyright (c) 2014-2014 Josh Blum
+//                    2021 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
+#include "EventThrottle.hpp"
+
 #include <Pothos/Framework.hpp>
 #include <iostream>
 
@@ -17,7 +20,16 @@
  * |param name[Signal Name] The name of the slot to accept signals on.
  * |default "handleIt"
  *
+ * |param minInterval[Min Interval] The minimum time between posted messages.
+ * Slot calls that arrive sooner are coalesced, and only the newest
+ * is posted once the interval has passed. Use 0 to post every call.
+ * The coalescedCount probe counts the calls that were replaced.
+ * |default 0.0
+ * |units seconds
+ * |preview valid
+ *
  * |factory /blocks/slot_to_message(name)
+ * |setter setMinInterval(minInterval)
  **********************************************************************/
 class SlotToMessage : public Pothos::Block
 {
@@ -28,10 +40,43 @@ public:
     }
 
     SlotToMessage(const std::string &name):
-        _slotName(name)
+        _slotName(name),
+        _throttle([this]{this->input("flushCoalesced")->pushMessage(Pothos::Object(Pothos::ObjectVector()));})
     {
         this->setupOutput(0);
         this->registerSlot(name); //see opaqueCallHandler comment below
+        this->registerCall(this, POTHOS_FCN_TUPLE(SlotToMessage, setMinInterval));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SlotToMessage, getMinInterval));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SlotToMessage, coalescedCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SlotToMessage, flushCoalesced));
+        this->registerProbe("coalescedCount");
+        this->registerSlot("flushCoalesced"); //woken by the throttle
+    }
+
+    void setMinInterval(const double interval)
+    {
+        _throttle.setMinInterval(interval);
+    }
+
+    double getMinInterval(void) const
+    {
+        return _throttle.getMinInterval();
+    }
+
+    unsigned long long coalescedCount(void) const
+    {
+        return _throttle.coalescedCount();
+    }
+
+    void flushCoalesced(void)
+    {
+        Pothos::ObjectVector args;
+        if (_throttle.takeDue(args)) this->output(0)->postMessage(args.front());
+    }
+
+    void deactivate(void)
+    {
+        _throttle.reset();
     }
 
     //Pothos is cool because you can have advanced overload hooks like this,
@@ -40,7 +85,10 @@ public:
     {
         if (name == _slotName)
         {
-            if (numArgs > 0) this->output(0)->postMessage(inputArgs[0]);
+            if (numArgs > 0 and _throttle.offer(Pothos::ObjectVector(1, inputArgs[0])))
+            {
+                this->output(0)->postMessage(inputArgs[0]);
+            }
             return Pothos::Object();
         }
         return Pothos::Block::opaqueCallHandler(name, inputArgs, numArgs);
@@ -48,6 +96,7 @@ public:
 
 private:
     const std::string _slotName;
+    EventThrottle _throttle;
 };
 
 static Pothos::BlockRegistry registerSlotToMessage(
@@ -7,6 +7,8 @@
 #include <chrono>
 #include <thread>
 #include <iostream>
+#include <string>
+#include <vector>
 
 POTHOS_TEST_BLOCK("/blocks/tests", test_periodic_trigger)
 {
@@ -31,3 +33,54 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_periodic_trigger)
     POTHOS_TEST_TRUE(msgs.size() >= 3);
     POTHOS_TEST_TRUE(msgs.size() <= 5);
 }
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_periodic_trigger_shared_timer)
+{
+    //several triggers share the timer service thread
+    std::vector<Pothos::Proxy> triggers;
+    for (const auto &policy : {"CATCH_UP", "SKIP", "CATCH_UP", "SKIP"})
+    {
+        auto trigger = Pothos::BlockRegistry::make("/blocks/periodic_trigger");
+        trigger.call("setRate", 20.0);
+        trigger.call("setMissedPolicy", policy);
+        POTHOS_TEST_EQUAL(trigger.call<std::string>("getMissedPolicy"), policy);
+        triggers.push_back(trigger);
+    }
+    POTHOS_TEST_THROWS(triggers[0].call("setMissedPolicy", "LATER"), Pothos::InvalidArgumentException);
+    POTHOS_TEST_THROWS(triggers[0].call("setRate", 0.0), Pothos::RangeException);
+
+    std::vector<Pothos::Proxy> collectors;
+    for (size_t i = 0; i < triggers.size(); i++)
+    {
+        collectors.push_back(Pothos::BlockRegistry::make("/blocks/collector_sink", "int"));
+    }
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        for (size_t i = 0; i < triggers.size(); i++)
+        {
+            topology.connect(triggers[i], "triggered", collectors[i], 0);
+        }
+        topology.commit();
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    for (size_t i = 0; i < triggers.size(); i++)
+    {
+        std::vector<Pothos::Object> msgs = collectors[i].call("getMessages");
+        std::cout << msgs.size() << std::endl;
+
+        //rough timing again, but the schedule does not drift
+        POTHOS_TEST_TRUE(msgs.size() >= 18);
+        POTHOS_TEST_TRUE(msgs.size() <= 22);
+
+        //every emitted trigger is counted toward the jitter statistics
+        POTHOS_TEST_EQUAL(triggers[i].call<unsigned long long>("triggerCount"), msgs.size());
+        const auto meanJitter = triggers[i].call<double>("meanJitter");
+        const auto maxJitter = triggers[i].call<double>("maxJitter");
+        POTHOS_TEST_TRUE(meanJitter >= 0.0);
+        POTHOS_TEST_TRUE(maxJitter >= meanJitter);
+        POTHOS_TEST_TRUE(triggers[i].call<double>("jitterStdDev") >= 0.0);
+    }
+}
@@ -4,7 +4,11 @@
 #include <Pothos/Testing.hpp>
 #include <Pothos/Framework.hpp>
 #include <Pothos/Proxy.hpp>
+#include <Pothos/Object/Containers.hpp>
 #include <iostream>
+#include <map>
+#include <string>
+#include <vector>
 
 POTHOS_TEST_BLOCK("/blocks/tests", test_signals_and_slots)
 {
@@ -149,3 +153,257 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_evaluator_multislot)
     POTHOS_TEST_EQUAL(msgs.size(), 1);
     POTHOS_TEST_EQUAL(msgs[0].convert<int>(), (11 - 2*(-32)));
 }
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_evaluator_coalesce)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+    auto slotToMessage = Pothos::BlockRegistry::make("/blocks/slot_to_message", "handleEvent");
+    auto transform = Pothos::BlockRegistry::make("/blocks/evaluator", std::vector<std::string>(1, "val"));
+    transform.call("setExpression", "2*val");
+    transform.call("setCoalesce", true);
+    POTHOS_TEST_TRUE(transform.call<bool>("getCoalesce"));
+
+    //every label emits a value, all from one work() call of the trigger
+    Pothos::ObjectKwargs labelTriggers;
+    labelTriggers["val"] = Pothos::Object("changed");
+    auto trigger = Pothos::BlockRegistry::make("/blocks/multi_triggered_signal", labelTriggers, Pothos::ObjectVector());
+
+    const std::vector<int> values = {11, -32, 7, 7, 100};
+    feeder.call("feedBuffer", Pothos::BufferChunk("int", 10));
+    for (size_t i = 0; i < values.size(); i++) feeder.call("feedLabel", Pothos::Label("val", values[i], i));
+
+    //sharing one thread, the evaluator only runs once the trigger is done,
+    //so all of the updates are delivered before its work() is called
+    Pothos::ThreadPool threadPool(1);
+    trigger.call("setThreadPool", threadPool);
+    transform.call("setThreadPool", threadPool);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, trigger, 0);
+        topology.connect(trigger, "changed", transform, "setVal");
+        topology.connect(transform, "triggered", slotToMessage, "handleEvent");
+        topology.connect(slotToMessage, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //collect the messages
+    std::vector<Pothos::Object> msgs = collector.call("getMessages");
+    std::cout << msgs.size() << std::endl;
+
+    //the updates were coalesced, and the latest value was evaluated
+    const auto evaluations = transform.call<unsigned long long>("evaluationCount");
+    POTHOS_TEST_TRUE(evaluations >= 1);
+    POTHOS_TEST_TRUE(evaluations < values.size());
+    POTHOS_TEST_EQUAL(msgs.size(), evaluations);
+    POTHOS_TEST_EQUAL(msgs.back().convert<int>(), 2*values.back());
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_evaluator_cached_result)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+    auto messageToSignal = Pothos::BlockRegistry::make("/blocks/message_to_signal", "changeEvent");
+    auto slotToMessage = Pothos::BlockRegistry::make("/blocks/slot_to_message", "handleEvent");
+    auto transform = Pothos::BlockRegistry::make("/blocks/evaluator", std::vector<std::string>(1, "val"));
+    transform.call("setExpression", "2*val");
+
+    //repeated values leave the binding unchanged
+    const std::vector<int> values = {7, 7, 7, 8, 8};
+    for (const auto value : values) feeder.call("feedMessage", Pothos::Object(value));
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, messageToSignal, 0);
+        topology.connect(messageToSignal, "changeEvent", transform, "setVal");
+        topology.connect(transform, "triggered", slotToMessage, "handleEvent");
+        topology.connect(slotToMessage, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //collect the messages
+    std::vector<Pothos::Object> msgs = collector.call("getMessages");
+    std::cout << msgs.size() << std::endl;
+
+    //every update still emits, but only the changes were evaluated
+    POTHOS_TEST_EQUAL(msgs.size(), values.size());
+    for (size_t i = 0; i < values.size(); i++) POTHOS_TEST_EQUAL(msgs[i].convert<int>(), 2*values[i]);
+    POTHOS_TEST_EQUAL(transform.call<unsigned long long>("evaluationCount"), 2);
+
+    //a new expression is evaluated again, even with the same binding
+    transform.call("setExpression", "3*val");
+    POTHOS_TEST_EQUAL(transform.call<unsigned long long>("evaluationCount"), 3);
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_message_printer_suppression)
+{
+    for (const bool async : {false, true})
+    {
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+        auto printer = Pothos::BlockRegistry::make("/blocks/message_printer");
+        printer.call("setSourceName", "test_message_printer_suppression");
+        printer.call("setAsync", async);
+        POTHOS_TEST_EQUAL(printer.call<bool>("getAsync"), async);
+
+        //print one in three
+        printer.call("setSampleInterval", 3);
+        POTHOS_TEST_THROWS(printer.call("setSampleInterval", 0), Pothos::RangeException);
+
+        for (int i = 0; i < 30; i++) feeder.call("feedMessage", Pothos::Object(i));
+
+        //run the topology
+        {
+            Pothos::Topology topology;
+            topology.connect(feeder, 0, printer, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+
+        POTHOS_TEST_EQUAL(printer.call<unsigned long long>("suppressedCount"), 20);
+    }
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_label_to_message_batch)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+    auto labelToMessage = Pothos::BlockRegistry::make("/blocks/label_to_message", "a");
+    labelToMessage.call("setLabelIDs", std::vector<std::string>{"b"});
+    POTHOS_TEST_TRUE(labelToMessage.call<std::vector<std::string>>("getLabelIDs") == std::vector<std::string>{"b"});
+    labelToMessage.call("setBatch", true);
+    labelToMessage.call("setIncludeIndices", true);
+
+    //labels "a" from the factory and "b" match, "c" does not
+    feeder.call("feedBuffer", Pothos::BufferChunk("int", 10));
+    feeder.call("feedLabel", Pothos::Label("a", 1, 2));
+    feeder.call("feedLabel", Pothos::Label("c", 2, 5));
+    feeder.call("feedLabel", Pothos::Label("b", 3, 7));
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, labelToMessage, 0);
+        topology.connect(labelToMessage, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //batches depend on how the input was split up, so flatten them
+    std::vector<Pothos::Label> labels;
+    std::vector<Pothos::Object> msgs = collector.call("getMessages");
+    for (const auto &msg : msgs)
+    {
+        POTHOS_TEST_TRUE(msg.type() == typeid(Pothos::ObjectVector));
+        for (const auto &obj : msg.extract<Pothos::ObjectVector>())
+        {
+            labels.push_back(obj.extract<Pothos::Label>());
+        }
+    }
+
+    POTHOS_TEST_EQUAL(labels.size(), 2);
+    POTHOS_TEST_EQUAL(labels[0].id, "a");
+    POTHOS_TEST_EQUAL(labels[0].data.convert<int>(), 1);
+    POTHOS_TEST_EQUAL(labels[1].id, "b");
+    POTHOS_TEST_EQUAL(labels[1].data.convert<int>(), 3);
+
+    //indices are absolute in the input stream
+    POTHOS_TEST_EQUAL(labels[0].index, 2);
+    POTHOS_TEST_EQUAL(labels[1].index, 7);
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_signal_bridges_coalesce)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+    auto messageToSignal = Pothos::BlockRegistry::make("/blocks/message_to_signal", "changeEvent");
+    auto slotToMessage = Pothos::BlockRegistry::make("/blocks/slot_to_message", "handleEvent");
+    messageToSignal.call("setMinInterval", 0.05);
+    POTHOS_TEST_EQUAL(messageToSignal.call<double>("getMinInterval"), 0.05);
+    POTHOS_TEST_THROWS(slotToMessage.call("setMinInterval", -1.0), Pothos::RangeException);
+
+    //a burst of updates, much faster than the interval
+    const int numMsgs = 100;
+    for (int i = 0; i < numMsgs; i++) feeder.call("feedMessage", Pothos::Object(i));
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, messageToSignal, 0);
+        topology.connect(messageToSignal, "changeEvent", slotToMessage, "handleEvent");
+        topology.connect(slotToMessage, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.2));
+    }
+
+    //collect the messages
+    std::vector<Pothos::Object> msgs = collector.call("getMessages");
+    std::cout << msgs.size() << std::endl;
+
+    //the first value goes through right away, and the newest value always wins
+    POTHOS_TEST_TRUE(msgs.size() >= 2);
+    POTHOS_TEST_TRUE(msgs.size() < size_t(numMsgs));
+    POTHOS_TEST_EQUAL(msgs.front().convert<int>(), 0);
+    POTHOS_TEST_EQUAL(msgs.back().convert<int>(), numMsgs-1);
+
+    //every message was either emitted or coalesced away
+    const auto coalesced = messageToSignal.call<unsigned long long>("coalescedCount");
+    POTHOS_TEST_EQUAL(msgs.size() + coalesced, size_t(numMsgs));
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_multi_triggered_signal)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+
+    Pothos::ObjectKwargs labelTriggers;
+    labelTriggers["a"] = Pothos::Object("gotA");
+    labelTriggers["b"] = Pothos::Object("gotB");
+    Pothos::ObjectVector messageTriggers;
+    messageTriggers.emplace_back(Pothos::ObjectVector{Pothos::Object(5), Pothos::Object("gotFive")});
+    auto trigger = Pothos::BlockRegistry::make("/blocks/multi_triggered_signal", labelTriggers, messageTriggers);
+
+    Pothos::ObjectKwargs args;
+    args["gotFive"] = Pothos::Object(Pothos::ObjectVector{Pothos::Object("five")});
+    trigger.call("setArgs", args);
+
+    //labels a and b emit their data, message 5 emits its args
+    feeder.call("feedBuffer", Pothos::BufferChunk("int", 10));
+    feeder.call("feedLabel", Pothos::Label("a", 1, 2));
+    feeder.call("feedLabel", Pothos::Label("c", 2, 4));
+    feeder.call("feedLabel", Pothos::Label("b", 3, 6));
+    feeder.call("feedLabel", Pothos::Label("a", 4, 8));
+    feeder.call("feedMessage", Pothos::Object(5));
+    feeder.call("feedMessage", Pothos::Object(6));
+
+    std::map<std::string, Pothos::Proxy> collectors;
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, trigger, 0);
+        for (const auto &name : {"gotA", "gotB", "gotFive"})
+        {
+            auto slotToMessage = Pothos::BlockRegistry::make("/blocks/slot_to_message", "handleEvent");
+            collectors[name] = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+            topology.connect(trigger, name, slotToMessage, "handleEvent");
+            topology.connect(slotToMessage, 0, collectors[name], 0);
+        }
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    std::vector<Pothos::Object> msgsA = collectors["gotA"].call("getMessages");
+    POTHOS_TEST_EQUAL(msgsA.size(), 2);
+    POTHOS_TEST_EQUAL(msgsA[0].convert<int>(), 1);
+    POTHOS_TEST_EQUAL(msgsA[1].convert<int>(), 4);
+
+    std::vector<Pothos::Object> msgsB = collectors["gotB"].call("getMessages");
+    POTHOS_TEST_EQUAL(msgsB.size(), 1);
+    POTHOS_TEST_EQUAL(msgsB[0].convert<int>(), 3);
+
+    std::vector<Pothos::Object> msgsFive = collectors["gotFive"].call("getMessages");
+    POTHOS_TEST_EQUAL(msgsFive.size(), 1);
+    POTHOS_TEST_EQUAL(msgsFive[0].convert<std::string>(), "five");
+}
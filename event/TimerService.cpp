@@ -0,0 +1,107 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TimerService.hpp"
+
+#include <Pothos/Exception.hpp>
+
+TimerService& TimerService::global()
+{
+    static TimerService service;
+    return service;
+}
+
+TimerService::TimerService():
+    _done(false),
+    _lastID(0),
+    _firingID(0)
+{
+    _thread = std::thread(&TimerService::run, this);
+}
+
+TimerService::~TimerService()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _done = true;
+    }
+    _cond.notify_all();
+    _thread.join();
+}
+
+size_t TimerService::start(Clock::time_point start, Clock::duration period, const Callback& callback)
+{
+    if(period <= Clock::duration::zero())
+    {
+        throw Pothos::InvalidArgumentException("TimerService::start()", "period must be positive");
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto id = ++_lastID;
+    _timers[id] = Timer{period, callback};
+    _deadlines.emplace(start + period, id);
+
+    _cond.notify_all();
+    return id;
+}
+
+void TimerService::stop(size_t id)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _timers.erase(id);
+    for(auto it = _deadlines.begin(); it != _deadlines.end(); ++it)
+    {
+        if(it->second != id) continue;
+        _deadlines.erase(it);
+        break;
+    }
+
+    if(std::this_thread::get_id() == _thread.get_id()) return;
+    while(_firingID == id) _cond.wait(lock);
+}
+
+void TimerService::run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while(!_done)
+    {
+        if(_deadlines.empty())
+        {
+            _cond.wait(lock);
+            continue;
+        }
+
+        const auto next = _deadlines.begin();
+        const auto now = Clock::now();
+        if(now < next->first)
+        {
+            _cond.wait_until(lock, next->first);
+            continue;
+        }
+
+        const auto id = next->second;
+        const auto deadline = next->first;
+        _deadlines.erase(next);
+
+        const auto timer = _timers.find(id);
+        if(timer == _timers.end()) continue;
+        const auto period = timer->second.period;
+
+        // Reschedule on the grid after every deadline that has already passed.
+        const size_t numDeadlines = 1 + size_t((now - deadline) / period);
+        const auto latest = deadline + (numDeadlines - 1) * period;
+        _deadlines.emplace(latest + period, id);
+
+        const auto callback = timer->second.callback;
+        _firingID = id;
+        lock.unlock();
+
+        callback(numDeadlines, latest);
+
+        lock.lock();
+        _firingID = 0;
+        _cond.notify_all();
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+//
+// One thread that services every periodic timer in the process, so timed
+// blocks do not each hold a scheduler thread while sleeping. Deadlines are
+// kept on a fixed grid from each timer's start time, so a late wakeup never
+// pushes back the deadlines after it.
+//
+class TimerService
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Called on the service thread with the number of deadlines that passed
+    // since the last call (at least one) and the time of the latest of them.
+    using Callback = std::function<void(size_t numDeadlines, Clock::time_point deadline)>;
+
+    static TimerService& global();
+
+    TimerService();
+    ~TimerService();
+
+    // Returns an ID for stop(). The first deadline is one period after start.
+    size_t start(Clock::time_point start, Clock::duration period, const Callback& callback);
+
+    // Once this returns, the callback is not running and will not be called
+    // again. This can be called from inside the callback itself.
+    void stop(size_t id);
+
+private:
+    struct Timer
+    {
+        Clock::duration period;
+        Callback callback;
+    };
+
+    void run();
+
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    bool _done;
+
+    size_t _lastID;
+    size_t _firingID;
+    std::map<size_t, Timer> _timers;
+    std::multimap<Clock::time_point, size_t> _deadlines;
+
+    std::thread _thread;
+};
@@ -1,6 +1,9 @@
 // Copyright (c) 2016-2016 Josh Blum
+//                    2021 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
+#include "EventThrottle.hpp"
+
 #include <Pothos/Framework.hpp>
 
 /***********************************************************************
@@ -37,11 +40,20 @@
  * |default []
  * |preview valid
  *
+ * |param minInterval[Min Interval] The minimum time between emitted signals.
+ * Trigger events that arrive sooner are coalesced into a single signal,
+ * which is emitted once the interval has passed. Use 0 to emit on every event.
+ * The coalescedCount probe counts the events that were merged away.
+ * |default 0.0
+ * |units seconds
+ * |preview valid
+ *
  * |factory /blocks/triggered_signal()
  * |setter setActivateTrigger(activateTrigger)
  * |setter setMessageTrigger(messageTrigger)
  * |setter setLabelTrigger(labelTrigger)
  * |setter setArgs(args)
+ * |setter setMinInterval(minInterval)
  **********************************************************************/
 class TriggeredSignal : public Pothos::Block
 {
@@ -52,7 +64,8 @@ public:
     }
 
     TriggeredSignal(void):
-        _activateTrigger(false)
+        _activateTrigger(false),
+        _throttle([this]{this->input("flushCoalesced")->pushMessage(Pothos::Object(Pothos::ObjectVector()));})
     {
         this->setupInput(0);
         this->registerSlot("trigger");
@@ -63,6 +76,12 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(TriggeredSignal, setArgs));
         this->registerCall(this, POTHOS_FCN_TUPLE(TriggeredSignal, getArgs));
         this->registerCall(this, POTHOS_FCN_TUPLE(TriggeredSignal, trigger));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TriggeredSignal, setMinInterval));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TriggeredSignal, getMinInterval));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TriggeredSignal, coalescedCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TriggeredSignal, flushCoalesced));
+        this->registerProbe("coalescedCount");
+        this->registerSlot("flushCoalesced"); //woken by the throttle
     }
 
     void setArgs(const Pothos::ObjectVector &args)
@@ -90,11 +109,37 @@ public:
         _labelTrigger = labelTrigger;
     }
 
+    void setMinInterval(const double interval)
+    {
+        _throttle.setMinInterval(interval);
+    }
+
+    double getMinInterval(void) const
+    {
+        return _throttle.getMinInterval();
+    }
+
+    unsigned long long coalescedCount(void) const
+    {
+        return _throttle.coalescedCount();
+    }
+
+    void flushCoalesced(void)
+    {
+        Pothos::ObjectVector args;
+        if (_throttle.takeDue(args)) this->opaqueCallMethod("triggered", args.data(), args.size());
+    }
+
     void activate(void)
     {
         if (_activateTrigger) this->trigger();
     }
 
+    void deactivate(void)
+    {
+        _throttle.reset();
+    }
+
     void work(void)
     {
         auto inPort = this->input(0);
@@ -133,7 +178,7 @@ public:
     //trigger slot and used internally to trigger as well
     void trigger(void)
     {
-        this->opaqueCallMethod("triggered", _args.data(), _args.size());
+        if (_throttle.offer(_args)) this->opaqueCallMethod("triggered", _args.data(), _args.size());
     }
 
 private:
@@ -141,6 +186,7 @@ private:
     Pothos::Object _messageTrigger;
     std::string _labelTrigger;
     Pothos::ObjectVector _args;
+    EventThrottle _throttle;
 };
 
 static Pothos::BlockRegistry registerTriggeredSignal(
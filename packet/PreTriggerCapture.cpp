@@ -0,0 +1,363 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <algorithm> //min/max
+#include <cstring> //memcpy
+#include <vector>
+
+/***********************************************************************
+ * |PothosDoc Pre-Trigger Capture
+ *
+ * The pre-trigger capture block records the most recent elements
+ * of the input stream in a ring buffer. When triggered, the block
+ * outputs the elements before the trigger along with the elements
+ * after the trigger as a single Pothos::Packet message on output port 0.
+ *
+ * <h2>Triggers</h2>
+ * The block is triggered by any of the following:
+ * <ul>
+ * <li>An input label whose ID matches the trigger ID.
+ * The label's element is the first post-trigger element.</li>
+ * <li>Any message on input port 0.</li>
+ * <li>A call to the trigger() slot.</li>
+ * </ul>
+ * For messages and slot calls, the next input element is the
+ * first post-trigger element. Triggers that arrive while the
+ * post-trigger elements are still being captured are ignored.
+ *
+ * <h2>Output packets</h2>
+ * Each packet holds up to the pre-trigger length of elements from
+ * before the trigger, followed by the post-trigger length of elements.
+ * The packet has a label on the first post-trigger element, whose ID is
+ * the trigger ID (or "trigger" when unspecified) and whose data is the
+ * element's index in the input stream. The metadata holds this index
+ * as "triggerIndex", and the number of pre-trigger elements as "preTrigger".
+ *
+ * <h2>Zero-copy operation</h2>
+ * The ring buffers are allocated once, when the block is created.
+ * Each ring buffer is mapped twice in a row in virtual memory,
+ * so that any part of the ring is a single contiguous buffer.
+ * When possible, the output packet references the ring buffer
+ * without a copy, and recording moves to a second ring buffer.
+ * Recording only moves back once the packet is no longer used downstream.
+ * Otherwise, or when the memory mapping is unavailable,
+ * the output packet is copied out of the ring buffer.
+ *
+ * |category /Packet
+ * |keywords packet capture trigger record ring history event snapshot
+ *
+ * |param dtype[Data Type] The input data type.
+ * |widget DTypeChooser(int=1,uint=1,float=1,cint=1,cuint=1,cfloat=1,dim=1)
+ * |default "complex_float32"
+ * |preview disable
+ *
+ * |param preTrigger[Pre-Trigger Length] The number of elements kept from before each trigger.
+ * |default 1024
+ * |units elements
+ * |preview enable
+ *
+ * |param postTrigger[Post-Trigger Length] The number of elements captured after each trigger.
+ * |default 1024
+ * |units elements
+ * |preview enable
+ *
+ * |param triggerId[Trigger ID] The ID of input labels that trigger a capture.
+ * An empty string (default) means that labels do not trigger captures.
+ * |default ""
+ * |widget StringEntry()
+ * |preview valid
+ *
+ * |factory /blocks/pretrigger_capture(dtype,preTrigger,postTrigger)
+ * |setter setTriggerId(triggerId)
+ **********************************************************************/
+class PreTriggerCapture : public Pothos::Block
+{
+public:
+    PreTriggerCapture(const Pothos::DType &dtype, const size_t preTrigger, const size_t postTrigger):
+        _elemSize(dtype.size()),
+        _preTrigger(preTrigger),
+        _postTrigger(postTrigger),
+        _mirrored(false),
+        _ringIndex(0),
+        _ringPos(0),
+        _ringElems(0),
+        _totalElems(0),
+        _capturing(false),
+        _capturePre(0),
+        _captureRemaining(0),
+        _captureIndex(0),
+        _numCaptures(0),
+        _numZeroCopyCaptures(0),
+        _numIgnoredTriggers(0)
+    {
+        this->setupInput(0, dtype);
+        this->setupOutput(0);
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreTriggerCapture, setTriggerId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreTriggerCapture, getTriggerId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreTriggerCapture, getPreTrigger));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreTriggerCapture, getPostTrigger));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreTriggerCapture, trigger));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreTriggerCapture, getNumCaptures));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreTriggerCapture, getNumZeroCopyCaptures));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreTriggerCapture, getNumIgnoredTriggers));
+        this->registerProbe("getNumCaptures", "probeNumCaptures", "numCapturesTriggered");
+        this->registerProbe("getNumZeroCopyCaptures", "probeNumZeroCopyCaptures", "numZeroCopyCapturesTriggered");
+        this->registerProbe("getNumIgnoredTriggers", "probeNumIgnoredTriggers", "numIgnoredTriggersTriggered");
+
+        if (_elemSize == 0) throw Pothos::InvalidArgumentException(
+            "PreTriggerCapture()", "invalid data type: " + dtype.name());
+
+        //the ring holds the entire capture window
+        const size_t ringBytes = std::max<size_t>(1, _preTrigger + _postTrigger)*_elemSize;
+
+        //one ring to record into, and one to hand downstream without a copy
+        for (size_t i = 0; i < NumRings; i++)
+        {
+            try
+            {
+                _rings.push_back(Pothos::SharedBuffer::makeCirc(ringBytes));
+            }
+            catch (const Pothos::Exception &)
+            {
+                //fall back to a single ring that is copied out of
+                _rings.clear();
+                _rings.push_back(Pothos::SharedBuffer::make(ringBytes));
+                return;
+            }
+        }
+        _mirrored = true;
+    }
+
+    static Block *make(const Pothos::DType &dtype, const size_t preTrigger, const size_t postTrigger)
+    {
+        return new PreTriggerCapture(dtype, preTrigger, postTrigger);
+    }
+
+    void setTriggerId(const std::string &id)
+    {
+        _triggerId = id;
+    }
+
+    std::string getTriggerId(void) const
+    {
+        return _triggerId;
+    }
+
+    size_t getPreTrigger(void) const
+    {
+        return _preTrigger;
+    }
+
+    size_t getPostTrigger(void) const
+    {
+        return _postTrigger;
+    }
+
+    unsigned long long getNumCaptures(void) const
+    {
+        return _numCaptures;
+    }
+
+    unsigned long long getNumZeroCopyCaptures(void) const
+    {
+        return _numZeroCopyCaptures;
+    }
+
+    unsigned long long getNumIgnoredTriggers(void) const
+    {
+        return _numIgnoredTriggers;
+    }
+
+    //the next input element is the first post-trigger element
+    void trigger(void)
+    {
+        if (_capturing)
+        {
+            _numIgnoredTriggers++;
+            return;
+        }
+
+        _capturing = true;
+        _capturePre = std::min(_ringElems, _preTrigger);
+        _captureRemaining = _postTrigger;
+        _captureIndex = _totalElems;
+        if (_captureRemaining == 0) this->emitCapture();
+    }
+
+    void activate(void)
+    {
+        //reset state
+        _ringPos = 0;
+        _ringElems = 0;
+        _totalElems = 0;
+        _capturing = false;
+    }
+
+    void work(void)
+    {
+        auto inputPort = this->input(0);
+
+        //any message is a trigger
+        while (inputPort->hasMessage())
+        {
+            inputPort->popMessage();
+            this->trigger();
+        }
+
+        const size_t elems = inputPort->elements();
+        if (elems == 0) return;
+        auto in = inputPort->buffer().as<const char *>();
+
+        //record up to each trigger label, then trigger
+        size_t offset = 0;
+        if (not _triggerId.empty()) for (const auto &label : inputPort->labels())
+        {
+            if (label.index >= elems) break;
+            if (label.id != _triggerId) continue;
+            this->record(in + offset*_elemSize, label.index - offset);
+            offset = label.index;
+            this->trigger();
+        }
+        this->record(in + offset*_elemSize, elems - offset);
+
+        inputPort->consume(elems);
+    }
+
+    void propagateLabels(const Pothos::InputPort *)
+    {
+        //labels are not forwarded, the output is packets only
+    }
+
+private:
+    static constexpr size_t NumRings = 2;
+
+    //write elements into the current ring, emitting when a capture completes
+    void record(const char *in, size_t numElems)
+    {
+        while (numElems != 0)
+        {
+            const size_t n = _capturing? std::min(numElems, _captureRemaining) : numElems;
+            this->writeRing(in, n);
+            in += n*_elemSize;
+            numElems -= n;
+            _totalElems += n;
+
+            if (not _capturing) continue;
+            _captureRemaining -= n;
+            if (_captureRemaining == 0) this->emitCapture();
+        }
+    }
+
+    void writeRing(const char *in, const size_t numElems)
+    {
+        const auto &ring = _rings[_ringIndex];
+        const size_t ringLen = ring.getLength();
+        auto ringPtr = reinterpret_cast<char *>(ring.getAddress());
+
+        size_t bytes = numElems*_elemSize;
+        _ringElems = std::min(_ringElems + numElems, ringLen/_elemSize);
+
+        //only the end of a long write stays in the ring
+        if (bytes > ringLen)
+        {
+            _ringPos = (_ringPos + bytes - ringLen) % ringLen;
+            in += bytes - ringLen;
+            bytes = ringLen;
+        }
+
+        //the mirrored ring is contiguous across the wrap
+        const size_t first = _mirrored? bytes : std::min(bytes, ringLen - _ringPos);
+        std::memcpy(ringPtr + _ringPos, in, first);
+        std::memcpy(ringPtr, in + first, bytes - first);
+        _ringPos = (_ringPos + bytes) % ringLen;
+    }
+
+    //copy the most recent bytes out of the ring
+    void readRing(char *out, const size_t bytes) const
+    {
+        const auto &ring = _rings[_ringIndex];
+        const size_t ringLen = ring.getLength();
+        auto ringPtr = reinterpret_cast<const char *>(ring.getAddress());
+
+        const size_t start = (_ringPos + ringLen - bytes) % ringLen;
+        const size_t first = _mirrored? bytes : std::min(bytes, ringLen - start);
+        std::memcpy(out, ringPtr + start, first);
+        std::memcpy(out + first, ringPtr, bytes - first);
+    }
+
+    //find a ring that is not referenced downstream
+    size_t findSpareRing(void) const
+    {
+        if (not _mirrored) return _rings.size();
+        for (size_t i = 0; i < _rings.size(); i++)
+        {
+            if (i != _ringIndex and _rings[i].useCount() == 1) return i;
+        }
+        return _rings.size();
+    }
+
+    void emitCapture(void)
+    {
+        _capturing = false;
+        const size_t captureBytes = (_capturePre + _postTrigger)*_elemSize;
+
+        Pothos::Packet packet;
+        const size_t spare = this->findSpareRing();
+        if (spare != _rings.size())
+        {
+            //reference the capture in the current ring
+            const auto &ring = _rings[_ringIndex];
+            const size_t start = (_ringPos + ring.getLength() - captureBytes) % ring.getLength();
+            packet.payload = Pothos::BufferChunk(Pothos::SharedBuffer(ring.getAddress() + start, captureBytes, ring));
+
+            //keep recording into the spare ring, starting with the pre-trigger history
+            const size_t historyElems = std::min(_ringElems, _preTrigger);
+            const size_t historyBytes = historyElems*_elemSize;
+            const size_t historyStart = (_ringPos + ring.getLength() - historyBytes) % ring.getLength();
+            auto history = reinterpret_cast<const char *>(ring.getAddress() + historyStart);
+            _ringIndex = spare;
+            _ringPos = 0;
+            _ringElems = 0;
+            this->writeRing(history, historyElems);
+            _numZeroCopyCaptures++;
+        }
+        else
+        {
+            packet.payload = Pothos::BufferChunk(captureBytes);
+            this->readRing(packet.payload.as<char *>(), captureBytes);
+        }
+        packet.payload.dtype = this->input(0)->dtype();
+
+        packet.labels.emplace_back(_triggerId.empty()? "trigger" : _triggerId, _captureIndex, _capturePre);
+        packet.metadata["triggerIndex"] = Pothos::Object(_captureIndex);
+        packet.metadata["preTrigger"] = Pothos::Object(_capturePre);
+
+        this->output(0)->postMessage(std::move(packet));
+        _numCaptures++;
+    }
+
+    const size_t _elemSize;
+    const size_t _preTrigger;
+    const size_t _postTrigger;
+    std::string _triggerId;
+
+    std::vector<Pothos::SharedBuffer> _rings;
+    bool _mirrored;
+    size_t _ringIndex;
+    size_t _ringPos; //bytes
+    size_t _ringElems;
+    unsigned long long _totalElems;
+
+    bool _capturing;
+    size_t _capturePre;
+    size_t _captureRemaining;
+    unsigned long long _captureIndex;
+
+    unsigned long long _numCaptures;
+    unsigned long long _numZeroCopyCaptures;
+    unsigned long long _numIgnoredTriggers;
+};
+
+static Pothos::BlockRegistry registerPreTriggerCapture(
+    "/blocks/pretrigger_capture", &PreTriggerCapture::make);
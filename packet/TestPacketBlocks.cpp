@@ -5,6 +5,7 @@
 #include <Pothos/Framework.hpp>
 #include <Pothos/Proxy.hpp>
 #include <iostream>
+#include <algorithm>
 #include <json.hpp>
 
 using json = nlohmann::json;
@@ -127,3 +128,62 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_stream_to_packet)
     POTHOS_TEST_EQUAL(packet.payload.elements(), eofIndex-sofIndex+1);
     POTHOS_TEST_EQUALA(b0.as<const int *>()+sofIndex, packet.payload.as<const int *>(), packet.payload.elements());
 }
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_pretrigger_capture)
+{
+    const size_t preTrigger = 256;
+    const size_t postTrigger = 100;
+
+    //create the blocks
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+    auto capture = Pothos::BlockRegistry::make("/blocks/pretrigger_capture", "int", preTrigger, postTrigger);
+    capture.call("setTriggerId", "TRIG");
+
+    //create test data, where each value is its index
+    Pothos::BufferChunk b0("int", 10000);
+    for (size_t i = 0; i < b0.elements(); i++)
+        b0.as<int *>()[i] = int(i);
+    feeder.call("feedBuffer", b0);
+
+    //the first trigger has a short history,
+    //and the third trigger is ignored while capturing the second
+    const std::vector<size_t> triggerIndexes = {100, 5000, 8000};
+    feeder.call("feedLabel", Pothos::Label("TRIG", Pothos::Object(), triggerIndexes[0]));
+    feeder.call("feedLabel", Pothos::Label("NOPE", Pothos::Object(), 2000));
+    feeder.call("feedLabel", Pothos::Label("TRIG", Pothos::Object(), triggerIndexes[1]));
+    feeder.call("feedLabel", Pothos::Label("TRIG", Pothos::Object(), triggerIndexes[1]+10));
+    feeder.call("feedLabel", Pothos::Label("TRIG", Pothos::Object(), triggerIndexes[2]));
+
+    //create the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, capture, 0);
+        topology.connect(capture, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the result
+    const std::vector<Pothos::Packet> packets = collector.call("getPackets");
+    POTHOS_TEST_EQUAL(packets.size(), triggerIndexes.size());
+    POTHOS_TEST_EQUAL(capture.call<unsigned long long>("getNumCaptures"), triggerIndexes.size());
+    POTHOS_TEST_EQUAL(capture.call<unsigned long long>("getNumIgnoredTriggers"), 1);
+    for (size_t i = 0; i < packets.size(); i++)
+    {
+        const auto &packet = packets[i];
+        const auto triggerIndex = triggerIndexes[i];
+        const auto pre = std::min(triggerIndex, preTrigger);
+
+        POTHOS_TEST_EQUAL(packet.payload.dtype, Pothos::DType("int"));
+        POTHOS_TEST_EQUAL(packet.payload.elements(), pre+postTrigger);
+        POTHOS_TEST_EQUALA(b0.as<const int *>()+triggerIndex-pre, packet.payload.as<const int *>(), packet.payload.elements());
+
+        POTHOS_TEST_EQUAL(packet.labels.size(), 1);
+        POTHOS_TEST_EQUAL(packet.labels[0].id, "TRIG");
+        POTHOS_TEST_EQUAL(packet.labels[0].index, pre);
+        POTHOS_TEST_EQUAL(packet.labels[0].data.convert<size_t>(), triggerIndex);
+        POTHOS_TEST_EQUAL(packet.metadata.at("triggerIndex").convert<size_t>(), triggerIndex);
+        POTHOS_TEST_EQUAL(packet.metadata.at("preTrigger").convert<size_t>(), pre);
+    }
+}
@@ -0,0 +1,335 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+// Generated at build-time
+#ifdef POTHOS_XSIMD
+#include "StreamBlocks_SIMD.hpp"
+#endif
+
+#include "ScalarKernels.hpp"
+#include "common/SIMDDispatch.hpp"
+
+#include <Pothos/Callable.hpp>
+#include <Pothos/Exception.hpp>
+#include <Pothos/Framework.hpp>
+
+#include <Poco/Format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//
+// Implementation getters to be called on class construction
+//
+
+using BitPackingFcn = void(*)(const std::uint8_t*, std::uint8_t*, size_t, bool, size_t);
+
+#ifdef POTHOS_XSIMD
+
+static inline BitPackingFcn getUnpackBitsFcn()
+{
+    return PothosBlocksSIMD::unpackBitsDispatch<std::uint8_t>();
+}
+
+static inline BitPackingFcn getPackBitsFcn()
+{
+    return PothosBlocksSIMD::packBitsDispatch<std::uint8_t>();
+}
+
+#else
+
+static inline BitPackingFcn getUnpackBitsFcn()
+{
+    return &unpackBitsScalar;
+}
+
+static inline BitPackingFcn getPackBitsFcn()
+{
+    return &packBitsScalar;
+}
+
+#endif
+
+//
+// Block class
+//
+
+// A group is bitsPerSymbol packed bytes, which hold eight symbols.
+class BitPacker: public Pothos::Block
+{
+public:
+    BitPacker(size_t bitsPerSymbol, const std::string& bitOrder, bool pack):
+        Pothos::Block(),
+        _fcn(pack ? BitPackingFunction("packBits", getPackBitsFcn(), &packBitsScalar)
+                  : BitPackingFunction("unpackBits", getUnpackBitsFcn(), &unpackBitsScalar)),
+        _pack(pack),
+        _bitsPerSymbol(0),
+        _msbFirst(true)
+    {
+        this->setupInput(0, "uint8");
+        this->setupOutput(0, "uint8");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(BitPacker, bitsPerSymbol));
+        this->registerCall(this, POTHOS_FCN_TUPLE(BitPacker, setBitsPerSymbol));
+        this->registerCall(this, POTHOS_FCN_TUPLE(BitPacker, bitOrder));
+        this->registerCall(this, POTHOS_FCN_TUPLE(BitPacker, setBitOrder));
+
+        this->registerProbe("bitsPerSymbol");
+        this->registerProbe("bitOrder");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(BitPacker, simdArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(BitPacker, setSIMDArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(BitPacker, simdArchs));
+        this->registerProbe("simdArch");
+
+        this->setBitsPerSymbol(bitsPerSymbol);
+        this->setBitOrder(bitOrder);
+    }
+
+    size_t bitsPerSymbol() const
+    {
+        return _bitsPerSymbol;
+    }
+
+    void setBitsPerSymbol(size_t bitsPerSymbol)
+    {
+        if((bitsPerSymbol < 1) || (bitsPerSymbol > 8))
+        {
+            throw Pothos::RangeException(
+                      "Bits per symbol must be in the range [1,8]",
+                      Poco::format("%z", bitsPerSymbol));
+        }
+
+        _bitsPerSymbol = bitsPerSymbol;
+
+        // Only process whole groups.
+        this->input(0)->setReserve(this->inputGroupSize());
+    }
+
+    std::string bitOrder() const
+    {
+        return _msbFirst ? "MSB" : "LSB";
+    }
+
+    void setBitOrder(const std::string& bitOrder)
+    {
+        if("MSB" == bitOrder)      _msbFirst = true;
+        else if("LSB" == bitOrder) _msbFirst = false;
+        else throw Pothos::InvalidArgumentException("Invalid bit order", bitOrder);
+    }
+
+    std::string simdArch() const
+    {
+        return _fcn.arch();
+    }
+
+    void setSIMDArch(const std::string& arch)
+    {
+        _fcn.setArch(arch);
+    }
+
+    std::vector<std::string> simdArchs() const
+    {
+        return _fcn.archs();
+    }
+
+    void work() override
+    {
+        auto input = this->input(0);
+        auto output = this->output(0);
+
+        if(input->hasMessage())
+        {
+            auto msg = input->popMessage();
+            if(msg.type() == typeid(Pothos::Packet))
+            {
+                output->postMessage(this->_convertPacket(msg.extract<Pothos::Packet>()));
+            }
+            else output->postMessage(std::move(msg));
+        }
+
+        const auto numGroups = std::min(
+                                   input->elements() / this->inputGroupSize(),
+                                   output->elements() / this->outputGroupSize());
+        if(0 == numGroups) return;
+
+        _fcn(
+            input->buffer(),
+            output->buffer(),
+            _bitsPerSymbol,
+            _msbFirst,
+            numGroups);
+
+        input->consume(numGroups * this->inputGroupSize());
+        output->produce(numGroups * this->outputGroupSize());
+    }
+
+    void propagateLabels(const Pothos::InputPort* port) override
+    {
+        auto output = this->output(0);
+        for(auto label: port->labels())
+        {
+            this->adjustLabel(label);
+            output->postLabel(std::move(label));
+        }
+    }
+
+private:
+    using BitPackingFunction = BlocksSIMD::SIMDFunction<BitPackingFcn>;
+
+    BitPackingFunction _fcn;
+
+    bool _pack;
+    size_t _bitsPerSymbol;
+    bool _msbFirst;
+
+    inline size_t inputGroupSize() const
+    {
+        return _pack ? SymbolsPerGroup : _bitsPerSymbol;
+    }
+
+    inline size_t outputGroupSize() const
+    {
+        return _pack ? _bitsPerSymbol : SymbolsPerGroup;
+    }
+
+    // Converts between symbol and byte indices, rounding down to the
+    // output element containing the label's first bit.
+    inline void adjustLabel(Pothos::Label& label) const
+    {
+        if(_pack) label.adjust(_bitsPerSymbol, SymbolsPerGroup);
+        else      label.adjust(SymbolsPerGroup, _bitsPerSymbol);
+
+        if(0 == label.width) label.width = 1;
+    }
+
+    // Packets are converted in full, and a partial group at the end is
+    // padded with zero bits.
+    Pothos::Packet _convertPacket(const Pothos::Packet& packetIn) const
+    {
+        const auto elemsIn = packetIn.payload.length;
+        const auto numGroups = elemsIn / this->inputGroupSize();
+        const auto remainder = elemsIn % this->inputGroupSize();
+
+        // Packing rounds up to cover every input bit, while unpacking
+        // drops bits that do not make a whole symbol.
+        const auto totalBits = elemsIn * (_pack ? _bitsPerSymbol : 8);
+        const auto elemsOut = _pack ? ((totalBits + 7) / 8) : (totalBits / _bitsPerSymbol);
+
+        Pothos::Packet packetOut;
+        packetOut.metadata = packetIn.metadata;
+        packetOut.payload = Pothos::BufferChunk("uint8", elemsOut);
+
+        const auto* buffIn = packetIn.payload.as<const std::uint8_t*>();
+        auto* buffOut = packetOut.payload.as<std::uint8_t*>();
+
+        _fcn(buffIn, buffOut, _bitsPerSymbol, _msbFirst, numGroups);
+
+        if(remainder > 0)
+        {
+            std::uint8_t groupIn[SymbolsPerGroup] = {0};
+            std::uint8_t groupOut[SymbolsPerGroup] = {0};
+            std::memcpy(groupIn, buffIn + (numGroups * this->inputGroupSize()), remainder);
+
+            _fcn(groupIn, groupOut, _bitsPerSymbol, _msbFirst, 1);
+
+            const auto outOffset = numGroups * this->outputGroupSize();
+            std::memcpy(buffOut + outOffset, groupOut, (elemsOut - outOffset));
+        }
+
+        for(auto label: packetIn.labels)
+        {
+            this->adjustLabel(label);
+            if(label.index < elemsOut) packetOut.labels.push_back(std::move(label));
+        }
+
+        return packetOut;
+    }
+};
+
+//
+// Registrations
+//
+
+static Pothos::Block* makePackBits(size_t bitsPerSymbol, const std::string& bitOrder)
+{
+    return new BitPacker(bitsPerSymbol, bitOrder, true);
+}
+
+static Pothos::Block* makeUnpackBits(size_t bitsPerSymbol, const std::string& bitOrder)
+{
+    return new BitPacker(bitsPerSymbol, bitOrder, false);
+}
+
+/***********************************************************************
+ * |PothosDoc Pack Bits
+ *
+ * Packs the lowest bits of each input byte into a contiguous bit stream.
+ * Every eight input symbols produce a number of output bytes equal to the
+ * bits per symbol. Unused upper bits in each input symbol are ignored.
+ *
+ * Input labels are moved to the output byte containing their symbol.
+ * Input packets are packed in full, and the final byte of the output
+ * is padded with zero bits when needed.
+ *
+ * |category /Stream
+ * |category /Convert
+ * |keywords pack bits symbols bytes
+ *
+ * |param bitsPerSymbol[Bits Per Symbol] The number of bits taken from each input byte.
+ * |widget SpinBox(minimum=1,maximum=8)
+ * |default 1
+ * |preview enable
+ *
+ * |param bitOrder[Bit Order] The order of symbols within the packed bit stream.
+ * |widget ComboBox(editable=false)
+ * |option [MSB First] "MSB"
+ * |option [LSB First] "LSB"
+ * |default "MSB"
+ * |preview enable
+ *
+ * |factory /blocks/pack_bits(bitsPerSymbol,bitOrder)
+ * |setter setBitsPerSymbol(bitsPerSymbol)
+ * |setter setBitOrder(bitOrder)
+ **********************************************************************/
+static Pothos::BlockRegistry registerPackBits(
+    "/blocks/pack_bits",
+    Pothos::Callable(&makePackBits));
+
+/***********************************************************************
+ * |PothosDoc Unpack Bits
+ *
+ * Unpacks a contiguous bit stream into one symbol per output byte,
+ * stored in the lowest bits. Every input group with a number of bytes
+ * equal to the bits per symbol produces eight output symbols.
+ *
+ * Input labels are moved to the output symbol containing their first bit.
+ * Input packets are unpacked in full, and trailing bits that do not make
+ * a whole symbol are dropped.
+ *
+ * |category /Stream
+ * |category /Convert
+ * |keywords unpack bits symbols bytes
+ *
+ * |param bitsPerSymbol[Bits Per Symbol] The number of bits stored in each output byte.
+ * |widget SpinBox(minimum=1,maximum=8)
+ * |default 1
+ * |preview enable
+ *
+ * |param bitOrder[Bit Order] The order of symbols within the packed bit stream.
+ * |widget ComboBox(editable=false)
+ * |option [MSB First] "MSB"
+ * |option [LSB First] "LSB"
+ * |default "MSB"
+ * |preview enable
+ *
+ * |factory /blocks/unpack_bits(bitsPerSymbol,bitOrder)
+ * |setter setBitsPerSymbol(bitsPerSymbol)
+ * |setter setBitOrder(bitOrder)
+ **********************************************************************/
+static Pothos::BlockRegistry registerUnpackBits(
+    "/blocks/unpack_bits",
+    Pothos::Callable(&makeUnpackBits));
@@ -0,0 +1,209 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+// Generated at build-time
+#ifdef POTHOS_XSIMD
+#include "StreamBlocks_SIMD.hpp"
+#endif
+
+#include "ScalarKernels.hpp"
+#include "common/SIMDDispatch.hpp"
+
+#include <Pothos/Callable.hpp>
+#include <Pothos/Exception.hpp>
+#include <Pothos/Framework.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+//
+// Implementation getters to be called on class construction
+//
+
+template <typename T>
+using ByteSwapFcn = void(*)(const T*, T*, size_t);
+
+#ifdef POTHOS_XSIMD
+
+template <typename T>
+static inline ByteSwapFcn<T> getByteSwapFcn()
+{
+    return PothosBlocksSIMD::byteswapDispatch<T>();
+}
+
+#else
+
+template <typename T>
+static inline ByteSwapFcn<T> getByteSwapFcn()
+{
+    return &byteswapScalar<T>;
+}
+
+#endif
+
+/***********************************************************************
+ * |PothosDoc Byte Swap
+ *
+ * Reverses the byte order of each input value and outputs the result,
+ * converting between big-endian and little-endian data. The real and
+ * imaginary parts of complex values are swapped separately.
+ *
+ * When the input buffer is not used elsewhere, the swap is done in-place
+ * and the buffer is forwarded to the output. Packets are swapped in-place
+ * under the same condition.
+ *
+ * |category /Stream
+ * |category /Convert
+ * |keywords byte swap endian endianness big little network order
+ *
+ * |param dtype[Data Type] The block's data type. Single-byte types are not supported.
+ * |widget DTypeChooser(int=1,uint=1,float=1,cint=1,cuint=1,cfloat=1,dim=1)
+ * |default "int16"
+ * |preview disable
+ *
+ * |factory /blocks/byteswap(dtype)
+ **********************************************************************/
+
+//
+// T is the size of the word to swap, which is the size of a complex
+// value's components. Each element is processed as an array of words.
+//
+template <typename T>
+class ByteSwap: public Pothos::Block
+{
+public:
+    using Class = ByteSwap<T>;
+
+    ByteSwap(const Pothos::DType& dtype):
+        Pothos::Block(),
+        _elemWords(dtype.size() / sizeof(T)),
+        _fcn("byteswap", getByteSwapFcn<T>(), &byteswapScalar<T>),
+        _simdAligned(false),
+        _simdAlignedElems(BlocksSIMD::simdAlignedElements(dtype.size()))
+    {
+        this->setupInput(0, dtype);
+        this->setupOutput(0, dtype);
+
+        // Swap in-place when the input buffer can be reused.
+        this->output(0)->setReadBeforeWrite(this->input(0));
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArchs));
+        this->registerProbe("simdArch");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdAligned));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDAligned));
+        this->registerProbe("simdAligned");
+    }
+
+    std::string simdArch() const
+    {
+        return _fcn.arch();
+    }
+
+    void setSIMDArch(const std::string& arch)
+    {
+        _fcn.setArch(arch);
+    }
+
+    std::vector<std::string> simdArchs() const
+    {
+        return _fcn.archs();
+    }
+
+    bool simdAligned() const
+    {
+        return _simdAligned;
+    }
+
+    void setSIMDAligned(bool simdAligned)
+    {
+        _simdAligned = simdAligned;
+        this->input(0)->setReserve(_simdAligned ? _simdAlignedElems : 0);
+    }
+
+    void work() override
+    {
+        auto input = this->input(0);
+        auto output = this->output(0);
+
+        if(input->hasMessage())
+        {
+            auto msg = input->popMessage();
+            if(msg.type() == typeid(Pothos::Packet))
+            {
+                // Take the packet out of the message so its payload can be unique.
+                auto packet = std::move(msg.ref<Pothos::Packet>());
+                msg = Pothos::Object();
+
+                output->postMessage(this->_byteswapPacket(std::move(packet)));
+            }
+            else output->postMessage(std::move(msg));
+        }
+
+        auto elems = std::min(input->elements(), output->elements());
+        if(_simdAligned) elems -= (elems % _simdAlignedElems);
+        if(0 == elems) return;
+
+        const T* buffIn = input->buffer();
+        T* buffOut = output->buffer();
+
+        _fcn(buffIn, buffOut, (elems * _elemWords));
+
+        input->consume(elems);
+        output->produce(elems);
+    }
+
+private:
+    size_t _elemWords;
+
+    BlocksSIMD::SIMDFunction<ByteSwapFcn<T>> _fcn;
+
+    bool _simdAligned;
+    size_t _simdAlignedElems;
+
+    Pothos::Packet _byteswapPacket(Pothos::Packet&& packet)
+    {
+        const auto& payloadIn = packet.payload;
+
+        // Only copy into a new buffer if the payload is shared.
+        auto payloadOut = payloadIn.unique() ? payloadIn : this->output(0)->getBuffer(payloadIn.length);
+        payloadOut.dtype = payloadIn.dtype;
+
+        _fcn(
+            payloadIn.as<const T*>(),
+            payloadOut.as<T*>(),
+            (payloadIn.length / sizeof(T)));
+
+        packet.payload = std::move(payloadOut);
+
+        return std::move(packet);
+    }
+};
+
+static Pothos::Block* makeByteSwap(const Pothos::DType& dtype)
+{
+    const auto wordSize = dtype.isComplex() ? (dtype.elemSize() / 2) : dtype.elemSize();
+
+    #define ifWordSizeDeclareByteSwap(T) \
+        if(sizeof(T) == wordSize) \
+        { \
+            return new ByteSwap<T>(dtype); \
+        }
+
+    ifWordSizeDeclareByteSwap(std::uint16_t)
+    ifWordSizeDeclareByteSwap(std::uint32_t)
+    ifWordSizeDeclareByteSwap(std::uint64_t)
+
+    throw Pothos::InvalidArgumentException(
+              "Invalid or unsupported type",
+              dtype.name());
+}
+
+static Pothos::BlockRegistry registerByteSwap(
+    "/blocks/byteswap",
+    Pothos::Callable(&makeByteSwap));
@@ -6,6 +6,9 @@
 #include "StreamBlocks_SIMD.hpp"
 #endif
 
+#include "ScalarKernels.hpp"
+#include "common/SIMDDispatch.hpp"
+
 #include <Pothos/Callable.hpp>
 #include <Pothos/Exception.hpp>
 #include <Pothos/Framework.hpp>
@@ -15,7 +18,9 @@
 
 #include <algorithm>
 #include <limits>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 //
 // Implementation getters to be called on class construction
@@ -37,18 +42,7 @@ static inline ClampFcn<T> getClampFcn()
 template <typename T>
 static inline ClampFcn<T> getClampFcn()
 {
-    return [](const T* in, T* out, const T& lo, const T& hi, size_t num)
-    {
-        for (size_t elem = 0; elem < num; ++elem)
-        {
-#if __cplusplus >= 201703L
-            out[elem] = std::clamp(in[elem], lo, hi);
-#else
-            // See: https://en.cppreference.com/w/cpp/algorithm/clamp
-            out[elem] = (in[elem] < lo) ? lo : (hi < in[elem]) ? hi : in[elem];
-#endif
-        }
-    };
+    return &clampScalar<T>;
 }
 
 #endif
@@ -105,7 +99,10 @@ public:
         _min(0),
         _max(0),
         _clampMin(true),
-        _clampMax(true)
+        _clampMax(true),
+        _fcn("clamp", getClampFcn<T>(), &clampScalar<T>),
+        _simdAligned(false),
+        _simdAlignedElems(BlocksSIMD::simdAlignedElements(sizeof(T) * dimension))
     {
         const Pothos::DType dtype(typeid(T), dimension);
 
@@ -133,6 +130,15 @@ public:
         this->registerSignal("clampMaxChanged");
 
         this->registerCall(this, POTHOS_FCN_TUPLE(Class, setMinAndMax));
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArchs));
+        this->registerProbe("simdArch");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdAligned));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDAligned));
+        this->registerProbe("simdAligned");
     }
 
     T min() const
@@ -195,9 +201,36 @@ public:
         this->emitSignal("clampMaxChanged", _clampMax);
     }
 
+    std::string simdArch() const
+    {
+        return _fcn.arch();
+    }
+
+    void setSIMDArch(const std::string& arch)
+    {
+        _fcn.setArch(arch);
+    }
+
+    std::vector<std::string> simdArchs() const
+    {
+        return _fcn.archs();
+    }
+
+    bool simdAligned() const
+    {
+        return _simdAligned;
+    }
+
+    void setSIMDAligned(bool simdAligned)
+    {
+        _simdAligned = simdAligned;
+        this->input(0)->setReserve(_simdAligned ? _simdAlignedElems : 0);
+    }
+
     void work() override
     {
         auto elems = this->workInfo().minElements;
+        if(_simdAligned) elems -= (elems % _simdAlignedElems);
         if(0 == elems)
         {
             return;
@@ -218,14 +251,17 @@ public:
     }
 
 private:
-    static ClampFcn<T> _fcn;
-
     T _min;
     T _max;
 
     bool _clampMin;
     bool _clampMax;
 
+    BlocksSIMD::SIMDFunction<ClampFcn<T>> _fcn;
+
+    bool _simdAligned;
+    size_t _simdAlignedElems;
+
     static void validateMinMax(const T& minVal, const T& maxVal)
     {
         if(minVal > maxVal)
@@ -240,9 +276,6 @@ private:
     }
 };
 
-template <typename T>
-ClampFcn<T> Clamp<T>::_fcn = getClampFcn<T>();
-
 static Pothos::Block* makeClamp(const Pothos::DType& dtype)
 {
     #define ifTypeDeclareClamp(T) \
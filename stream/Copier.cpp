@@ -1,8 +1,8 @@
 // Copyright (c) 2014-2018 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "CopyEngine.hpp"
 #include <Pothos/Framework.hpp>
-#include <cstring> //memcpy
 #include <algorithm> //min/max
 
 /***********************************************************************
@@ -11,11 +11,35 @@
  * The copier block copies all data from input port 0 to the output port 0.
  * This block is used to bridge connections between incompatible domains.
  *
+ * <h2>Large copies</h2>
+ * Copies of at least the non-temporal threshold use streaming stores,
+ * which bypass the cache so that the copy does not evict other data.
+ * Copies of at least the multi-thread threshold are split across
+ * a pool of helper threads, when the number of helper threads is non-zero.
+ * Packet payloads are copied the same way as stream buffers.
+ *
  * |category /Stream
  * |category /Convert
  * |keywords copier copy memcpy
  *
+ * |param nonTemporalThreshold[Non-Temporal Threshold] Copies of at least this size use non-temporal stores.
+ * |default 1048576
+ * |units bytes
+ * |preview valid
+ *
+ * |param numHelperThreads[Helper Threads] The number of extra threads used for large copies.
+ * |default 0
+ * |preview valid
+ *
+ * |param multiThreadThreshold[Multi-Thread Threshold] Copies of at least this size are split across the helper threads.
+ * |default 4194304
+ * |units bytes
+ * |preview valid
+ *
  * |factory /blocks/copier()
+ * |setter setNonTemporalThreshold(nonTemporalThreshold)
+ * |setter setNumHelperThreads(numHelperThreads)
+ * |setter setMultiThreadThreshold(multiThreadThreshold)
  **********************************************************************/
 class Copier : public Pothos::Block
 {
@@ -29,6 +53,45 @@ public:
     {
         this->setupInput(0);
         this->setupOutput(0);
+        this->registerCall(this, POTHOS_FCN_TUPLE(Copier, setNonTemporalThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Copier, getNonTemporalThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Copier, setNumHelperThreads));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Copier, getNumHelperThreads));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Copier, setMultiThreadThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Copier, getMultiThreadThreshold));
+        this->registerProbe("getNonTemporalThreshold", "probeNonTemporalThreshold", "nonTemporalThresholdTriggered");
+        this->registerProbe("getNumHelperThreads", "probeNumHelperThreads", "numHelperThreadsTriggered");
+        this->registerProbe("getMultiThreadThreshold", "probeMultiThreadThreshold", "multiThreadThresholdTriggered");
+    }
+
+    void setNonTemporalThreshold(const size_t numBytes)
+    {
+        _engine.setNonTemporalThreshold(numBytes);
+    }
+
+    size_t getNonTemporalThreshold(void) const
+    {
+        return _engine.nonTemporalThreshold();
+    }
+
+    void setNumHelperThreads(const size_t numThreads)
+    {
+        _engine.setNumHelperThreads(numThreads);
+    }
+
+    size_t getNumHelperThreads(void) const
+    {
+        return _engine.numHelperThreads();
+    }
+
+    void setMultiThreadThreshold(const size_t numBytes)
+    {
+        _engine.setMultiThreadThreshold(numBytes);
+    }
+
+    size_t getMultiThreadThreshold(void) const
+    {
+        return _engine.multiThreadThreshold();
     }
 
     void work(void)
@@ -44,7 +107,7 @@ public:
                 auto pkt = m.extract<Pothos::Packet>();
                 auto outBuff = outputPort->getBuffer(pkt.payload.length);
                 outBuff.dtype = pkt.payload.dtype;
-                std::memcpy(outBuff.as<void *>(), pkt.payload.as<const void *>(), outBuff.length);
+                _engine.copy(outBuff.as<void *>(), pkt.payload.as<const void *>(), outBuff.length);
                 pkt.payload = std::move(outBuff);
                 outputPort->postMessage(std::move(pkt));
             }
@@ -61,13 +124,16 @@ public:
         outBuff.length = std::min(inBuff.elements(), outBuff.elements())*outBuff.dtype.size();
 
         //copy input to output
-        std::memcpy(outBuff.as<void *>(), inBuff.as<const void *>(), outBuff.length);
+        _engine.copy(outBuff.as<void *>(), inBuff.as<const void *>(), outBuff.length);
 
         //produce/consume
         inputPort->consume(outBuff.length);
         outputPort->popElements(outBuff.length);
         outputPort->postBuffer(outBuff);
     }
+
+private:
+    CopyEngine _engine;
 };
 
 static Pothos::BlockRegistry registerCopier(
@@ -0,0 +1,213 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "CopyEngine.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//
+// Non-temporal copy
+//
+
+// Split copies on cache line boundaries so threads do not share lines.
+static constexpr size_t CacheLineSize = 64;
+
+#if defined(__SSE2__)
+
+static void nonTemporalCopy(void* dst, const void* src, size_t numBytes)
+{
+    auto* out = static_cast<std::uint8_t*>(dst);
+    const auto* in = static_cast<const std::uint8_t*>(src);
+
+    // Streaming stores must be aligned, so copy the unaligned head normally.
+    const auto headBytes = std::min(
+                               numBytes,
+                               ((16 - (reinterpret_cast<std::uintptr_t>(out) % 16)) % 16));
+    std::memcpy(out, in, headBytes);
+    out += headBytes;
+    in += headBytes;
+    numBytes -= headBytes;
+
+    const auto numFrames = numBytes / 64;
+    for(size_t frame = 0; frame < numFrames; ++frame)
+    {
+        const auto* inReg = reinterpret_cast<const __m128i*>(in);
+        auto* outReg = reinterpret_cast<__m128i*>(out);
+
+        const auto reg0 = _mm_loadu_si128(inReg + 0);
+        const auto reg1 = _mm_loadu_si128(inReg + 1);
+        const auto reg2 = _mm_loadu_si128(inReg + 2);
+        const auto reg3 = _mm_loadu_si128(inReg + 3);
+        _mm_stream_si128(outReg + 0, reg0);
+        _mm_stream_si128(outReg + 1, reg1);
+        _mm_stream_si128(outReg + 2, reg2);
+        _mm_stream_si128(outReg + 3, reg3);
+
+        in += 64;
+        out += 64;
+    }
+
+    // Make the streaming stores visible before anyone reads the buffer.
+    _mm_sfence();
+
+    std::memcpy(out, in, (numBytes % 64));
+}
+
+#endif
+
+//
+// CopyEngine
+//
+
+CopyEngine::CopyEngine():
+    _nonTemporalThreshold(1 << 20),
+    _multiThreadThreshold(4 << 20),
+    _generation(0),
+    _numJobsRemaining(0),
+    _stop(false)
+{
+}
+
+CopyEngine::~CopyEngine()
+{
+    this->stopHelpers();
+}
+
+bool CopyEngine::nonTemporalSupported()
+{
+#if defined(__SSE2__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t CopyEngine::nonTemporalThreshold() const
+{
+    return _nonTemporalThreshold;
+}
+
+void CopyEngine::setNonTemporalThreshold(size_t numBytes)
+{
+    _nonTemporalThreshold = numBytes;
+}
+
+size_t CopyEngine::numHelperThreads() const
+{
+    return _helpers.size();
+}
+
+void CopyEngine::setNumHelperThreads(size_t numThreads)
+{
+    if(numThreads == _helpers.size()) return;
+
+    this->stopHelpers();
+
+    _stop = false;
+    _jobs.resize(numThreads);
+    for(size_t helper = 0; helper < numThreads; ++helper)
+    {
+        _helpers.emplace_back(&CopyEngine::helperLoop, this, helper, _generation);
+    }
+}
+
+size_t CopyEngine::multiThreadThreshold() const
+{
+    return _multiThreadThreshold;
+}
+
+void CopyEngine::setMultiThreadThreshold(size_t numBytes)
+{
+    _multiThreadThreshold = numBytes;
+}
+
+void CopyEngine::copy(void* dst, const void* src, size_t numBytes)
+{
+    if(_helpers.empty() || (numBytes < _multiThreadThreshold))
+    {
+        this->copyChunk(dst, src, numBytes);
+        return;
+    }
+
+    // This thread copies the last chunk, which absorbs the remainder.
+    const auto numChunks = _helpers.size() + 1;
+    const auto chunkBytes = ((numBytes / numChunks) / CacheLineSize) * CacheLineSize;
+
+    auto* out = static_cast<std::uint8_t*>(dst);
+    const auto* in = static_cast<const std::uint8_t*>(src);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for(auto& job: _jobs)
+        {
+            job = {out, in, chunkBytes};
+            out += chunkBytes;
+            in += chunkBytes;
+        }
+
+        _numJobsRemaining = _jobs.size();
+        ++_generation;
+    }
+    _jobsReadyCond.notify_all();
+
+    this->copyChunk(out, in, (numBytes - (chunkBytes * _helpers.size())));
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _jobsDoneCond.wait(lock, [this]{return (0 == _numJobsRemaining);});
+}
+
+void CopyEngine::copyChunk(void* dst, const void* src, size_t numBytes) const
+{
+#if defined(__SSE2__)
+    if(numBytes >= _nonTemporalThreshold)
+    {
+        nonTemporalCopy(dst, src, numBytes);
+        return;
+    }
+#endif
+
+    std::memcpy(dst, src, numBytes);
+}
+
+void CopyEngine::helperLoop(size_t helperIndex, unsigned long long lastGeneration)
+{
+    while(true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobsReadyCond.wait(lock, [&]{return _stop || (_generation != lastGeneration);});
+            if(_stop) return;
+
+            lastGeneration = _generation;
+            job = _jobs[helperIndex];
+        }
+
+        this->copyChunk(job.dst, job.src, job.numBytes);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_numJobsRemaining;
+        }
+        _jobsDoneCond.notify_one();
+    }
+}
+
+void CopyEngine::stopHelpers()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _jobsReadyCond.notify_all();
+
+    for(auto& helper: _helpers) helper.join();
+    _helpers.clear();
+}
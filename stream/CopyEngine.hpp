@@ -0,0 +1,73 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//
+// Copies buffers with std::memcpy, switching to non-temporal stores
+// for large copies so the destination does not evict the cache.
+// Large copies can also be split across a pool of helper threads.
+//
+// The engine is not thread-safe, and is meant to be owned by a block
+// and used from its work() and registered calls.
+//
+class CopyEngine
+{
+public:
+    CopyEngine();
+
+    ~CopyEngine();
+
+    void copy(void* dst, const void* src, size_t numBytes);
+
+    size_t nonTemporalThreshold() const;
+
+    // Copies of at least this many bytes use non-temporal stores.
+    void setNonTemporalThreshold(size_t numBytes);
+
+    size_t numHelperThreads() const;
+
+    // Zero helper threads means all copies are single-threaded.
+    void setNumHelperThreads(size_t numThreads);
+
+    size_t multiThreadThreshold() const;
+
+    // Copies of at least this many bytes are split across helper threads.
+    void setMultiThreadThreshold(size_t numBytes);
+
+    // Whether this build can use non-temporal stores
+    static bool nonTemporalSupported();
+
+private:
+    struct Job
+    {
+        void* dst;
+        const void* src;
+        size_t numBytes;
+    };
+
+    size_t _nonTemporalThreshold;
+    size_t _multiThreadThreshold;
+
+    std::vector<std::thread> _helpers;
+    std::vector<Job> _jobs;
+
+    std::mutex _mutex;
+    std::condition_variable _jobsReadyCond;
+    std::condition_variable _jobsDoneCond;
+    unsigned long long _generation;
+    size_t _numJobsRemaining;
+    bool _stop;
+
+    void copyChunk(void* dst, const void* src, size_t numBytes) const;
+
+    void helperLoop(size_t helperIndex, unsigned long long lastGeneration);
+
+    void stopHelpers();
+};
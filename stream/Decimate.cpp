@@ -0,0 +1,276 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+// Generated at build-time
+#ifdef POTHOS_XSIMD
+#include "StreamBlocks_SIMD.hpp"
+#endif
+
+#include "ScalarKernels.hpp"
+#include "common/SIMDDispatch.hpp"
+
+#include <Pothos/Callable.hpp>
+#include <Pothos/Exception.hpp>
+#include <Pothos/Framework.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//
+// Implementation getters to be called on class construction
+//
+
+template <typename T>
+using DecimateFcn = void(*)(const T*, T*, size_t, size_t, size_t);
+
+#ifdef POTHOS_XSIMD
+
+template <typename T>
+static inline DecimateFcn<T> getDecimateFcn()
+{
+    return PothosBlocksSIMD::decimateDispatch<T>();
+}
+
+#else
+
+template <typename T>
+static inline DecimateFcn<T> getDecimateFcn()
+{
+    return &decimateScalar<T>;
+}
+
+#endif
+
+/***********************************************************************
+ * |PothosDoc Decimate
+ *
+ * Keeps one out of every N input elements and outputs the result.
+ * The first input element is always kept. Input labels are moved onto
+ * the next kept element, and their widths are scaled by the factor.
+ *
+ * Input packets are decimated in full, keeping their first element.
+ * A decimation factor of 1 forwards the input buffers without copying.
+ *
+ * |category /Stream
+ * |keywords decimate downsample keep skip stride
+ *
+ * |param dtype[Data Type] The block's data type.
+ * |widget DTypeChooser(int=1,uint=1,float=1,cint=1,cuint=1,cfloat=1,dim=1)
+ * |default "float64"
+ * |preview disable
+ *
+ * |param factor[Factor] Keep one out of every this many elements.
+ * |widget SpinBox(minimum=1)
+ * |default 2
+ * |preview enable
+ *
+ * |factory /blocks/decimate(dtype,factor)
+ * |setter setFactor(factor)
+ **********************************************************************/
+
+//
+// The element is processed as an array of the widest word that evenly
+// divides it, so complex and vector types use the same kernels.
+//
+template <typename T>
+class Decimate: public Pothos::Block
+{
+public:
+    using Class = Decimate<T>;
+
+    Decimate(const Pothos::DType& dtype, size_t factor):
+        Pothos::Block(),
+        _elemWords(dtype.size() / sizeof(T)),
+        _factor(1),
+        _phase(0),
+        _workPhase(0),
+        _fcn("decimate", getDecimateFcn<T>(), &decimateScalar<T>)
+    {
+        this->setupInput(0, dtype);
+        this->setupOutput(0, dtype, this->uid()); // Unique domain due to buffer forwarding
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, factor));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setFactor));
+        this->registerProbe("factor");
+        this->registerSignal("factorChanged");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArchs));
+        this->registerProbe("simdArch");
+
+        this->setFactor(factor);
+    }
+
+    size_t factor() const
+    {
+        return _factor;
+    }
+
+    void setFactor(size_t factor)
+    {
+        if(0 == factor)
+        {
+            throw Pothos::InvalidArgumentException("Factor must be positive.");
+        }
+
+        _factor = factor;
+        _phase = std::min(_phase, (_factor - 1));
+
+        this->emitSignal("factorChanged", _factor);
+    }
+
+    std::string simdArch() const
+    {
+        return _fcn.arch();
+    }
+
+    void setSIMDArch(const std::string& arch)
+    {
+        _fcn.setArch(arch);
+    }
+
+    std::vector<std::string> simdArchs() const
+    {
+        return _fcn.archs();
+    }
+
+    void activate() override
+    {
+        _phase = 0;
+    }
+
+    void work() override
+    {
+        auto input = this->input(0);
+        auto output = this->output(0);
+
+        if(input->hasMessage())
+        {
+            auto msg = input->popMessage();
+            if(msg.type() == typeid(Pothos::Packet))
+            {
+                output->postMessage(this->_decimatePacket(msg.extract<Pothos::Packet>()));
+            }
+            else output->postMessage(std::move(msg));
+        }
+
+        // Stored for label propagation, which happens after work().
+        _workPhase = _phase;
+
+        const auto elemsIn = input->elements();
+        if(0 == elemsIn) return;
+
+        if(1 == _factor)
+        {
+            auto buffer = input->takeBuffer();
+            input->consume(elemsIn);
+            output->postBuffer(std::move(buffer));
+
+            return;
+        }
+
+        // The phase is the number of elements to skip before the next
+        // kept element, carried across calls to work().
+        size_t elemsOut = (elemsIn > _phase) ? (((elemsIn - _phase - 1) / _factor) + 1) : 0;
+        elemsOut = std::min(elemsOut, output->elements());
+
+        const auto elemsConsumed = std::min(elemsIn, (_phase + (elemsOut * _factor)));
+
+        if(elemsOut > 0)
+        {
+            const T* buffIn = input->buffer();
+            T* buffOut = output->buffer();
+
+            _fcn(
+                buffIn + (_phase * _elemWords),
+                buffOut,
+                _elemWords,
+                _factor,
+                elemsOut);
+        }
+
+        _phase = _phase + (elemsOut * _factor) - elemsConsumed;
+
+        input->consume(elemsConsumed);
+        output->produce(elemsOut);
+    }
+
+    void propagateLabels(const Pothos::InputPort* port) override
+    {
+        auto output = this->output(0);
+        for(auto label: port->labels())
+        {
+            label.index = (label.index <= _workPhase) ? 0 : divideRoundUp(label.index - _workPhase);
+            label.width = std::max<size_t>(1, divideRoundUp(label.width));
+
+            output->postLabel(std::move(label));
+        }
+    }
+
+private:
+    size_t _elemWords;
+    size_t _factor;
+    size_t _phase;
+    size_t _workPhase;
+
+    BlocksSIMD::SIMDFunction<DecimateFcn<T>> _fcn;
+
+    inline size_t divideRoundUp(size_t num) const
+    {
+        return (num + _factor - 1) / _factor;
+    }
+
+    Pothos::Packet _decimatePacket(const Pothos::Packet& packetIn) const
+    {
+        const auto elemsIn = packetIn.payload.length / (_elemWords * sizeof(T));
+        const auto elemsOut = divideRoundUp(elemsIn);
+
+        Pothos::Packet packetOut;
+        packetOut.metadata = packetIn.metadata;
+        packetOut.payload = Pothos::BufferChunk(packetIn.payload.dtype, elemsOut);
+
+        _fcn(
+            packetIn.payload.as<const T*>(),
+            packetOut.payload.as<T*>(),
+            _elemWords,
+            _factor,
+            elemsOut);
+
+        // Labels after the last kept element have nowhere to go.
+        for(auto label: packetIn.labels)
+        {
+            label.index = divideRoundUp(label.index);
+            if(label.index >= elemsOut) continue;
+
+            label.width = std::max<size_t>(1, divideRoundUp(label.width));
+            packetOut.labels.push_back(std::move(label));
+        }
+
+        return packetOut;
+    }
+};
+
+static Pothos::Block* makeDecimate(const Pothos::DType& dtype, size_t factor)
+{
+    #define ifWordSizeDeclareDecimate(T) \
+        if(0 == (dtype.size() % sizeof(T))) \
+        { \
+            return new Decimate<T>(dtype, factor); \
+        }
+
+    ifWordSizeDeclareDecimate(std::uint64_t)
+    ifWordSizeDeclareDecimate(std::uint32_t)
+    ifWordSizeDeclareDecimate(std::uint16_t)
+    ifWordSizeDeclareDecimate(std::uint8_t)
+
+    throw Pothos::InvalidArgumentException(
+              "Invalid or unsupported type",
+              dtype.name());
+}
+
+static Pothos::BlockRegistry registerDecimate(
+    "/blocks/decimate",
+    Pothos::Callable(&makeDecimate));
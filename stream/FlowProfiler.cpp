@@ -0,0 +1,227 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "LogLinearHistogram.hpp"
+
+#include <Pothos/Framework.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+/***********************************************************************
+ * |PothosDoc Flow Profiler
+ *
+ * The flow profiler passively forwards all data from input port 0 to
+ * output port 0 without copying it, while recording how data moves
+ * through the edge it is placed on. All statistics are probes, and
+ * times are in seconds.
+ *
+ * <ul>
+ * <li><b>Buffer sizes:</b> the number of elements in each forwarded buffer.</li>
+ * <li><b>Wait times:</b> the time between the previous forward and each buffer
+ * being forwarded. Pothos runs this block as soon as input arrives unless
+ * downstream is still holding its forwarded buffers, so this bounds how long
+ * input sat before it could be forwarded.</li>
+ * <li><b>Output wait fraction:</b> an estimate of the fraction of time spent
+ * blocked on downstream. Waits count toward it when the input built up to
+ * more than twice the mean buffer size in the meantime.</li>
+ * <li><b>Busy fraction:</b> the fraction of time spent inside the block itself.</li>
+ * </ul>
+ *
+ * Statistics start when the topology is activated, or on a call to reset().
+ *
+ * |category /Stream
+ * |category /Debug
+ * |keywords profile profiler backpressure stall latency buffer
+ *
+ * |factory /blocks/flow_profiler()
+ **********************************************************************/
+class FlowProfiler : public Pothos::Block
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static Block *make(void)
+    {
+        return new FlowProfiler();
+    }
+
+    FlowProfiler(void):
+        _totalElements(0),
+        _totalMessages(0),
+        _outputWaitNs(0),
+        _busyNs(0)
+    {
+        this->setupInput(0);
+        this->setupOutput(0, "", this->uid()); //unique domain because of buffer forwarding
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, reset));
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, totalBuffers));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, totalElements));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, totalMessages));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, meanBufferSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, bufferSizeP50));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, bufferSizeP99));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, maxBufferSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, waitP50));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, waitP99));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, maxWait));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, outputWaitFraction));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FlowProfiler, busyFraction));
+        this->registerProbe("totalBuffers");
+        this->registerProbe("totalElements");
+        this->registerProbe("totalMessages");
+        this->registerProbe("meanBufferSize");
+        this->registerProbe("bufferSizeP50");
+        this->registerProbe("bufferSizeP99");
+        this->registerProbe("maxBufferSize");
+        this->registerProbe("waitP50");
+        this->registerProbe("waitP99");
+        this->registerProbe("maxWait");
+        this->registerProbe("outputWaitFraction");
+        this->registerProbe("busyFraction");
+
+        this->reset();
+    }
+
+    void reset(void)
+    {
+        _bufferSizes.reset();
+        _waits.reset();
+
+        _totalElements = 0;
+        _totalMessages = 0;
+        _outputWaitNs = 0;
+        _busyNs = 0;
+
+        _startTime = Clock::now();
+        _lastWorkEnd = _startTime;
+    }
+
+    void activate(void)
+    {
+        this->reset();
+    }
+
+    unsigned long long totalBuffers(void) const
+    {
+        return _bufferSizes.count();
+    }
+
+    unsigned long long totalElements(void) const
+    {
+        return _totalElements;
+    }
+
+    unsigned long long totalMessages(void) const
+    {
+        return _totalMessages;
+    }
+
+    double meanBufferSize(void) const
+    {
+        return _bufferSizes.mean();
+    }
+
+    double bufferSizeP50(void) const
+    {
+        return _bufferSizes.percentile(0.5);
+    }
+
+    double bufferSizeP99(void) const
+    {
+        return _bufferSizes.percentile(0.99);
+    }
+
+    double maxBufferSize(void) const
+    {
+        return _bufferSizes.max();
+    }
+
+    double waitP50(void) const
+    {
+        return _waits.percentile(0.5)/1e9;
+    }
+
+    double waitP99(void) const
+    {
+        return _waits.percentile(0.99)/1e9;
+    }
+
+    double maxWait(void) const
+    {
+        return _waits.max()/1e9;
+    }
+
+    double outputWaitFraction(void) const
+    {
+        return _outputWaitNs/elapsedNs();
+    }
+
+    double busyFraction(void) const
+    {
+        return _busyNs/elapsedNs();
+    }
+
+    void work(void)
+    {
+        const auto workStart = Clock::now();
+
+        auto inputPort = this->input(0);
+        auto outputPort = this->output(0);
+
+        while (inputPort->hasMessage())
+        {
+            outputPort->postMessage(inputPort->popMessage());
+            _totalMessages++;
+        }
+
+        auto buffer = inputPort->takeBuffer();
+        if (buffer.length != 0)
+        {
+            const size_t elems = inputPort->elements();
+            const auto waitNs = toNs(workStart - _lastWorkEnd);
+
+            //input building up means that this block was held, not starved
+            if ((_bufferSizes.count() != 0) and (elems > 2*_bufferSizes.mean())) _outputWaitNs += waitNs;
+
+            _waits.record(waitNs);
+            _bufferSizes.record(elems);
+            _totalElements += elems;
+
+            inputPort->consume(elems);
+            outputPort->postBuffer(std::move(buffer));
+        }
+
+        _lastWorkEnd = Clock::now();
+        _busyNs += toNs(_lastWorkEnd - workStart);
+    }
+
+private:
+    LogLinearHistogram _bufferSizes;
+    LogLinearHistogram _waits;
+
+    unsigned long long _totalElements;
+    unsigned long long _totalMessages;
+
+    double _outputWaitNs;
+    double _busyNs;
+
+    Clock::time_point _startTime;
+    Clock::time_point _lastWorkEnd;
+
+    static std::uint64_t toNs(const Clock::duration &duration)
+    {
+        return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+
+    double elapsedNs(void) const
+    {
+        const auto elapsed = toNs(Clock::now() - _startTime);
+        return (elapsed == 0) ? 1.0 : double(elapsed);
+    }
+};
+
+static Pothos::BlockRegistry registerFlowProfiler(
+    "/blocks/flow_profiler", &FlowProfiler::make);
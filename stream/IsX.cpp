@@ -5,11 +5,17 @@
 #include "StreamBlocks_SIMD.hpp"
 #endif
 
+#include "ScalarKernels.hpp"
+#include "common/SIMDDispatch.hpp"
+
+#include <Pothos/Callable.hpp>
 #include <Pothos/Exception.hpp>
 #include <Pothos/Framework.hpp>
 
 #include <cmath>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 //
 // Implementation getters to be called on class construction
@@ -55,46 +61,31 @@ static inline IsXFcn<T> getIsNegative()
 template <typename T>
 static inline IsXFcn<T> getIsFinite()
 {
-    return [](const T* in, std::int8_t* out, size_t num)
-    {
-        for (size_t i = 0; i < num; ++i) out[i] = std::isfinite(in[i]) ? 1 : 0;
-    };
+    return &isfiniteScalar<T>;
 }
 
 template <typename T>
 static inline IsXFcn<T> getIsInf()
 {
-    return [](const T* in, std::int8_t* out, size_t num)
-    {
-        for (size_t i = 0; i < num; ++i) out[i] = std::isinf(in[i]) ? 1 : 0;
-    };
+    return &isinfScalar<T>;
 }
 
 template <typename T>
 static inline IsXFcn<T> getIsNaN()
 {
-    return [](const T* in, std::int8_t* out, size_t num)
-    {
-        for (size_t i = 0; i < num; ++i) out[i] = std::isnan(in[i]) ? 1 : 0;
-    };
+    return &isnanScalar<T>;
 }
 
 template <typename T>
 static inline IsXFcn<T> getIsNormal()
 {
-    return [](const T* in, std::int8_t* out, size_t num)
-    {
-        for (size_t i = 0; i < num; ++i) out[i] = std::isnormal(in[i]) ? 1 : 0;
-    };
+    return &isnormalScalar<T>;
 }
 
 template <typename T>
 static inline IsXFcn<T> getIsNegative()
 {
-    return [](const T* in, std::int8_t* out, size_t num)
-    {
-        for (size_t i = 0; i < num; ++i) out[i] = std::signbit(in[i]) ? 1 : 0;
-    };
+    return &isnegativeScalar<T>;
 }
 
 #endif
@@ -109,17 +100,55 @@ class IsX: public Pothos::Block
     public:
         using Class = IsX<T>;
 
-        IsX(size_t dimension, IsXFcn<T> fcn):
+        IsX(size_t dimension, const std::string& fcnName, IsXFcn<T> fcn, IsXFcn<T> scalarFcn):
             Pothos::Block(),
-            _fcn(fcn)
+            _fcn(fcnName, fcn, scalarFcn),
+            _simdAligned(false),
+            _simdAlignedElems(BlocksSIMD::simdAlignedElements(sizeof(T) * dimension))
         {
             this->setupInput(0, Pothos::DType(typeid(T), dimension));
             this->setupOutput(0, Pothos::DType("int8", dimension));
+
+            this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArch));
+            this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDArch));
+            this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArchs));
+            this->registerProbe("simdArch");
+
+            this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdAligned));
+            this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDAligned));
+            this->registerProbe("simdAligned");
+        }
+
+        std::string simdArch() const
+        {
+            return _fcn.arch();
+        }
+
+        void setSIMDArch(const std::string& arch)
+        {
+            _fcn.setArch(arch);
+        }
+
+        std::vector<std::string> simdArchs() const
+        {
+            return _fcn.archs();
+        }
+
+        bool simdAligned() const
+        {
+            return _simdAligned;
+        }
+
+        void setSIMDAligned(bool simdAligned)
+        {
+            _simdAligned = simdAligned;
+            this->input(0)->setReserve(_simdAligned ? _simdAlignedElems : 0);
         }
 
         void work() override
         {
-            const auto elems = this->workInfo().minElements;
+            auto elems = this->workInfo().minElements;
+            if(_simdAligned) elems -= (elems % _simdAlignedElems);
             if(0 == elems)
             {
                 return;
@@ -137,7 +166,10 @@ class IsX: public Pothos::Block
         }
 
     private:
-        IsXFcn<T> _fcn;
+        BlocksSIMD::SIMDFunction<IsXFcn<T>> _fcn;
+
+        bool _simdAligned;
+        size_t _simdAlignedElems;
 };
 
 //
@@ -148,9 +180,9 @@ class IsX: public Pothos::Block
     static Pothos::Block* make ## func (const Pothos::DType& dtype) \
     { \
         if(Pothos::DType::fromDType(dtype, 1) == Pothos::DType(typeid(float))) \
-            return new IsX<float>(dtype.dimension(), get ## func <float>()); \
+            return new IsX<float>(dtype.dimension(), #blockName, get ## func <float>(), &blockName ## Scalar <float>); \
         if(Pothos::DType::fromDType(dtype, 1) == Pothos::DType(typeid(double))) \
-            return new IsX<double>(dtype.dimension(), get ## func <double>()); \
+            return new IsX<double>(dtype.dimension(), #blockName, get ## func <double>(), &blockName ## Scalar <double>); \
  \
         throw Pothos::InvalidArgumentException( \
                   std::string(__FUNCTION__)+": invalid type", \
@@ -0,0 +1,364 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "LogLinearHistogram.hpp"
+
+#include <Pothos/Framework.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+//
+// Shared between the inserter and the tap
+//
+
+static const std::string DefaultLatencyLabelID = "latency";
+
+static void validateClock(const std::string& clock)
+{
+    if((clock != "MONOTONIC") && (clock != "REALTIME"))
+    {
+        throw Pothos::InvalidArgumentException("Invalid clock", clock);
+    }
+}
+
+// Nanoseconds since the given clock's epoch
+static long long latencyClockNs(bool realtime)
+{
+    const auto now = realtime ? std::chrono::system_clock::now().time_since_epoch()
+                              : std::chrono::steady_clock::now().time_since_epoch();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+/***********************************************************************
+ * |PothosDoc Latency Probe Inserter
+ *
+ * The latency probe inserter passively forwards all data from input port 0
+ * to output port 0 while attaching timestamps to the stream. Place a
+ * Latency Probe Tap downstream to measure how long data takes to get there.
+ *
+ * Every <i>interval</i> elements, a label is attached whose data is the
+ * current time in nanoseconds. Packet messages carry the timestamp in
+ * their metadata instead, under the label ID, when one of these intervals
+ * starts within their payload.
+ *
+ * |category /Stream
+ * |category /Labels
+ * |keywords latency time timestamp label probe
+ *
+ * |param interval[Interval] The number of elements between timestamps.
+ * |widget SpinBox(minimum=1)
+ * |default 1024
+ * |units elements
+ * |preview enable
+ *
+ * |param labelID[Label ID] The ID of timestamp labels and packet metadata.
+ * |widget StringEntry()
+ * |default "latency"
+ * |preview valid
+ *
+ * |param clock[Clock] The clock used for timestamps. The tap must use the same clock.
+ * <ul>
+ * <li><b>MONOTONIC:</b> A steady clock, for when both blocks are on the same host.</li>
+ * <li><b>REALTIME:</b> The system clock, for measuring across hosts with synchronized clocks.</li>
+ * </ul>
+ * |option [Monotonic] "MONOTONIC"
+ * |option [Realtime] "REALTIME"
+ * |default "MONOTONIC"
+ * |preview valid
+ *
+ * |factory /blocks/latency_probe_inserter()
+ * |setter setInterval(interval)
+ * |setter setLabelID(labelID)
+ * |setter setClock(clock)
+ **********************************************************************/
+class LatencyProbeInserter : public Pothos::Block
+{
+public:
+    static Block *make(void)
+    {
+        return new LatencyProbeInserter();
+    }
+
+    LatencyProbeInserter(void):
+        _interval(1024),
+        _labelID(DefaultLatencyLabelID),
+        _clock("MONOTONIC"),
+        _untilStamp(0),
+        _packetUntilStamp(0)
+    {
+        this->setupInput(0);
+        this->setupOutput(0, "", this->uid()); //unique domain because of buffer forwarding
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeInserter, interval));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeInserter, setInterval));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeInserter, labelID));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeInserter, setLabelID));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeInserter, clock));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeInserter, setClock));
+    }
+
+    size_t interval(void) const
+    {
+        return _interval;
+    }
+
+    void setInterval(const size_t interval)
+    {
+        if (interval == 0) throw Pothos::RangeException("LatencyProbeInserter::setInterval()", "interval must be positive");
+        _interval = interval;
+        _untilStamp = 0;
+        _packetUntilStamp = 0;
+    }
+
+    std::string labelID(void) const
+    {
+        return _labelID;
+    }
+
+    void setLabelID(const std::string &labelID)
+    {
+        _labelID = labelID;
+    }
+
+    std::string clock(void) const
+    {
+        return _clock;
+    }
+
+    void setClock(const std::string &clock)
+    {
+        validateClock(clock);
+        _clock = clock;
+    }
+
+    void work(void)
+    {
+        auto inputPort = this->input(0);
+        auto outputPort = this->output(0);
+
+        const auto now = latencyClockNs(_clock == "REALTIME");
+
+        while (inputPort->hasMessage())
+        {
+            auto msg = inputPort->popMessage();
+            if (msg.type() == typeid(Pothos::Packet))
+            {
+                //packets have their own countdown, in payload elements
+                auto packet = msg.extract<Pothos::Packet>();
+                const size_t packetElems = packet.payload.elements();
+                if (_packetUntilStamp < packetElems) packet.metadata[_labelID] = Pothos::Object(now);
+                for (; _packetUntilStamp < packetElems; _packetUntilStamp += _interval){}
+                _packetUntilStamp -= packetElems;
+                outputPort->postMessage(std::move(packet));
+            }
+            else outputPort->postMessage(std::move(msg));
+        }
+
+        const auto &buffer = inputPort->takeBuffer();
+        if (buffer.length == 0) return;
+
+        const size_t elems = inputPort->elements();
+        inputPort->consume(elems);
+
+        //the countdown carries across buffers
+        for (; _untilStamp < elems; _untilStamp += _interval)
+        {
+            outputPort->postLabel(Pothos::Label(_labelID, now, _untilStamp));
+        }
+        _untilStamp -= elems;
+
+        outputPort->postBuffer(std::move(buffer));
+    }
+
+private:
+    size_t _interval;
+    std::string _labelID;
+    std::string _clock;
+
+    size_t _untilStamp;
+    size_t _packetUntilStamp;
+};
+
+static Pothos::BlockRegistry registerLatencyProbeInserter(
+    "/blocks/latency_probe_inserter", &LatencyProbeInserter::make);
+
+/***********************************************************************
+ * |PothosDoc Latency Probe Tap
+ *
+ * The latency probe tap passively forwards all data from input port 0
+ * to output port 0 while measuring the latency of timestamps attached
+ * upstream by a Latency Probe Inserter.
+ *
+ * Each timestamp is compared against the time it arrives at this block.
+ * Latencies are kept in a histogram with better than 1% resolution, and
+ * the percentiles, minimum, maximum, and mean are available as probes,
+ * in seconds. Timestamps from a clock ahead of this host count as zero.
+ *
+ * |category /Stream
+ * |category /Labels
+ * |keywords latency time timestamp label probe histogram percentile
+ *
+ * |param labelID[Label ID] The ID of timestamp labels and packet metadata.
+ * |widget StringEntry()
+ * |default "latency"
+ * |preview valid
+ *
+ * |param clock[Clock] The clock used by the inserter.
+ * |option [Monotonic] "MONOTONIC"
+ * |option [Realtime] "REALTIME"
+ * |default "MONOTONIC"
+ * |preview valid
+ *
+ * |factory /blocks/latency_probe_tap()
+ * |setter setLabelID(labelID)
+ * |setter setClock(clock)
+ **********************************************************************/
+class LatencyProbeTap : public Pothos::Block
+{
+public:
+    static Block *make(void)
+    {
+        return new LatencyProbeTap();
+    }
+
+    LatencyProbeTap(void):
+        _labelID(DefaultLatencyLabelID),
+        _clock("MONOTONIC")
+    {
+        this->setupInput(0);
+        this->setupOutput(0, "", this->uid()); //unique domain because of buffer forwarding
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeTap, labelID));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeTap, setLabelID));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeTap, clock));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeTap, setClock));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeTap, reset));
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeTap, count));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeTap, p50));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeTap, p99));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeTap, p999));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeTap, minLatency));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeTap, maxLatency));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LatencyProbeTap, meanLatency));
+        this->registerProbe("count");
+        this->registerProbe("p50");
+        this->registerProbe("p99");
+        this->registerProbe("p999");
+        this->registerProbe("minLatency");
+        this->registerProbe("maxLatency");
+        this->registerProbe("meanLatency");
+    }
+
+    std::string labelID(void) const
+    {
+        return _labelID;
+    }
+
+    void setLabelID(const std::string &labelID)
+    {
+        _labelID = labelID;
+    }
+
+    std::string clock(void) const
+    {
+        return _clock;
+    }
+
+    void setClock(const std::string &clock)
+    {
+        validateClock(clock);
+        _clock = clock;
+    }
+
+    void reset(void)
+    {
+        _histogram.reset();
+    }
+
+    unsigned long long count(void) const
+    {
+        return _histogram.count();
+    }
+
+    double p50(void) const
+    {
+        return _histogram.percentile(0.5)/1e9;
+    }
+
+    double p99(void) const
+    {
+        return _histogram.percentile(0.99)/1e9;
+    }
+
+    double p999(void) const
+    {
+        return _histogram.percentile(0.999)/1e9;
+    }
+
+    double minLatency(void) const
+    {
+        return _histogram.min()/1e9;
+    }
+
+    double maxLatency(void) const
+    {
+        return _histogram.max()/1e9;
+    }
+
+    double meanLatency(void) const
+    {
+        return _histogram.mean()/1e9;
+    }
+
+    void work(void)
+    {
+        auto inputPort = this->input(0);
+        auto outputPort = this->output(0);
+
+        const auto now = latencyClockNs(_clock == "REALTIME");
+
+        while (inputPort->hasMessage())
+        {
+            auto msg = inputPort->popMessage();
+            if (msg.type() == typeid(Pothos::Packet))
+            {
+                const auto &packet = msg.extract<Pothos::Packet>();
+                const auto it = packet.metadata.find(_labelID);
+                if (it != packet.metadata.end()) this->record(now, it->second);
+            }
+            outputPort->postMessage(std::move(msg));
+        }
+
+        const auto &buffer = inputPort->takeBuffer();
+        if (buffer.length == 0) return;
+
+        const size_t elems = inputPort->elements();
+        for (const auto &label : inputPort->labels())
+        {
+            if (label.index >= elems) break;
+            if (label.id == _labelID) this->record(now, label.data);
+        }
+
+        inputPort->consume(elems);
+        outputPort->postBuffer(std::move(buffer));
+    }
+
+private:
+    std::string _labelID;
+    std::string _clock;
+
+    LogLinearHistogram _histogram;
+
+    void record(const long long now, const Pothos::Object &timestamp)
+    {
+        const auto then = timestamp.convert<long long>();
+        _histogram.record((now > then) ? std::uint64_t(now - then) : 0);
+    }
+};
+
+static Pothos::BlockRegistry registerLatencyProbeTap(
+    "/blocks/latency_probe_tap", &LatencyProbeTap::make);
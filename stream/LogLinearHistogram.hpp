@@ -0,0 +1,116 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/***********************************************************************
+ * Log-linear histogram of unsigned values, such as latencies in nanoseconds
+ *
+ * Values below 2^SubBucketBits get their own bucket. Above
+ * that, each power of two is split into 2^(SubBucketBits-1) buckets, so
+ * the relative error is bounded no matter the magnitude, and recording
+ * is a shift and an increment.
+ **********************************************************************/
+class LogLinearHistogram
+{
+public:
+    LogLinearHistogram(void):
+        _counts(NumBuckets, 0)
+    {
+        this->reset();
+    }
+
+    void reset(void)
+    {
+        std::fill(_counts.begin(), _counts.end(), 0);
+        _total = 0;
+        _sum = 0.0;
+        _min = std::numeric_limits<std::uint64_t>::max();
+        _max = 0;
+    }
+
+    void record(const std::uint64_t value)
+    {
+        _counts[bucketIndex(value)]++;
+        _total++;
+        _sum += double(value);
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+    }
+
+    unsigned long long count(void) const
+    {
+        return _total;
+    }
+
+    double min(void) const
+    {
+        return (_total == 0) ? 0.0 : double(_min);
+    }
+
+    double max(void) const
+    {
+        return double(_max);
+    }
+
+    double mean(void) const
+    {
+        return (_total == 0) ? 0.0 : _sum/_total;
+    }
+
+    //the midpoint of the bucket holding the given fraction of values
+    double percentile(const double fraction) const
+    {
+        if (_total == 0) return 0.0;
+
+        const auto rank = std::max<unsigned long long>(1, static_cast<unsigned long long>(fraction*_total + 0.5));
+        unsigned long long cumulative = 0;
+        for (size_t index = 0; index < NumBuckets; index++)
+        {
+            cumulative += _counts[index];
+            if (cumulative >= rank)
+            {
+                //never report outside of the recorded range
+                return std::min<double>(std::max<double>(bucketMidpoint(index), _min), _max);
+            }
+        }
+        return double(_max);
+    }
+
+private:
+    static const size_t SubBucketBits = 8;
+    static const size_t SubBucketCount = size_t(1) << SubBucketBits;
+    static const size_t HalfSubBucketCount = SubBucketCount/2;
+    static const size_t NumBuckets = SubBucketCount + (64 - SubBucketBits)*HalfSubBucketCount;
+
+    static size_t bucketIndex(const std::uint64_t value)
+    {
+        if (value < SubBucketCount) return size_t(value);
+
+        size_t msb = 0;
+        while ((value >> msb) > 1) msb++;
+
+        const size_t shift = msb - SubBucketBits + 1;
+        return shift*HalfSubBucketCount + size_t(value >> shift);
+    }
+
+    static double bucketMidpoint(const size_t index)
+    {
+        if (index < SubBucketCount) return double(index);
+
+        const size_t shift = (index - HalfSubBucketCount)/HalfSubBucketCount;
+        const auto sub = std::uint64_t(index - shift*HalfSubBucketCount);
+        return double(sub << shift) + double((std::uint64_t(1) << shift) - 1)/2;
+    }
+
+    std::vector<unsigned long long> _counts;
+    unsigned long long _total;
+    double _sum;
+    std::uint64_t _min;
+    std::uint64_t _max;
+};
@@ -5,13 +5,18 @@
 #include "StreamBlocks_SIMD.hpp"
 #endif
 
+#include "ScalarKernels.hpp"
+#include "common/SIMDDispatch.hpp"
+
 #include <Pothos/Callable.hpp>
 #include <Pothos/Exception.hpp>
 #include <Pothos/Framework.hpp>
 
 #include <algorithm>
 #include <limits>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 //
 // Implementation getters to be called on class construction
@@ -33,22 +38,7 @@ static inline MinMaxFcn<T> getMinMaxFcn()
 template <typename T>
 static inline MinMaxFcn<T> getMinMaxFcn()
 {
-    return [](const T** in, T* minOut, T* maxOut, size_t numInputs, size_t num)
-    {
-        for (size_t elem = 0; elem < num; ++elem)
-        {
-            auto minMaxIters = std::minmax_element(
-                                    in,
-                                    in + numInputs,
-                                    [elem](const T* in0, const T* in1)
-                                    {
-                                        return (in0[elem] < in1[elem]);
-                                    });
-
-            minOut[elem] = (*minMaxIters.first)[elem];
-            maxOut[elem] = (*minMaxIters.second)[elem];
-        }
-    };
+    return &minmaxScalar<T>;
 }
 
 #endif
@@ -83,7 +73,10 @@ public:
 
     MinMax(size_t dimension, size_t numInputs):
         Pothos::Block(),
-        _numInputs(numInputs)
+        _numInputs(numInputs),
+        _minMaxFcn("minmax", getMinMaxFcn<T>(), &minmaxScalar<T>),
+        _simdAligned(false),
+        _simdAlignedElems(BlocksSIMD::simdAlignedElements(sizeof(T) * dimension))
     {
         const Pothos::DType dtype(typeid(T), dimension);
 
@@ -94,6 +87,44 @@ public:
 
         this->setupOutput("min", dtype);
         this->setupOutput("max", dtype);
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArchs));
+        this->registerProbe("simdArch");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdAligned));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDAligned));
+        this->registerProbe("simdAligned");
+    }
+
+    std::string simdArch() const
+    {
+        return _minMaxFcn.arch();
+    }
+
+    void setSIMDArch(const std::string& arch)
+    {
+        _minMaxFcn.setArch(arch);
+    }
+
+    std::vector<std::string> simdArchs() const
+    {
+        return _minMaxFcn.archs();
+    }
+
+    bool simdAligned() const
+    {
+        return _simdAligned;
+    }
+
+    void setSIMDAligned(bool simdAligned)
+    {
+        _simdAligned = simdAligned;
+        for(auto* input: this->inputs())
+        {
+            input->setReserve(_simdAligned ? _simdAlignedElems : 0);
+        }
     }
 
     void work() override
@@ -101,6 +132,7 @@ public:
         const auto& workInfo = this->workInfo();
 
         auto elems = workInfo.minAllElements;
+        if(_simdAligned) elems -= (elems % _simdAlignedElems);
         if(0 == elems)
         {
             return;
@@ -127,13 +159,13 @@ public:
     }
 
 private:
-    static MinMaxFcn<T> _minMaxFcn;
-
     size_t _numInputs;
-};
 
-template <typename T>
-MinMaxFcn<T> MinMax<T>::_minMaxFcn = getMinMaxFcn<T>();
+    BlocksSIMD::SIMDFunction<MinMaxFcn<T>> _minMaxFcn;
+
+    bool _simdAligned;
+    size_t _simdAlignedElems;
+};
 
 static Pothos::Block* makeMinMax(const Pothos::DType& dtype, size_t numInputs)
 {
@@ -6,6 +6,9 @@
 #include "StreamBlocks_SIMD.hpp"
 #endif
 
+#include "ScalarKernels.hpp"
+#include "common/SIMDDispatch.hpp"
+
 #include <Pothos/Callable.hpp>
 #include <Pothos/Exception.hpp>
 #include <Pothos/Framework.hpp>
@@ -14,7 +17,10 @@
 #include <Poco/NumberFormatter.h>
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <string>
+#include <vector>
 
 //
 // Templated implementations
@@ -38,13 +44,7 @@ using RoundFcn = void(*)(const T*, T*, size_t);
     template <typename T> \
     static RoundFcn<T> name() \
     { \
-        return [](const T* in, T* out, size_t num) \
-        { \
-            for(size_t elem = 0; elem < num; ++elem) \
-            { \
-                out[elem] = std::func(in[elem]); \
-            } \
-        }; \
+        return &func ## Scalar<T>; \
     }
 
 #endif
@@ -61,17 +61,58 @@ template <typename T>
 class Round: public Pothos::Block
 {
 public:
-    Round(size_t dimension, RoundFcn<T> fcn): _fcn(fcn)
+    using Class = Round<T>;
+
+    Round(size_t dimension, const std::string& fcnName, RoundFcn<T> fcn, RoundFcn<T> scalarFcn):
+        _fcn(fcnName, fcn, scalarFcn),
+        _simdAligned(false),
+        _simdAlignedElems(BlocksSIMD::simdAlignedElements(sizeof(T) * dimension))
     {
         const Pothos::DType dtype(typeid(T), dimension);
 
         this->setupInput(0, dtype);
         this->setupOutput(0, dtype);
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArchs));
+        this->registerProbe("simdArch");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdAligned));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDAligned));
+        this->registerProbe("simdAligned");
+    }
+
+    std::string simdArch() const
+    {
+        return _fcn.arch();
+    }
+
+    void setSIMDArch(const std::string& arch)
+    {
+        _fcn.setArch(arch);
+    }
+
+    std::vector<std::string> simdArchs() const
+    {
+        return _fcn.archs();
+    }
+
+    bool simdAligned() const
+    {
+        return _simdAligned;
+    }
+
+    void setSIMDAligned(bool simdAligned)
+    {
+        _simdAligned = simdAligned;
+        this->input(0)->setReserve(_simdAligned ? _simdAlignedElems : 0);
     }
 
     void work() override
     {
         auto elems = this->workInfo().minElements;
+        if(_simdAligned) elems -= (elems % _simdAlignedElems);
         if(0 == elems)
         {
             return;
@@ -90,7 +131,10 @@ public:
     }
 
 private:
-    RoundFcn<T> _fcn;
+    BlocksSIMD::SIMDFunction<RoundFcn<T>> _fcn;
+
+    bool _simdAligned;
+    size_t _simdAlignedElems;
 };
 
 //
@@ -102,7 +146,7 @@ static Pothos::Block* makeCeil(const Pothos::DType& dtype)
     #define ifTypeDeclareCeil(T) \
         if(Pothos::DType::fromDType(dtype, 1) == Pothos::DType(typeid(T))) \
         { \
-            return new Round<T>(dtype.dimension(), getCeilFcn<T>()); \
+            return new Round<T>(dtype.dimension(), "ceil", getCeilFcn<T>(), &ceilScalar<T>); \
         }
     ifTypeDeclareCeil(float)
     ifTypeDeclareCeil(double)
@@ -117,7 +161,7 @@ static Pothos::Block* makeFloor(const Pothos::DType& dtype)
     #define ifTypeDeclareFloor(T) \
         if(Pothos::DType::fromDType(dtype, 1) == Pothos::DType(typeid(T))) \
         { \
-            return new Round<T>(dtype.dimension(), getFloorFcn<T>()); \
+            return new Round<T>(dtype.dimension(), "floor", getFloorFcn<T>(), &floorScalar<T>); \
         }
     ifTypeDeclareFloor(float)
     ifTypeDeclareFloor(double)
@@ -132,7 +176,7 @@ static Pothos::Block* makeTrunc(const Pothos::DType& dtype)
     #define ifTypeDeclareTrunc(T) \
         if(Pothos::DType::fromDType(dtype, 1) == Pothos::DType(typeid(T))) \
         { \
-            return new Round<T>(dtype.dimension(), getTruncFcn<T>()); \
+            return new Round<T>(dtype.dimension(), "trunc", getTruncFcn<T>(), &truncScalar<T>); \
         }
     ifTypeDeclareTrunc(float)
     ifTypeDeclareTrunc(double)
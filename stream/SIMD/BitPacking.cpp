@@ -0,0 +1,210 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#include "common/SIMDRegistry.hpp"
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+//
+// A group is BitsPerSymbol packed bytes, which hold eight symbols. Each
+// group is loaded into a single 64-bit word so a whole group is moved at
+// once. With BMI2, pdep/pext do this in one instruction. Otherwise, the
+// symbol count and shifts are known at compile-time, so the compiler
+// unrolls the per-symbol shifts and vectorizes across groups.
+//
+
+namespace PothosBlocksSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    static constexpr size_t SymbolsPerGroup = 8;
+
+    template <size_t BitsPerSymbol>
+    struct BitPackingTraits
+    {
+        static constexpr std::uint64_t SymbolMask = (1ULL << BitsPerSymbol) - 1;
+
+        // The symbol mask repeated in each byte
+        static constexpr std::uint64_t DepositMask = SymbolMask * 0x0101010101010101ULL;
+    };
+
+    // With MSB-first ordering, the first byte is the most significant.
+    template <size_t BitsPerSymbol, bool MSBFirst>
+    static inline std::uint64_t loadPacked(const std::uint8_t* in)
+    {
+        std::uint64_t word = 0;
+        for(size_t byte = 0; byte < BitsPerSymbol; ++byte)
+        {
+            const auto shift = MSBFirst ? (8 * (BitsPerSymbol - 1 - byte)) : (8 * byte);
+            word |= (std::uint64_t(in[byte]) << shift);
+        }
+
+        return word;
+    }
+
+    template <size_t BitsPerSymbol, bool MSBFirst>
+    static inline void storePacked(std::uint64_t word, std::uint8_t* out)
+    {
+        for(size_t byte = 0; byte < BitsPerSymbol; ++byte)
+        {
+            const auto shift = MSBFirst ? (8 * (BitsPerSymbol - 1 - byte)) : (8 * byte);
+            out[byte] = std::uint8_t(word >> shift);
+        }
+    }
+
+    // The bit position of the given symbol in a loaded group
+    template <size_t BitsPerSymbol, bool MSBFirst>
+    static constexpr size_t symbolShift(size_t symbol)
+    {
+        return BitsPerSymbol * (MSBFirst ? (SymbolsPerGroup - 1 - symbol) : symbol);
+    }
+
+#if defined(__BMI2__)
+
+    static inline std::uint64_t loadSymbols(const std::uint8_t* in)
+    {
+        std::uint64_t word = 0;
+        for(size_t symbol = 0; symbol < SymbolsPerGroup; ++symbol)
+        {
+            word |= (std::uint64_t(in[symbol]) << (8 * symbol));
+        }
+
+        return word;
+    }
+
+    static inline void storeSymbols(std::uint64_t word, std::uint8_t* out)
+    {
+        for(size_t symbol = 0; symbol < SymbolsPerGroup; ++symbol)
+        {
+            out[symbol] = std::uint8_t(word >> (8 * symbol));
+        }
+    }
+
+    template <size_t BitsPerSymbol, bool MSBFirst>
+    static void unpackGroups(const std::uint8_t* in, std::uint8_t* out, size_t numGroups)
+    {
+        using Traits = BitPackingTraits<BitsPerSymbol>;
+
+        for(size_t group = 0; group < numGroups; ++group)
+        {
+            auto symbols = _pdep_u64(loadPacked<BitsPerSymbol, MSBFirst>(in), Traits::DepositMask);
+
+            // The first MSB-first symbol was deposited in the last byte.
+            if(MSBFirst) symbols = __builtin_bswap64(symbols);
+            storeSymbols(symbols, out);
+
+            in += BitsPerSymbol;
+            out += SymbolsPerGroup;
+        }
+    }
+
+    template <size_t BitsPerSymbol, bool MSBFirst>
+    static void packGroups(const std::uint8_t* in, std::uint8_t* out, size_t numGroups)
+    {
+        using Traits = BitPackingTraits<BitsPerSymbol>;
+
+        for(size_t group = 0; group < numGroups; ++group)
+        {
+            auto symbols = loadSymbols(in);
+            if(MSBFirst) symbols = __builtin_bswap64(symbols);
+
+            storePacked<BitsPerSymbol, MSBFirst>(_pext_u64(symbols, Traits::DepositMask), out);
+
+            in += SymbolsPerGroup;
+            out += BitsPerSymbol;
+        }
+    }
+
+#else
+
+    template <size_t BitsPerSymbol, bool MSBFirst>
+    static void unpackGroups(const std::uint8_t* in, std::uint8_t* out, size_t numGroups)
+    {
+        using Traits = BitPackingTraits<BitsPerSymbol>;
+
+        for(size_t group = 0; group < numGroups; ++group)
+        {
+            const auto word = loadPacked<BitsPerSymbol, MSBFirst>(in);
+            for(size_t symbol = 0; symbol < SymbolsPerGroup; ++symbol)
+            {
+                out[symbol] = std::uint8_t((word >> symbolShift<BitsPerSymbol, MSBFirst>(symbol)) & Traits::SymbolMask);
+            }
+
+            in += BitsPerSymbol;
+            out += SymbolsPerGroup;
+        }
+    }
+
+    template <size_t BitsPerSymbol, bool MSBFirst>
+    static void packGroups(const std::uint8_t* in, std::uint8_t* out, size_t numGroups)
+    {
+        using Traits = BitPackingTraits<BitsPerSymbol>;
+
+        for(size_t group = 0; group < numGroups; ++group)
+        {
+            std::uint64_t word = 0;
+            for(size_t symbol = 0; symbol < SymbolsPerGroup; ++symbol)
+            {
+                word |= ((in[symbol] & Traits::SymbolMask) << symbolShift<BitsPerSymbol, MSBFirst>(symbol));
+            }
+            storePacked<BitsPerSymbol, MSBFirst>(word, out);
+
+            in += SymbolsPerGroup;
+            out += BitsPerSymbol;
+        }
+    }
+
+#endif
+
+    #define BIT_PACKING_CASE(fcn, bitsPerSymbol) \
+        case bitsPerSymbol: \
+            if(msbFirst) fcn<bitsPerSymbol, true>(in, out, numGroups); \
+            else         fcn<bitsPerSymbol, false>(in, out, numGroups); \
+            break;
+
+    #define BIT_PACKING_SWITCH(fcn) \
+        switch(bitsPerSymbol) \
+        { \
+        BIT_PACKING_CASE(fcn, 1) \
+        BIT_PACKING_CASE(fcn, 2) \
+        BIT_PACKING_CASE(fcn, 3) \
+        BIT_PACKING_CASE(fcn, 4) \
+        BIT_PACKING_CASE(fcn, 5) \
+        BIT_PACKING_CASE(fcn, 6) \
+        BIT_PACKING_CASE(fcn, 7) \
+        BIT_PACKING_CASE(fcn, 8) \
+        default: \
+            break; \
+        }
+}
+
+// Converts groups of bitsPerSymbol bytes into groups of eight symbols.
+template <typename T>
+void unpackBits(const T* in, T* out, size_t bitsPerSymbol, bool msbFirst, size_t numGroups)
+{
+    BIT_PACKING_SWITCH(detail::unpackGroups)
+}
+
+// Converts groups of eight symbols into groups of bitsPerSymbol bytes.
+template <typename T>
+void packBits(const T* in, T* out, size_t bitsPerSymbol, bool msbFirst, size_t numGroups)
+{
+    BIT_PACKING_SWITCH(detail::packGroups)
+}
+
+template void unpackBits<std::uint8_t>(const std::uint8_t*, std::uint8_t*, size_t, bool, size_t);
+template void packBits<std::uint8_t>(const std::uint8_t*, std::uint8_t*, size_t, bool, size_t);
+
+BLOCKS_SIMD_REGISTER("unpackBits", unpackBits<std::uint8_t>)
+BLOCKS_SIMD_REGISTER("packBits", packBits<std::uint8_t>)
+
+}}
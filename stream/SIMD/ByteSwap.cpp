@@ -0,0 +1,111 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <xsimd/xsimd.hpp>
+#include <Pothos/Util/XSIMDTraits.hpp>
+
+#include <cstdint>
+
+#include "common/SIMDRegistry.hpp"
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+#include "common/SIMDAlignment.hpp"
+
+namespace PothosBlocksSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    //
+    // XSIMD has no byte shuffle, so the swaps are done with shifts and
+    // masks that are written to work with both scalars and registers.
+    //
+
+    template <typename T>
+    static inline T swapWord(const T& in, std::uint16_t)
+    {
+        return (in << 8) | (in >> 8);
+    }
+
+    template <typename T>
+    static inline T swapWord(const T& in, std::uint32_t)
+    {
+        static const T Mask(0x00FF00FF);
+
+        const T out = ((in << 8) & ~Mask) | ((in >> 8) & Mask);
+        return (out << 16) | (out >> 16);
+    }
+
+    template <typename T>
+    static inline T swapWord(const T& in, std::uint64_t)
+    {
+        static const T Mask8(0x00FF00FF00FF00FFULL);
+        static const T Mask16(0x0000FFFF0000FFFFULL);
+
+        T out = ((in << 8) & ~Mask8) | ((in >> 8) & Mask8);
+        out = ((out << 16) & ~Mask16) | ((out >> 16) & Mask16);
+        return (out << 32) | (out >> 32);
+    }
+
+    template <typename T>
+    static void byteswapUnoptimized(const T* in, T* out, size_t len)
+    {
+        for(size_t elem = 0; elem < len; ++elem)
+        {
+            out[elem] = swapWord<T>(in[elem], T());
+        }
+    }
+
+    template <typename T>
+    struct ByteSwapBody
+    {
+        template <typename InMode, typename OutMode>
+        static void run(const T* in, T* out, size_t len)
+        {
+            static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+            using Batch = xsimd::batch<T, simdSize>;
+
+            for(size_t elem = 0; elem < len; elem += simdSize)
+            {
+                auto inReg = simdLoad(in + elem, InMode());
+                auto outReg = swapWord<Batch>(inReg, T());
+                simdStore(out + elem, outReg, OutMode());
+            }
+        }
+    };
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, void> byteswap(const T* in, T* out, size_t len)
+    {
+        const auto split = splitForSIMD(in, out, len);
+
+        byteswapUnoptimized(in, out, split.head);
+        runSIMDBody<ByteSwapBody<T>>(split, in, out);
+
+        const auto tailOffset = split.head + split.body;
+        byteswapUnoptimized(in + tailOffset, out + tailOffset, split.tail);
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, void> byteswap(const T* in, T* out, size_t len)
+    {
+        byteswapUnoptimized(in, out, len);
+    }
+}
+
+template <typename T>
+void byteswap(const T* in, T* out, size_t len)
+{
+    detail::byteswap<T>(in, out, len);
+}
+
+#define BYTESWAP(T) \
+    template void byteswap<T>(const T*, T*, size_t); \
+    BLOCKS_SIMD_REGISTER("byteswap", byteswap<T>)
+BYTESWAP(std::uint16_t)
+BYTESWAP(std::uint32_t)
+BYTESWAP(std::uint64_t)
+
+}}
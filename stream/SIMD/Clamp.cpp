@@ -7,10 +7,14 @@
 #include <algorithm>
 #include <type_traits>
 
+#include "common/SIMDRegistry.hpp"
+
 #if !defined POTHOS_SIMD_NAMESPACE
 #error Must define POTHOS_SIMD_NAMESPACE to build this file
 #endif
 
+#include "common/SIMDAlignment.hpp"
+
 namespace PothosBlocksSIMD { namespace POTHOS_SIMD_NAMESPACE {
 
 namespace detail
@@ -46,6 +50,31 @@ namespace detail
         }
     }
 
+    template <typename T>
+    struct ClampBody
+    {
+        template <typename InMode, typename OutMode>
+        static void run(
+            const T* in,
+            T* out,
+            size_t len,
+            const T& lo,
+            const T& hi)
+        {
+            static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+
+            const auto loReg = xsimd::set_simd(lo);
+            const auto hiReg = xsimd::set_simd(hi);
+
+            for(size_t elem = 0; elem < len; elem += simdSize)
+            {
+                auto inReg = simdLoad(in + elem, InMode());
+                auto outReg = xsimd::clip(inReg, loReg, hiReg);
+                simdStore(out + elem, outReg, OutMode());
+            }
+        }
+    };
+
     template <typename T>
     static EnableForSIMDClamp<T, void> clamp(
         const T* in,
@@ -54,27 +83,13 @@ namespace detail
         const T& hi,
         size_t len)
     {
-        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
-        const auto numSIMDFrames = len / simdSize;
-
-        auto loReg = xsimd::set_simd(lo);
-        auto hiReg = xsimd::set_simd(hi);
-
-        const T* inPtr = in;
-        T* outPtr = out;
+        const auto split = splitForSIMD(in, out, len);
 
-        for(size_t frameIndex = 0; frameIndex < numSIMDFrames; ++frameIndex)
-        {
-            auto inReg = xsimd::load_unaligned(inPtr);
-            auto outReg = xsimd::clip(inReg, loReg, hiReg);
-            outReg.store_unaligned(outPtr);
-
-            inPtr += simdSize;
-            outPtr += simdSize;
-        }
+        clampUnoptimized(in, out, lo, hi, split.head);
+        runSIMDBody<ClampBody<T>>(split, in, out, lo, hi);
 
-        // Perform remaining operations manually.
-        clampUnoptimized(inPtr, outPtr, lo, hi, (len - (inPtr - in)));
+        const auto tailOffset = split.head + split.body;
+        clampUnoptimized(in + tailOffset, out + tailOffset, lo, hi, split.tail);
     }
 
     template <typename T>
@@ -95,7 +110,9 @@ void clamp(const T* in, T* out, const T& lo, const T& hi, size_t len)
     detail::clamp<T>(in, out, lo, hi, len);
 }
 
-#define CLAMP(T) template void clamp<T>(const T*, T*, const T&, const T&, size_t);
+#define CLAMP(T) \
+    template void clamp<T>(const T*, T*, const T&, const T&, size_t); \
+    BLOCKS_SIMD_REGISTER("clamp", clamp<T>)
 CLAMP(std::int8_t)
 CLAMP(std::int16_t)
 CLAMP(std::int32_t)
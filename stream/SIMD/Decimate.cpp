@@ -0,0 +1,92 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <algorithm>
+#include <cstdint>
+
+#include "common/SIMDRegistry.hpp"
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+namespace PothosBlocksSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    // XSIMD has no portable gather, so the strided loads are left to
+    // the compiler. With the stride known at compile-time, each
+    // architecture's flags turn these loops into shuffles or gathers.
+    template <typename T, size_t Factor>
+    static void decimateFixed(const T* in, T* out, size_t len)
+    {
+        for(size_t elem = 0; elem < len; ++elem)
+        {
+            out[elem] = in[elem * Factor];
+        }
+    }
+
+    template <typename T>
+    static void decimateUnoptimized(
+        const T* in,
+        T* out,
+        size_t elemWords,
+        size_t factor,
+        size_t len)
+    {
+        const size_t stride = elemWords * factor;
+
+        for(size_t elem = 0; elem < len; ++elem)
+        {
+            std::copy(in, in + elemWords, out);
+
+            in += stride;
+            out += elemWords;
+        }
+    }
+}
+
+template <typename T>
+void decimate(const T* in, T* out, size_t elemWords, size_t factor, size_t len)
+{
+    if(1 == elemWords)
+    {
+        switch(factor)
+        {
+        case 1:
+            std::copy(in, in + len, out);
+            return;
+
+        case 2:
+            detail::decimateFixed<T, 2>(in, out, len);
+            return;
+
+        case 3:
+            detail::decimateFixed<T, 3>(in, out, len);
+            return;
+
+        case 4:
+            detail::decimateFixed<T, 4>(in, out, len);
+            return;
+
+        case 8:
+            detail::decimateFixed<T, 8>(in, out, len);
+            return;
+
+        default:
+            break;
+        }
+    }
+
+    detail::decimateUnoptimized(in, out, elemWords, factor, len);
+}
+
+#define DECIMATE(T) \
+    template void decimate<T>(const T*, T*, size_t, size_t, size_t); \
+    BLOCKS_SIMD_REGISTER("decimate", decimate<T>)
+DECIMATE(std::uint8_t)
+DECIMATE(std::uint16_t)
+DECIMATE(std::uint32_t)
+DECIMATE(std::uint64_t)
+
+}}
@@ -8,10 +8,14 @@
 #include <cstdint>
 #include <type_traits>
 
+#include "common/SIMDRegistry.hpp"
+
 #if !defined POTHOS_SIMD_NAMESPACE
 #error Must define POTHOS_SIMD_NAMESPACE to build this file
 #endif
 
+#include "common/SIMDAlignment.hpp"
+
 namespace PothosBlocksSIMD { namespace POTHOS_SIMD_NAMESPACE {
 
 namespace detail
@@ -48,29 +52,37 @@ namespace detail
             } \
         } \
  \
+        /* The output is narrower than the input, so it's always stored unaligned. */ \
         template <typename T> \
-        static Pothos::Util::EnableIfXSIMDSupports<T, void> fcnName(const T* in, std::int8_t* out, size_t len) \
+        struct fcnName ## Body \
         { \
-            static constexpr size_t simdSize = xsimd::simd_traits<T>::size; \
-            const auto numSIMDFrames = len / simdSize; \
+            template <typename InMode, typename OutMode> \
+            static void run(const T* in, std::int8_t* out, size_t len) \
+            { \
+                static constexpr size_t simdSize = xsimd::simd_traits<T>::size; \
  \
-            const T* inPtr = in; \
-            std::int8_t* outPtr = out; \
+                static const auto ZeroReg = xsimd::batch<T, simdSize>(T(0)); \
+                static const auto OneReg = xsimd::batch<T, simdSize>(T(1)); \
  \
-            static const auto ZeroReg = xsimd::batch<T, simdSize>(T(0)); \
-            static const auto OneReg = xsimd::batch<T, simdSize>(T(1)); \
+                for(size_t elem = 0; elem < len; elem += simdSize) \
+                { \
+                    auto inReg = simdLoad(in + elem, InMode()); \
+                    auto outReg = xsimd::select(maskFcn(inReg), OneReg, ZeroReg); \
+                    outReg.store_unaligned(out + elem); \
+                } \
+            } \
+        }; \
  \
-            for(size_t frameIndex = 0; frameIndex < numSIMDFrames; ++frameIndex) \
-            { \
-                auto inReg = xsimd::load_unaligned(inPtr); \
-                auto outReg = xsimd::select(maskFcn(inReg), OneReg, ZeroReg); \
-                outReg.store_unaligned(outPtr); \
+        template <typename T> \
+        static Pothos::Util::EnableIfXSIMDSupports<T, void> fcnName(const T* in, std::int8_t* out, size_t len) \
+        { \
+            const auto split = splitForSIMD(in, out, len); \
  \
-                inPtr += simdSize; \
-                outPtr += simdSize; \
-            } \
+            fcnName ## Unoptimized(in, out, split.head); \
+            runSIMDBody<fcnName ## Body<T>>(split, in, out); \
  \
-            fcnName ## Unoptimized(inPtr, outPtr, (len - (inPtr - in))); \
+            const auto tailOffset = split.head + split.body; \
+            fcnName ## Unoptimized(in + tailOffset, out + tailOffset, split.tail); \
         } \
  \
         template <typename T> \
@@ -97,7 +109,9 @@ ISX_FUNC_DETAIL_TMPL_CUSTOM(isnegative, std::signbit, isnegative)
         detail::fcn(in, out, len); \
     } \
     template void fcn<float>(const float*, std::int8_t*, size_t); \
-    template void fcn<double>(const double*, std::int8_t*, size_t);
+    template void fcn<double>(const double*, std::int8_t*, size_t); \
+    BLOCKS_SIMD_REGISTER(#fcn, fcn<float>) \
+    BLOCKS_SIMD_REGISTER(#fcn, fcn<double>)
 
 ISX_FUNC(isfinite)
 ISX_FUNC(isinf)
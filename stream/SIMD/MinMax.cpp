@@ -8,10 +8,14 @@
 #include <type_traits>
 #include <vector>
 
+#include "common/SIMDRegistry.hpp"
+
 #if !defined POTHOS_SIMD_NAMESPACE
 #error Must define POTHOS_SIMD_NAMESPACE to build this file
 #endif
 
+#include "common/SIMDAlignment.hpp"
+
 namespace PothosBlocksSIMD { namespace POTHOS_SIMD_NAMESPACE {
 
 namespace detail
@@ -45,47 +49,67 @@ namespace detail
         }
     }
 
-    template <typename T>
-    static EnableForSIMDMinMax<T, void> minmax(const T** inPtrs, T* minOut, T* maxOut, size_t numInputs, size_t len)
+    template <typename T, typename InMode, typename OutMode>
+    static void minmaxBody(const T** inPtrs, T* minOut, T* maxOut, size_t numInputs, size_t offset, size_t len)
     {
-        std::vector<const T*> originalInPtrs(inPtrs, inPtrs+numInputs);
-
-        static constexpr auto simdSize = xsimd::simd_traits<T>::size;
-        const auto numSIMDFrames = len / simdSize;
+        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
 
-        static const auto RegMin = xsimd::set_simd(std::numeric_limits<T>::min());
-        static const auto RegMax = xsimd::set_simd(std::numeric_limits<T>::max());
-
-        for(size_t frameIndex = 0; frameIndex < numSIMDFrames; ++frameIndex)
+        for(size_t elem = offset; elem < (offset + len); elem += simdSize)
         {
-            auto regMin = RegMax;
-            auto regMax = RegMin;
+            // Start from the first input, since numeric_limits<T>::min() is
+            // the smallest positive value for floating-point types.
+            auto regMin = simdLoad(inPtrs[0] + elem, InMode());
+            auto regMax = regMin;
 
-            for(size_t inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+            for(size_t inputIndex = 1; inputIndex < numInputs; ++inputIndex)
             {
-                auto regIn = xsimd::load_unaligned(inPtrs[inputIndex]);
+                auto regIn = simdLoad(inPtrs[inputIndex] + elem, InMode());
                 regMin = xsimd::min(regIn, regMin);
                 regMax = xsimd::max(regIn, regMax);
-
-                inPtrs[inputIndex] += simdSize;
             }
 
-            xsimd::store_unaligned(minOut, regMin);
-            xsimd::store_unaligned(maxOut, regMax);
+            simdStore(minOut + elem, regMin, OutMode());
+            simdStore(maxOut + elem, regMax, OutMode());
+        }
+    }
+
+    template <typename T>
+    static EnableForSIMDMinMax<T, void> minmax(const T** inPtrs, T* minOut, T* maxOut, size_t numInputs, size_t len)
+    {
+        if(0 == numInputs) return;
+
+        // Align with the first input. The others are usually aligned the
+        // same way, but aligned instructions are only used if all are.
+        const auto split = splitForSIMD(inPtrs[0], minOut, len);
 
-            minOut += simdSize;
-            maxOut += simdSize;
+        bool inAligned = split.inAligned;
+        for(size_t inputIndex = 1; inputIndex < numInputs; ++inputIndex)
+        {
+            inAligned = inAligned && isSIMDAligned(inPtrs[inputIndex] + split.head);
         }
+        const bool outAligned = split.outAligned && isSIMDAligned(maxOut + split.head);
+
+        minmaxUnoptimized(inPtrs, minOut, maxOut, numInputs, split.head);
+
+        if(inAligned && outAligned) minmaxBody<T, AlignedMode, AlignedMode>(inPtrs, minOut, maxOut, numInputs, split.head, split.body);
+        else if(inAligned)          minmaxBody<T, AlignedMode, UnalignedMode>(inPtrs, minOut, maxOut, numInputs, split.head, split.body);
+        else                        minmaxBody<T, UnalignedMode, UnalignedMode>(inPtrs, minOut, maxOut, numInputs, split.head, split.body);
 
-        for(size_t frameIndex = 0; frameIndex < numSIMDFrames; ++frameIndex)
+        // Offset copies, since the input pointers belong to the caller.
+        const auto tailOffset = split.head + split.body;
+
+        std::vector<const T*> tailInPtrs(numInputs);
+        for(size_t inputIndex = 0; inputIndex < numInputs; ++inputIndex)
         {
-            minmaxUnoptimized(
-                inPtrs,
-                minOut,
-                maxOut,
-                numInputs,
-                (len - (inPtrs[0] - originalInPtrs[0])));
+            tailInPtrs[inputIndex] = inPtrs[inputIndex] + tailOffset;
         }
+
+        minmaxUnoptimized(
+            tailInPtrs.data(),
+            minOut + tailOffset,
+            maxOut + tailOffset,
+            numInputs,
+            split.tail);
     }
 
     template <typename T>
@@ -101,7 +125,9 @@ void minmax(const T** inPtrs, T* minOut, T* maxOut, size_t numInputs, size_t len
     detail::minmax(inPtrs, minOut, maxOut, numInputs, len);
 }
 
-#define MINMAX(T) template void minmax<T>(const T**, T*, T*, size_t, size_t);
+#define MINMAX(T) \
+    template void minmax<T>(const T**, T*, T*, size_t, size_t); \
+    BLOCKS_SIMD_REGISTER("minmax", minmax<T>)
 MINMAX(std::int8_t)
 MINMAX(std::int16_t)
 MINMAX(std::int32_t)
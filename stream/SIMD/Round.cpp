@@ -7,10 +7,14 @@
 #include <cmath>
 #include <type_traits>
 
+#include "common/SIMDRegistry.hpp"
+
 #if !defined POTHOS_SIMD_NAMESPACE
 #error Must define POTHOS_SIMD_NAMESPACE to build this file
 #endif
 
+#include "common/SIMDAlignment.hpp"
+
 namespace PothosBlocksSIMD { namespace POTHOS_SIMD_NAMESPACE {
 
 namespace detail
@@ -26,25 +30,32 @@ namespace detail
         } \
  \
         template <typename T> \
-        static Pothos::Util::EnableIfXSIMDSupports<T, void> fcn(const T* in, T* out, size_t len) \
+        struct fcn ## Body \
         { \
-            static constexpr size_t simdSize = xsimd::simd_traits<T>::size; \
-            const auto numSIMDFrames = len / simdSize; \
- \
-            const T* inPtr = in; \
-            T* outPtr = out; \
- \
-            for(size_t frameIndex = 0; frameIndex < numSIMDFrames; ++frameIndex) \
+            template <typename InMode, typename OutMode> \
+            static void run(const T* in, T* out, size_t len) \
             { \
-                auto inReg = xsimd::load_unaligned(inPtr); \
-                auto outReg = xsimd::fcn(inReg); \
-                outReg.store_unaligned(outPtr); \
+                static constexpr size_t simdSize = xsimd::simd_traits<T>::size; \
  \
-                inPtr += simdSize; \
-                outPtr += simdSize; \
+                for(size_t elem = 0; elem < len; elem += simdSize) \
+                { \
+                    auto inReg = simdLoad(in + elem, InMode()); \
+                    auto outReg = xsimd::fcn(inReg); \
+                    simdStore(out + elem, outReg, OutMode()); \
+                } \
             } \
+        }; \
+ \
+        template <typename T> \
+        static Pothos::Util::EnableIfXSIMDSupports<T, void> fcn(const T* in, T* out, size_t len) \
+        { \
+            const auto split = splitForSIMD(in, out, len); \
+ \
+            fcn ## Unoptimized(in, out, split.head); \
+            runSIMDBody<fcn ## Body<T>>(split, in, out); \
  \
-            fcn ## Unoptimized(inPtr, outPtr, (len - (inPtr - in))); \
+            const auto tailOffset = split.head + split.body; \
+            fcn ## Unoptimized(in + tailOffset, out + tailOffset, split.tail); \
         } \
  \
         template <typename T> \
@@ -66,7 +77,9 @@ ROUND_FUNC_DEFAULT_TMPL(trunc)
         detail::fcn(in, out, len); \
     } \
     template void fcn<float>(const float*, float*, size_t); \
-    template void fcn<double>(const double*, double*, size_t);
+    template void fcn<double>(const double*, double*, size_t); \
+    BLOCKS_SIMD_REGISTER(#fcn, fcn<float>) \
+    BLOCKS_SIMD_REGISTER(#fcn, fcn<double>)
 
 ROUND_FUNC(ceil)
 ROUND_FUNC(floor)
@@ -0,0 +1,128 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <xsimd/xsimd.hpp>
+#include <Pothos/Util/XSIMDTraits.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+#include "common/SIMDRegistry.hpp"
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+#include "common/SIMDAlignment.hpp"
+
+namespace PothosBlocksSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    // No uint32_t implementation due to SIMD limitation
+    template <typename T>
+    struct IsXSIMDThresholdSupported: public std::integral_constant<bool,
+        Pothos::Util::XSIMDTraits<T>::IsSupported &&
+        !std::is_same<T, std::uint32_t>::value> {};
+
+    template <typename T, typename Ret>
+    using EnableForSIMDThreshold = typename std::enable_if<IsXSIMDThresholdSupported<T>::value, Ret>::type;
+
+    template <typename T, typename Ret>
+    using EnableForDefaultThreshold = typename std::enable_if<!IsXSIMDThresholdSupported<T>::value, Ret>::type;
+
+    template <typename T>
+    static size_t thresholdFindUnoptimized(
+        const T* in,
+        const T& threshold,
+        bool above,
+        size_t len)
+    {
+        for(size_t elem = 0; elem < len; ++elem)
+        {
+            if(above ? (in[elem] > threshold) : (in[elem] < threshold)) return elem;
+        }
+
+        return len;
+    }
+
+    // Returns the offset of the first frame with a match, or len if there is none.
+    template <typename T, typename InMode>
+    static size_t thresholdFindBody(
+        const T* in,
+        const T& threshold,
+        bool above,
+        size_t len)
+    {
+        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+
+        const auto thresholdReg = xsimd::set_simd(threshold);
+
+        // Only compare, and exit at the first frame with a match.
+        for(size_t elem = 0; elem < len; elem += simdSize)
+        {
+            const auto inReg = simdLoad(in + elem, InMode());
+            const auto matchReg = above ? (inReg > thresholdReg) : (inReg < thresholdReg);
+            if(xsimd::any(matchReg)) return elem;
+        }
+
+        return len;
+    }
+
+    template <typename T>
+    static EnableForSIMDThreshold<T, size_t> thresholdFind(
+        const T* in,
+        const T& threshold,
+        bool above,
+        size_t len)
+    {
+        const auto split = splitForSIMD(in, in, len);
+
+        const auto headIndex = thresholdFindUnoptimized(in, threshold, above, split.head);
+        if(headIndex < split.head) return headIndex;
+
+        const auto* bodyIn = in + split.head;
+        const auto bodyOffset = split.inAligned ? thresholdFindBody<T, AlignedMode>(bodyIn, threshold, above, split.body)
+                                                : thresholdFindBody<T, UnalignedMode>(bodyIn, threshold, above, split.body);
+
+        // Find the exact index in the matching frame, or search the
+        // remaining elements manually.
+        const size_t offset = split.head + bodyOffset;
+
+        return offset + thresholdFindUnoptimized(in + offset, threshold, above, (len - offset));
+    }
+
+    template <typename T>
+    static EnableForDefaultThreshold<T, size_t> thresholdFind(
+        const T* in,
+        const T& threshold,
+        bool above,
+        size_t len)
+    {
+        return thresholdFindUnoptimized(in, threshold, above, len);
+    }
+}
+
+// Returns the index of the first element above (or below) the threshold,
+// or len if there is none.
+template <typename T>
+size_t thresholdFind(const T* in, const T& threshold, bool above, size_t len)
+{
+    return detail::thresholdFind<T>(in, threshold, above, len);
+}
+
+#define THRESHOLD_FIND(T) \
+    template size_t thresholdFind<T>(const T*, const T&, bool, size_t); \
+    BLOCKS_SIMD_REGISTER("thresholdFind", thresholdFind<T>)
+THRESHOLD_FIND(std::int8_t)
+THRESHOLD_FIND(std::int16_t)
+THRESHOLD_FIND(std::int32_t)
+THRESHOLD_FIND(std::int64_t)
+THRESHOLD_FIND(std::uint8_t)
+THRESHOLD_FIND(std::uint16_t)
+THRESHOLD_FIND(std::uint32_t)
+THRESHOLD_FIND(std::uint64_t)
+THRESHOLD_FIND(float)
+THRESHOLD_FIND(double)
+
+}}
@@ -0,0 +1,616 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+//
+// Microbenchmarks for the stream/SIMD kernels and their scalar fallbacks.
+//
+// Each kernel is run over every supported type, architecture, length,
+// and alignment, both with a working set small enough to stay in cache
+// and with one rotated through a buffer pool larger than the cache.
+// Results are written as CSV or JSON for comparison between builds.
+//
+
+#include "ScalarKernels.hpp"
+#include "common/SIMDDispatch.hpp"
+
+#include <Pothos/Framework/DType.hpp>
+
+#include <json.hpp>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BLOCKS_BENCHMARK_HAS_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BLOCKS_BENCHMARK_HAS_TSC
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+//
+// Options
+//
+
+struct BenchmarkOptions
+{
+    std::string format{"csv"};
+    std::string outputPath;
+
+    // Substring filters, empty to run everything
+    std::string kernelFilter;
+    std::string typeFilter;
+    std::string archFilter;
+
+    std::vector<size_t> lengths{64, 1024, 16384, 262144};
+    std::vector<size_t> alignments{0, 1}; // In elements, relative to a 64-byte boundary
+    size_t coldPoolBytes{256 << 20};
+    double minSeconds{0.05};
+};
+
+static void printUsage(const char* argv0)
+{
+    std::cerr << "Usage: " << argv0 << " [options]" << std::endl
+              << "  --format csv|json     Output format (default: csv)" << std::endl
+              << "  --output <path>       Output file (default: stdout)" << std::endl
+              << "  --kernel <substr>     Only run matching kernels" << std::endl
+              << "  --type <substr>       Only run matching types" << std::endl
+              << "  --arch <substr>       Only run matching architectures" << std::endl
+              << "  --lengths <n,n,...>   Elements per call" << std::endl
+              << "  --alignments <n,...>  Element offsets from a 64-byte boundary" << std::endl
+              << "  --cold-pool <bytes>   Out-of-cache buffer pool size" << std::endl
+              << "  --min-time <seconds>  Minimum time per measurement" << std::endl;
+}
+
+static std::vector<size_t> parseSizeList(const std::string& str)
+{
+    std::vector<size_t> values;
+    std::stringstream stream(str);
+    std::string token;
+    while(std::getline(stream, token, ','))
+    {
+        if(!token.empty()) values.emplace_back(std::stoull(token));
+    }
+
+    return values;
+}
+
+static bool parseOptions(int argc, char** argv, BenchmarkOptions& options)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if(("--help" == arg) || ("-h" == arg)) return false;
+        if((i + 1) >= argc)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+
+        const std::string value(argv[++i]);
+        if("--format" == arg)          options.format = value;
+        else if("--output" == arg)     options.outputPath = value;
+        else if("--kernel" == arg)     options.kernelFilter = value;
+        else if("--type" == arg)       options.typeFilter = value;
+        else if("--arch" == arg)       options.archFilter = value;
+        else if("--lengths" == arg)    options.lengths = parseSizeList(value);
+        else if("--alignments" == arg) options.alignments = parseSizeList(value);
+        else if("--cold-pool" == arg)  options.coldPoolBytes = std::stoull(value);
+        else if("--min-time" == arg)   options.minSeconds = std::stod(value);
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if(("csv" != options.format) && ("json" != options.format))
+    {
+        std::cerr << "Invalid format " << options.format << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+//
+// Benchmark cases
+//
+
+// Calls one implementation on the given buffers, which are sized and
+// offset by the case's per-element byte counts.
+using KernelCall = std::function<void(const std::uint8_t* in, std::uint8_t* out, size_t len)>;
+
+struct BenchmarkCase
+{
+    std::string kernel;
+    std::string type;
+    size_t elemSize;        // For alignment offsets
+    size_t inBytesPerElem;
+    size_t outBytesPerElem;
+    std::vector<std::pair<std::string, KernelCall>> implementations;
+};
+
+// The scalar fallback, plus every SIMD implementation this CPU can run
+template <typename FcnType>
+static std::vector<std::pair<std::string, FcnType>> getImplementations(const std::string& name, FcnType scalarFcn)
+{
+    std::vector<std::pair<std::string, FcnType>> implementations{{BlocksSIMD::ScalarArch, scalarFcn}};
+
+    const auto& allImplementations = BlocksSIMD::getSIMDImplementations();
+    const auto iter = allImplementations.find(BlocksSIMD::SIMDImplementationKey(name, std::type_index(typeid(FcnType))));
+    if(allImplementations.end() != iter)
+    {
+        for(const auto& implementation: iter->second)
+        {
+            if(BlocksSIMD::isArchSupported(implementation.first))
+            {
+                implementations.emplace_back(implementation.first, reinterpret_cast<FcnType>(implementation.second));
+            }
+        }
+    }
+
+    return implementations;
+}
+
+template <typename T, typename FcnType, typename WrapperType>
+static BenchmarkCase makeCase(
+    const std::string& name,
+    const std::string& kernel,
+    size_t inBytesPerElem,
+    size_t outBytesPerElem,
+    FcnType scalarFcn,
+    WrapperType wrapper)
+{
+    BenchmarkCase benchmarkCase{
+        kernel,
+        Pothos::DType(typeid(T)).name(),
+        sizeof(T),
+        inBytesPerElem,
+        outBytesPerElem,
+        {}};
+
+    for(const auto& implementation: getImplementations(name, scalarFcn))
+    {
+        const auto fcn = implementation.second;
+        benchmarkCase.implementations.emplace_back(
+            implementation.first,
+            [fcn, wrapper](const std::uint8_t* in, std::uint8_t* out, size_t len)
+            {
+                wrapper(fcn, in, out, len);
+            });
+    }
+
+    return benchmarkCase;
+}
+
+// The common "const T* in, T* out, size_t num" signature
+template <typename InT, typename OutT>
+static BenchmarkCase makeUnaryCase(const std::string& name, void(*scalarFcn)(const InT*, OutT*, size_t))
+{
+    return makeCase<InT>(
+               name, name, sizeof(InT), sizeof(OutT), scalarFcn,
+               [](void(*fcn)(const InT*, OutT*, size_t), const std::uint8_t* in, std::uint8_t* out, size_t len)
+               {
+                   fcn(reinterpret_cast<const InT*>(in), reinterpret_cast<OutT*>(out), len);
+               });
+}
+
+template <typename T>
+static void addClampCase(std::vector<BenchmarkCase>& cases)
+{
+    using FcnType = void(*)(const T*, T*, const T&, const T&, size_t);
+
+    cases.emplace_back(makeCase<T>(
+        "clamp", "clamp", sizeof(T), sizeof(T), FcnType(&clampScalar<T>),
+        [](FcnType fcn, const std::uint8_t* in, std::uint8_t* out, size_t len)
+        {
+            fcn(reinterpret_cast<const T*>(in), reinterpret_cast<T*>(out), T(10), T(100), len);
+        }));
+}
+
+template <typename T>
+static void addMinMaxCase(std::vector<BenchmarkCase>& cases)
+{
+    using FcnType = void(*)(const T**, T*, T*, size_t, size_t);
+    static constexpr size_t NumInputs = 4;
+
+    // The inputs are contiguous, and so are the min and max outputs.
+    cases.emplace_back(makeCase<T>(
+        "minmax", "minmax(numInputs=4)", (NumInputs * sizeof(T)), (2 * sizeof(T)), FcnType(&minmaxScalar<T>),
+        [](FcnType fcn, const std::uint8_t* in, std::uint8_t* out, size_t len)
+        {
+            const T* inputs[NumInputs];
+            for(size_t i = 0; i < NumInputs; ++i) inputs[i] = reinterpret_cast<const T*>(in) + (i * len);
+
+            auto* outMin = reinterpret_cast<T*>(out);
+            fcn(inputs, outMin, (outMin + len), NumInputs, len);
+        }));
+}
+
+template <typename T>
+static void addFloatCases(std::vector<BenchmarkCase>& cases)
+{
+    cases.emplace_back(makeUnaryCase("isfinite", &isfiniteScalar<T>));
+    cases.emplace_back(makeUnaryCase("isinf", &isinfScalar<T>));
+    cases.emplace_back(makeUnaryCase("isnan", &isnanScalar<T>));
+    cases.emplace_back(makeUnaryCase("isnormal", &isnormalScalar<T>));
+    cases.emplace_back(makeUnaryCase("isnegative", &isnegativeScalar<T>));
+    cases.emplace_back(makeUnaryCase("ceil", &ceilScalar<T>));
+    cases.emplace_back(makeUnaryCase("floor", &floorScalar<T>));
+    cases.emplace_back(makeUnaryCase("trunc", &truncScalar<T>));
+}
+
+template <typename T>
+static void addDecimateCase(std::vector<BenchmarkCase>& cases)
+{
+    using FcnType = void(*)(const T*, T*, size_t, size_t, size_t);
+    static constexpr size_t Factor = 4;
+
+    cases.emplace_back(makeCase<T>(
+        "decimate", "decimate(factor=4)", (Factor * sizeof(T)), sizeof(T), FcnType(&decimateScalar<T>),
+        [](FcnType fcn, const std::uint8_t* in, std::uint8_t* out, size_t len)
+        {
+            fcn(reinterpret_cast<const T*>(in), reinterpret_cast<T*>(out), 1, Factor, len);
+        }));
+}
+
+template <typename T>
+static void addThresholdCase(std::vector<BenchmarkCase>& cases)
+{
+    using FcnType = size_t(*)(const T*, const T&, bool, size_t);
+
+    // No input is above the maximum, so the whole buffer is searched.
+    cases.emplace_back(makeCase<T>(
+        "thresholdFind", "thresholdFind", sizeof(T), 0, FcnType(&thresholdFindScalar<T>),
+        [](FcnType fcn, const std::uint8_t* in, std::uint8_t*, size_t len)
+        {
+            volatile size_t found = fcn(reinterpret_cast<const T*>(in), std::numeric_limits<T>::max(), true, len);
+            (void)found;
+        }));
+}
+
+static void addBitPackingCases(std::vector<BenchmarkCase>& cases, size_t bitsPerSymbol)
+{
+    using FcnType = void(*)(const std::uint8_t*, std::uint8_t*, size_t, bool, size_t);
+    const auto suffix = "(bitsPerSymbol="+std::to_string(bitsPerSymbol)+")";
+
+    // One element is a group of eight symbols.
+    cases.emplace_back(makeCase<std::uint8_t>(
+        "unpackBits", "unpackBits"+suffix, bitsPerSymbol, SymbolsPerGroup, FcnType(&unpackBitsScalar),
+        [bitsPerSymbol](FcnType fcn, const std::uint8_t* in, std::uint8_t* out, size_t len)
+        {
+            fcn(in, out, bitsPerSymbol, true, len);
+        }));
+    cases.emplace_back(makeCase<std::uint8_t>(
+        "packBits", "packBits"+suffix, SymbolsPerGroup, bitsPerSymbol, FcnType(&packBitsScalar),
+        [bitsPerSymbol](FcnType fcn, const std::uint8_t* in, std::uint8_t* out, size_t len)
+        {
+            fcn(in, out, bitsPerSymbol, true, len);
+        }));
+}
+
+static std::vector<BenchmarkCase> getBenchmarkCases()
+{
+    std::vector<BenchmarkCase> cases;
+
+    #define addIntegerAndFloatCases(T) \
+        addClampCase<T>(cases); \
+        addMinMaxCase<T>(cases); \
+        addThresholdCase<T>(cases);
+
+    addIntegerAndFloatCases(std::int8_t)
+    addIntegerAndFloatCases(std::int16_t)
+    addIntegerAndFloatCases(std::int32_t)
+    addIntegerAndFloatCases(std::int64_t)
+    addIntegerAndFloatCases(std::uint8_t)
+    addIntegerAndFloatCases(std::uint16_t)
+    addIntegerAndFloatCases(std::uint32_t)
+    addIntegerAndFloatCases(std::uint64_t)
+    addIntegerAndFloatCases(float)
+    addIntegerAndFloatCases(double)
+
+    addFloatCases<float>(cases);
+    addFloatCases<double>(cases);
+
+    addDecimateCase<std::uint8_t>(cases);
+    addDecimateCase<std::uint16_t>(cases);
+    addDecimateCase<std::uint32_t>(cases);
+    addDecimateCase<std::uint64_t>(cases);
+
+    cases.emplace_back(makeUnaryCase("byteswap", &byteswapScalar<std::uint16_t>));
+    cases.emplace_back(makeUnaryCase("byteswap", &byteswapScalar<std::uint32_t>));
+    cases.emplace_back(makeUnaryCase("byteswap", &byteswapScalar<std::uint64_t>));
+
+    addBitPackingCases(cases, 1);
+    addBitPackingCases(cases, 5);
+
+    return cases;
+}
+
+//
+// Measurement
+//
+
+static constexpr size_t CacheLineSize = 64;
+
+// Filled once and shared by every run, since filling the cold pool is
+// much slower than measuring a kernel. Each run divides it into slots
+// holding one call's input and output. Hot runs reuse the first slot,
+// and cold runs rotate through all of them.
+class BenchmarkMemory
+{
+public:
+    BenchmarkMemory(size_t capacity):
+        _storage(capacity + CacheLineSize)
+    {
+        // Arbitrary but deterministic data
+        std::uint32_t state = 0x12345678;
+        for(auto& byte: _storage)
+        {
+            state = (state * 1664525) + 1013904223;
+            byte = std::uint8_t(state >> 24);
+        }
+    }
+
+    void setSlotSizes(size_t inBytes, size_t outBytes, bool cold)
+    {
+        _inStride = roundUp(inBytes + CacheLineSize);
+        _outStride = roundUp(outBytes + CacheLineSize);
+
+        const auto slotBytes = _inStride + _outStride;
+        if((slotBytes + CacheLineSize) > _storage.size()) _storage.resize(slotBytes + CacheLineSize);
+
+        const auto addr = reinterpret_cast<std::uintptr_t>(_storage.data());
+        _base = _storage.data() + (roundUp(addr) - addr);
+        _numSlots = cold ? std::max<size_t>(1, (_storage.size() - CacheLineSize) / slotBytes) : 1;
+    }
+
+    size_t numSlots() const
+    {
+        return _numSlots;
+    }
+
+    const std::uint8_t* input(size_t slot) const
+    {
+        return _base + (slot * (_inStride + _outStride));
+    }
+
+    std::uint8_t* output(size_t slot)
+    {
+        return _base + (slot * (_inStride + _outStride)) + _inStride;
+    }
+
+private:
+    std::vector<std::uint8_t> _storage;
+    std::uint8_t* _base{nullptr};
+    size_t _inStride{0};
+    size_t _outStride{0};
+    size_t _numSlots{0};
+
+    static size_t roundUp(size_t num)
+    {
+        return ((num + CacheLineSize - 1) / CacheLineSize) * CacheLineSize;
+    }
+};
+
+struct BenchmarkResult
+{
+    std::string kernel;
+    std::string type;
+    std::string arch;
+    size_t length;
+    size_t alignment;   // In bytes
+    std::string workingSet;
+    size_t workingSetBytes;
+    size_t iterations;
+    double nsPerElem;
+    double cyclesPerElem; // Reference (TSC) cycles, negative if unavailable
+    double gbps;
+};
+
+static inline std::uint64_t readCycleCounter()
+{
+#ifdef BLOCKS_BENCHMARK_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static BenchmarkResult runBenchmark(
+    const BenchmarkCase& benchmarkCase,
+    const std::pair<std::string, KernelCall>& implementation,
+    size_t length,
+    size_t alignmentElems,
+    bool cold,
+    const BenchmarkOptions& options,
+    BenchmarkMemory& memory)
+{
+    const auto alignment = alignmentElems * benchmarkCase.elemSize;
+    const auto inBytes = (benchmarkCase.inBytesPerElem * length) + alignment;
+    const auto outBytes = (benchmarkCase.outBytesPerElem * length) + alignment;
+
+    memory.setSlotSizes(inBytes, outBytes, cold);
+    const auto numSlots = memory.numSlots();
+    const auto& call = implementation.second;
+
+    // Warm up, which also fills the cache for hot runs.
+    for(size_t slot = 0; slot < std::min<size_t>(numSlots, 4); ++slot)
+    {
+        call(memory.input(slot) + alignment, memory.output(slot) + alignment, length);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto minDuration = std::chrono::duration<double>(options.minSeconds);
+
+    size_t iterations = 0;
+    size_t slot = 0;
+    const auto startCycles = readCycleCounter();
+    const auto startTime = Clock::now();
+    auto elapsed = Clock::duration::zero();
+    do
+    {
+        // Check the clock in batches so short calls aren't dominated by it.
+        for(size_t batch = 0; batch < 16; ++batch)
+        {
+            call(memory.input(slot) + alignment, memory.output(slot) + alignment, length);
+            slot = (slot + 1) % numSlots;
+        }
+        iterations += 16;
+        elapsed = Clock::now() - startTime;
+    } while(elapsed < minDuration);
+    const auto cycles = readCycleCounter() - startCycles;
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    const double totalElems = double(iterations) * double(length);
+    const double totalBytes = double(iterations) * double(inBytes - alignment + outBytes - alignment);
+
+    BenchmarkResult result;
+    result.kernel = benchmarkCase.kernel;
+    result.type = benchmarkCase.type;
+    result.arch = implementation.first;
+    result.length = length;
+    result.alignment = alignment;
+    result.workingSet = cold ? "cold" : "hot";
+    result.workingSetBytes = numSlots * (inBytes + outBytes);
+    result.iterations = iterations;
+    result.nsPerElem = (seconds * 1e9) / totalElems;
+#ifdef BLOCKS_BENCHMARK_HAS_TSC
+    result.cyclesPerElem = double(cycles) / totalElems;
+#else
+    (void)cycles;
+    result.cyclesPerElem = -1.0;
+#endif
+    result.gbps = totalBytes / seconds / 1e9;
+
+    return result;
+}
+
+//
+// Output
+//
+
+static void writeCSV(std::ostream& os, const std::vector<BenchmarkResult>& results)
+{
+    os << "kernel,type,arch,length,alignment,workingSet,workingSetBytes,iterations,nsPerElem,cyclesPerElem,GBps" << std::endl;
+    for(const auto& result: results)
+    {
+        os << "\"" << result.kernel << "\","
+           << result.type << ","
+           << result.arch << ","
+           << result.length << ","
+           << result.alignment << ","
+           << result.workingSet << ","
+           << result.workingSetBytes << ","
+           << result.iterations << ","
+           << result.nsPerElem << ",";
+        if(result.cyclesPerElem >= 0.0) os << result.cyclesPerElem;
+        os << "," << result.gbps << std::endl;
+    }
+}
+
+static void writeJSON(std::ostream& os, const std::vector<BenchmarkResult>& results)
+{
+    json jsonResults = json::array();
+    for(const auto& result: results)
+    {
+        json jsonResult;
+        jsonResult["kernel"] = result.kernel;
+        jsonResult["type"] = result.type;
+        jsonResult["arch"] = result.arch;
+        jsonResult["length"] = result.length;
+        jsonResult["alignment"] = result.alignment;
+        jsonResult["workingSet"] = result.workingSet;
+        jsonResult["workingSetBytes"] = result.workingSetBytes;
+        jsonResult["iterations"] = result.iterations;
+        jsonResult["nsPerElem"] = result.nsPerElem;
+        if(result.cyclesPerElem >= 0.0) jsonResult["cyclesPerElem"] = result.cyclesPerElem;
+        else                            jsonResult["cyclesPerElem"] = nullptr;
+        jsonResult["GBps"] = result.gbps;
+
+        jsonResults.push_back(jsonResult);
+    }
+
+    os << jsonResults.dump(4) << std::endl;
+}
+
+static bool matches(const std::string& str, const std::string& filter)
+{
+    return filter.empty() || (std::string::npos != str.find(filter));
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    if(!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    BenchmarkMemory memory(options.coldPoolBytes);
+
+    std::vector<BenchmarkResult> results;
+    for(const auto& benchmarkCase: getBenchmarkCases())
+    {
+        if(!matches(benchmarkCase.kernel, options.kernelFilter)) continue;
+        if(!matches(benchmarkCase.type, options.typeFilter)) continue;
+
+        for(const auto& implementation: benchmarkCase.implementations)
+        {
+            if(!matches(implementation.first, options.archFilter)) continue;
+
+            std::cerr << "Benchmarking " << benchmarkCase.kernel
+                      << " (" << benchmarkCase.type << ", " << implementation.first << ")..."
+                      << std::endl;
+
+            for(const auto length: options.lengths)
+            {
+                for(const auto alignment: options.alignments)
+                {
+                    for(const bool cold: {false, true})
+                    {
+                        results.emplace_back(runBenchmark(
+                            benchmarkCase,
+                            implementation,
+                            length,
+                            alignment,
+                            cold,
+                            options,
+                            memory));
+                    }
+                }
+            }
+        }
+    }
+
+    std::ofstream file;
+    if(!options.outputPath.empty())
+    {
+        file.open(options.outputPath);
+        if(!file)
+        {
+            std::cerr << "Failed to open " << options.outputPath << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    auto& os = options.outputPath.empty() ? std::cout : file;
+
+    if("json" == options.format) writeJSON(os, results);
+    else                         writeCSV(os, results);
+
+    return EXIT_SUCCESS;
+}
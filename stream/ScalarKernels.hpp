@@ -0,0 +1,218 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+//
+// Portable implementations of the stream/SIMD kernels. These are used by
+// the blocks when XSIMD is unavailable or the "scalar" SIMD architecture
+// is selected, and as the baseline for the kernel benchmarks.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+//
+// Clamp
+//
+
+template <typename T>
+static void clampScalar(const T* in, T* out, const T& lo, const T& hi, size_t num)
+{
+    for (size_t elem = 0; elem < num; ++elem)
+    {
+#if __cplusplus >= 201703L
+        out[elem] = std::clamp(in[elem], lo, hi);
+#else
+        // See: https://en.cppreference.com/w/cpp/algorithm/clamp
+        out[elem] = (in[elem] < lo) ? lo : (hi < in[elem]) ? hi : in[elem];
+#endif
+    }
+}
+
+//
+// MinMax
+//
+
+template <typename T>
+static void minmaxScalar(const T** in, T* minOut, T* maxOut, size_t numInputs, size_t num)
+{
+    for (size_t elem = 0; elem < num; ++elem)
+    {
+        auto minMaxIters = std::minmax_element(
+                                in,
+                                in + numInputs,
+                                [elem](const T* in0, const T* in1)
+                                {
+                                    return (in0[elem] < in1[elem]);
+                                });
+
+        minOut[elem] = (*minMaxIters.first)[elem];
+        maxOut[elem] = (*minMaxIters.second)[elem];
+    }
+}
+
+//
+// IsX
+//
+
+template <typename T>
+static void isfiniteScalar(const T* in, std::int8_t* out, size_t num)
+{
+    for (size_t i = 0; i < num; ++i) out[i] = std::isfinite(in[i]) ? 1 : 0;
+}
+
+template <typename T>
+static void isinfScalar(const T* in, std::int8_t* out, size_t num)
+{
+    for (size_t i = 0; i < num; ++i) out[i] = std::isinf(in[i]) ? 1 : 0;
+}
+
+template <typename T>
+static void isnanScalar(const T* in, std::int8_t* out, size_t num)
+{
+    for (size_t i = 0; i < num; ++i) out[i] = std::isnan(in[i]) ? 1 : 0;
+}
+
+template <typename T>
+static void isnormalScalar(const T* in, std::int8_t* out, size_t num)
+{
+    for (size_t i = 0; i < num; ++i) out[i] = std::isnormal(in[i]) ? 1 : 0;
+}
+
+template <typename T>
+static void isnegativeScalar(const T* in, std::int8_t* out, size_t num)
+{
+    for (size_t i = 0; i < num; ++i) out[i] = std::signbit(in[i]) ? 1 : 0;
+}
+
+//
+// Round
+//
+
+#define SCALARFUNC(func) \
+    template <typename T> \
+    static void func ## Scalar(const T* in, T* out, size_t num) \
+    { \
+        for(size_t elem = 0; elem < num; ++elem) \
+        { \
+            out[elem] = std::func(in[elem]); \
+        } \
+    }
+
+SCALARFUNC(ceil)
+SCALARFUNC(floor)
+SCALARFUNC(trunc)
+
+#undef SCALARFUNC
+
+//
+// Decimate
+//
+
+template <typename T>
+static void decimateScalar(const T* in, T* out, size_t elemWords, size_t factor, size_t num)
+{
+    for(size_t elem = 0; elem < num; ++elem)
+    {
+        std::copy(in, in + elemWords, out);
+
+        in += (elemWords * factor);
+        out += elemWords;
+    }
+}
+
+//
+// ByteSwap
+//
+
+template <typename T>
+static void byteswapScalar(const T* in, T* out, size_t num)
+{
+    for(size_t elem = 0; elem < num; ++elem)
+    {
+        const auto* inBytes = reinterpret_cast<const std::uint8_t*>(&in[elem]);
+
+        T value;
+        auto* valueBytes = reinterpret_cast<std::uint8_t*>(&value);
+        std::reverse_copy(inBytes, inBytes + sizeof(T), valueBytes);
+
+        out[elem] = value;
+    }
+}
+
+//
+// BitPacking
+//
+
+static constexpr size_t SymbolsPerGroup = 8;
+
+// The bit position of the given symbol in a group
+static inline size_t symbolShift(size_t bitsPerSymbol, bool msbFirst, size_t symbol)
+{
+    return bitsPerSymbol * (msbFirst ? (SymbolsPerGroup - 1 - symbol) : symbol);
+}
+
+static inline size_t byteShift(size_t bitsPerSymbol, bool msbFirst, size_t byte)
+{
+    return 8 * (msbFirst ? (bitsPerSymbol - 1 - byte) : byte);
+}
+
+static inline void unpackBitsScalar(const std::uint8_t* in, std::uint8_t* out, size_t bitsPerSymbol, bool msbFirst, size_t numGroups)
+{
+    const std::uint64_t symbolMask = (1ULL << bitsPerSymbol) - 1;
+
+    for(size_t group = 0; group < numGroups; ++group)
+    {
+        std::uint64_t word = 0;
+        for(size_t byte = 0; byte < bitsPerSymbol; ++byte)
+        {
+            word |= (std::uint64_t(in[byte]) << byteShift(bitsPerSymbol, msbFirst, byte));
+        }
+        for(size_t symbol = 0; symbol < SymbolsPerGroup; ++symbol)
+        {
+            out[symbol] = std::uint8_t((word >> symbolShift(bitsPerSymbol, msbFirst, symbol)) & symbolMask);
+        }
+
+        in += bitsPerSymbol;
+        out += SymbolsPerGroup;
+    }
+}
+
+static inline void packBitsScalar(const std::uint8_t* in, std::uint8_t* out, size_t bitsPerSymbol, bool msbFirst, size_t numGroups)
+{
+    const std::uint64_t symbolMask = (1ULL << bitsPerSymbol) - 1;
+
+    for(size_t group = 0; group < numGroups; ++group)
+    {
+        std::uint64_t word = 0;
+        for(size_t symbol = 0; symbol < SymbolsPerGroup; ++symbol)
+        {
+            word |= ((in[symbol] & symbolMask) << symbolShift(bitsPerSymbol, msbFirst, symbol));
+        }
+        for(size_t byte = 0; byte < bitsPerSymbol; ++byte)
+        {
+            out[byte] = std::uint8_t(word >> byteShift(bitsPerSymbol, msbFirst, byte));
+        }
+
+        in += SymbolsPerGroup;
+        out += bitsPerSymbol;
+    }
+}
+
+//
+// Threshold
+//
+
+template <typename T>
+static size_t thresholdFindScalar(const T* in, const T& threshold, bool above, size_t num)
+{
+    for(size_t elem = 0; elem < num; ++elem)
+    {
+        if(above ? (in[elem] > threshold) : (in[elem] < threshold)) return elem;
+    }
+
+    return num;
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "common/Testing.hpp"
+
+#include <Pothos/Framework.hpp>
+#include <Pothos/Testing.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+//
+// Utility
+//
+
+static constexpr size_t NumGroups = 1000;
+
+// Reference implementation that unpacks one bit at a time
+static std::vector<std::uint8_t> unpackBitsSerial(
+    const std::vector<std::uint8_t>& packed,
+    size_t bitsPerSymbol,
+    bool msbFirst)
+{
+    std::vector<std::uint8_t> symbols((packed.size() * 8) / bitsPerSymbol);
+
+    for(size_t symbol = 0; symbol < symbols.size(); ++symbol)
+    {
+        std::uint8_t value = 0;
+        for(size_t bit = 0; bit < bitsPerSymbol; ++bit)
+        {
+            const auto streamBit = (symbol * bitsPerSymbol) + bit;
+            const auto byte = packed[streamBit / 8];
+
+            if(msbFirst)
+            {
+                value = std::uint8_t((value << 1) | ((byte >> (7 - (streamBit % 8))) & 1));
+            }
+            else value |= std::uint8_t(((byte >> (streamBit % 8)) & 1) << bit);
+        }
+
+        symbols[symbol] = value;
+    }
+
+    return symbols;
+}
+
+//
+// Test implementation
+//
+
+static void testBitPacking(size_t bitsPerSymbol, const std::string& bitOrder)
+{
+    std::cout << "Testing " << bitsPerSymbol << " bits per symbol (" << bitOrder << " first)..." << std::endl;
+
+    std::mt19937 rng(bitsPerSymbol);
+    std::uniform_int_distribution<unsigned> dist(0, 255);
+
+    std::vector<std::uint8_t> packed(NumGroups * bitsPerSymbol);
+    for(auto& byte: packed) byte = std::uint8_t(dist(rng));
+
+    const auto symbols = unpackBitsSerial(packed, bitsPerSymbol, ("MSB" == bitOrder));
+    POTHOS_TEST_EQUAL(NumGroups * 8, symbols.size());
+
+    // Use a length that leaves a partial group to test padding.
+    const std::vector<std::uint8_t> packetBytes(packed.begin(), packed.begin() + 11);
+    const auto packetSymbols = unpackBitsSerial(packetBytes, bitsPerSymbol, ("MSB" == bitOrder));
+
+    Pothos::Packet packet;
+    packet.payload = BlocksTests::stdVectorToBufferChunk(packetBytes);
+
+    // Labels on packed bytes land on the symbol with the byte's first bit.
+    static constexpr size_t PackedLabelIndex = 3;
+
+    auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+    feederSource.call("feedBuffer", BlocksTests::stdVectorToBufferChunk(packed));
+    feederSource.call("feedLabel", Pothos::Label("lbl", 0, PackedLabelIndex));
+    feederSource.call("feedPacket", packet);
+
+    auto unpackBits = Pothos::BlockRegistry::make("/blocks/unpack_bits", bitsPerSymbol, bitOrder);
+    POTHOS_TEST_EQUAL(bitsPerSymbol, unpackBits.call<size_t>("bitsPerSymbol"));
+    POTHOS_TEST_EQUAL(bitOrder, unpackBits.call<std::string>("bitOrder"));
+
+    auto packBits = Pothos::BlockRegistry::make("/blocks/pack_bits", bitsPerSymbol, bitOrder);
+    POTHOS_TEST_EQUAL(bitsPerSymbol, packBits.call<size_t>("bitsPerSymbol"));
+    POTHOS_TEST_EQUAL(bitOrder, packBits.call<std::string>("bitOrder"));
+
+    auto unpackedCollectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+    auto packedCollectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+
+    {
+        Pothos::Topology topology;
+
+        topology.connect(feederSource, 0, unpackBits, 0);
+        topology.connect(unpackBits, 0, unpackedCollectorSink, 0);
+        topology.connect(unpackBits, 0, packBits, 0);
+        topology.connect(packBits, 0, packedCollectorSink, 0);
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    BlocksTests::testBufferChunksEqual<std::uint8_t>(
+        BlocksTests::stdVectorToBufferChunk(symbols),
+        unpackedCollectorSink.call("getBuffer"));
+    BlocksTests::testBufferChunksEqual<std::uint8_t>(
+        BlocksTests::stdVectorToBufferChunk(packed),
+        packedCollectorSink.call("getBuffer"));
+
+    const auto unpackedLabels = unpackedCollectorSink.call<std::vector<Pothos::Label>>("getLabels");
+    POTHOS_TEST_EQUAL(1, unpackedLabels.size());
+    POTHOS_TEST_EQUAL((PackedLabelIndex * 8) / bitsPerSymbol, unpackedLabels[0].index);
+
+    const auto packedLabels = packedCollectorSink.call<std::vector<Pothos::Label>>("getLabels");
+    POTHOS_TEST_EQUAL(1, packedLabels.size());
+    POTHOS_TEST_EQUAL(
+        ((((PackedLabelIndex * 8) / bitsPerSymbol) * bitsPerSymbol) / 8),
+        packedLabels[0].index);
+
+    const auto unpackedPackets = unpackedCollectorSink.call<std::vector<Pothos::Packet>>("getPackets");
+    POTHOS_TEST_EQUAL(1, unpackedPackets.size());
+    BlocksTests::testBufferChunksEqual<std::uint8_t>(
+        BlocksTests::stdVectorToBufferChunk(packetSymbols),
+        unpackedPackets[0].payload);
+
+    // Bits dropped from the partial symbol at the end of the unpacked
+    // packet come back as zero padding.
+    const auto packedPackets = packedCollectorSink.call<std::vector<Pothos::Packet>>("getPackets");
+    POTHOS_TEST_EQUAL(1, packedPackets.size());
+
+    const auto packetBits = packetSymbols.size() * bitsPerSymbol;
+    POTHOS_TEST_EQUAL((packetBits + 7) / 8, packedPackets[0].payload.elements());
+    POTHOS_TEST_EQUALA(
+        packetBytes.data(),
+        packedPackets[0].payload.as<const std::uint8_t*>(),
+        (packetBits / 8));
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_bit_packing)
+{
+    for(size_t bitsPerSymbol = 1; bitsPerSymbol <= 8; ++bitsPerSymbol)
+    {
+        testBitPacking(bitsPerSymbol, "MSB");
+        testBitPacking(bitsPerSymbol, "LSB");
+    }
+}
@@ -0,0 +1,208 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "common/Testing.hpp"
+
+#include <Pothos/Framework.hpp>
+#include <Pothos/Testing.hpp>
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+//
+// Utility
+//
+
+static constexpr size_t NumRepetitions = 100;
+
+template <typename T>
+static std::vector<T> getTestInputs()
+{
+    static const std::vector<T> inputs =
+    {
+        T(0), T(1), T(-1), T(12), T(-34), T(56), T(-78), T(90), T(100), T(-100)
+    };
+
+    return BlocksTests::stretchStdVector(inputs, NumRepetitions);
+}
+
+template <typename T>
+static T byteswapComponent(const T& value)
+{
+    T ret;
+    const auto* valueBytes = reinterpret_cast<const std::uint8_t*>(&value);
+    std::reverse_copy(valueBytes, valueBytes + sizeof(T), reinterpret_cast<std::uint8_t*>(&ret));
+
+    return ret;
+}
+
+template <typename T>
+static T byteswapValue(const T& value)
+{
+    return byteswapComponent(value);
+}
+
+template <typename T>
+static std::complex<T> byteswapValue(const std::complex<T>& value)
+{
+    return {byteswapComponent(value.real()), byteswapComponent(value.imag())};
+}
+
+template <typename T>
+static std::vector<std::complex<T>> toComplex(const std::vector<T>& inputs)
+{
+    std::vector<std::complex<T>> outputs;
+    for(const auto& input: inputs) outputs.emplace_back(input, T(0) - input);
+
+    return outputs;
+}
+
+//
+// Test implementation
+//
+
+template <typename T>
+static void testByteSwap(const std::vector<T>& inputs)
+{
+    const Pothos::DType dtype(typeid(T));
+    std::cout << "Testing " << dtype.name() << "..." << std::endl;
+
+    std::vector<T> expectedOutputs;
+    std::transform(
+        inputs.begin(),
+        inputs.end(),
+        std::back_inserter(expectedOutputs),
+        [](const T& value){return byteswapValue(value);});
+
+    const auto inputBuffer = BlocksTests::stdVectorToBufferChunk(inputs);
+
+    Pothos::Packet inputPacket;
+    inputPacket.payload = BlocksTests::stdVectorToBufferChunk(inputs);
+
+    auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    feederSource.call("feedBuffer", inputBuffer);
+    feederSource.call("feedPacket", inputPacket);
+
+    auto byteswap = Pothos::BlockRegistry::make("/blocks/byteswap", dtype);
+
+    auto swapBackByteswap = Pothos::BlockRegistry::make("/blocks/byteswap", dtype);
+    auto swapBackCollectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+    auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+    {
+        Pothos::Topology topology;
+
+        topology.connect(feederSource, 0, byteswap, 0);
+        topology.connect(byteswap, 0, collectorSink, 0);
+
+        // Swapping twice should give back the original values.
+        topology.connect(byteswap, 0, swapBackByteswap, 0);
+        topology.connect(swapBackByteswap, 0, swapBackCollectorSink, 0);
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    BlocksTests::testBufferChunksEqual<T>(
+        BlocksTests::stdVectorToBufferChunk(expectedOutputs),
+        collectorSink.call("getBuffer"));
+    BlocksTests::testBufferChunksEqual<T>(
+        inputBuffer,
+        swapBackCollectorSink.call("getBuffer"));
+
+    const auto packets = collectorSink.call<std::vector<Pothos::Packet>>("getPackets");
+    POTHOS_TEST_EQUAL(1, packets.size());
+    BlocksTests::testBufferChunksEqual<T>(
+        BlocksTests::stdVectorToBufferChunk(expectedOutputs),
+        packets[0].payload);
+
+    const auto swapBackPackets = swapBackCollectorSink.call<std::vector<Pothos::Packet>>("getPackets");
+    POTHOS_TEST_EQUAL(1, swapBackPackets.size());
+    BlocksTests::testBufferChunksEqual<T>(
+        inputBuffer,
+        swapBackPackets[0].payload);
+}
+
+// A packet payload with no other references should be swapped in-place.
+template <typename T>
+static void testByteSwapPacketInPlace(const std::vector<T>& inputs)
+{
+    const Pothos::DType dtype(typeid(T));
+
+    // The collector sink copies the payloads it receives, so the payload's
+    // own storage hands back its final contents when it is released. They
+    // are only swapped if the block swapped the packet in place.
+    auto finalValues = std::make_shared<std::vector<T>>();
+    std::shared_ptr<std::vector<T>> storage(
+        new std::vector<T>(inputs),
+        [finalValues](std::vector<T>* values)
+        {
+            *finalValues = std::move(*values);
+            delete values;
+        });
+
+    Pothos::Packet inputPacket;
+    inputPacket.payload = Pothos::BufferChunk(Pothos::SharedBuffer(
+        size_t(storage->data()),
+        storage->size() * sizeof(T),
+        storage));
+    inputPacket.payload.dtype = dtype;
+    storage.reset();
+
+    auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    feederSource.call("feedPacket", inputPacket);
+    inputPacket = Pothos::Packet();
+
+    auto byteswap = Pothos::BlockRegistry::make("/blocks/byteswap", dtype);
+    auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+    {
+        Pothos::Topology topology;
+        topology.connect(feederSource, 0, byteswap, 0);
+        topology.connect(byteswap, 0, collectorSink, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    const auto packets = collectorSink.call<std::vector<Pothos::Packet>>("getPackets");
+    POTHOS_TEST_EQUAL(1, packets.size());
+    POTHOS_TEST_EQUAL(inputs.size(), packets[0].payload.elements());
+    for(size_t elem = 0; elem < inputs.size(); ++elem)
+    {
+        POTHOS_TEST_EQUAL(byteswapValue(inputs[elem]), packets[0].payload.template as<const T*>()[elem]);
+    }
+
+    POTHOS_TEST_EQUAL(inputs.size(), finalValues->size());
+    for(size_t elem = 0; elem < inputs.size(); ++elem)
+    {
+        POTHOS_TEST_EQUAL(byteswapValue(inputs[elem]), (*finalValues)[elem]);
+    }
+}
+
+template <typename T>
+static void testByteSwap()
+{
+    const auto inputs = getTestInputs<T>();
+
+    testByteSwap<T>(inputs);
+    testByteSwap<std::complex<T>>(toComplex(inputs));
+    testByteSwapPacketInPlace<T>(inputs);
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_byteswap)
+{
+    testByteSwap<std::int16_t>();
+    testByteSwap<std::int32_t>();
+    testByteSwap<std::int64_t>();
+    testByteSwap<std::uint16_t>();
+    testByteSwap<std::uint32_t>();
+    testByteSwap<std::uint64_t>();
+    testByteSwap<float>();
+    testByteSwap<double>();
+}
@@ -6,8 +6,10 @@
 #include <Pothos/Framework.hpp>
 #include <Pothos/Testing.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -39,10 +41,12 @@ static void testClamp(
     bool clampMin,
     bool clampMax,
     const std::vector<T>& inputs,
-    const std::vector<T>& expectedOutputs)
+    const std::vector<T>& expectedOutputs,
+    const std::string& simdArch)
 {
     std::cout << " * clampMin: " << clampMin
-              << ", clampMax: " << clampMax << "..."
+              << ", clampMax: " << clampMax
+              << ", SIMD arch: " << simdArch << "..."
               << std::endl;
 
     static const Pothos::DType dtype(typeid(T));
@@ -58,11 +62,13 @@ static void testClamp(
     clamp.call("setMinAndMax", min, max);
     clamp.call("setClampMin", clampMin);
     clamp.call("setClampMax", clampMax);
+    clamp.call("setSIMDArch", simdArch);
 
     POTHOS_TEST_EQUAL(min, clamp.call<T>("min"));
     POTHOS_TEST_EQUAL(max, clamp.call<T>("max"));
     POTHOS_TEST_EQUAL(clampMin, clamp.call<bool>("clampMin"));
     POTHOS_TEST_EQUAL(clampMax, clamp.call<bool>("clampMax"));
+    POTHOS_TEST_EQUAL(simdArch, clamp.call<std::string>("simdArch"));
 
     auto collectorSink = Pothos::BlockRegistry::make(
                              "/blocks/collector_sink",
@@ -150,10 +156,68 @@ static void testClamp()
         },
         numRepetitions);
 
-    testClamp(min, max, false, false, inputs, inputs);
-    testClamp(min, max, true, false, inputs, expectedOutputMinClamped);
-    testClamp(min, max, false, true, inputs, expectedOutputMaxClamped);
-    testClamp(min, max, true, true, inputs, expectedOutputBothClamped);
+    // Every implementation available on this machine should give the same results.
+    auto clamp = Pothos::BlockRegistry::make("/blocks/clamp", dtype);
+    const auto simdArchs = clamp.call<std::vector<std::string>>("simdArchs");
+    POTHOS_TEST_TRUE(!simdArchs.empty());
+
+    for(const auto& simdArch: simdArchs)
+    {
+        testClamp(min, max, false, false, inputs, inputs, simdArch);
+        testClamp(min, max, true, false, inputs, expectedOutputMinClamped, simdArch);
+        testClamp(min, max, false, true, inputs, expectedOutputMaxClamped, simdArch);
+        testClamp(min, max, true, true, inputs, expectedOutputBothClamped, simdArch);
+    }
+}
+
+// With SIMD alignment enabled, oddly sized input buffers should still
+// result in every element being processed, as long as the total is a
+// multiple of the alignment.
+template <typename T>
+static void testClampSIMDAligned()
+{
+    static const Pothos::DType dtype(typeid(T));
+    std::cout << "Testing " << dtype.name() << " (SIMD aligned)" << std::endl;
+
+    const T min = 30;
+    const T max = 90;
+    static constexpr size_t NumElems = 1024;
+
+    std::vector<T> inputs0, inputs1, expectedOutputs;
+    for(size_t elem = 0; elem < NumElems; ++elem)
+    {
+        const T value = T(elem % 120);
+
+        if(elem < 77) inputs0.emplace_back(value);
+        else          inputs1.emplace_back(value);
+
+        expectedOutputs.emplace_back(std::min(std::max(value, min), max));
+    }
+
+    auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    feederSource.call("feedBuffer", BlocksTests::stdVectorToBufferChunk(inputs0));
+    feederSource.call("feedBuffer", BlocksTests::stdVectorToBufferChunk(inputs1));
+
+    auto clamp = Pothos::BlockRegistry::make("/blocks/clamp", dtype);
+    clamp.call("setMinAndMax", min, max);
+    clamp.call("setSIMDAligned", true);
+    POTHOS_TEST_TRUE(clamp.call<bool>("simdAligned"));
+
+    auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+    {
+        Pothos::Topology topology;
+
+        topology.connect(feederSource, 0, clamp, 0);
+        topology.connect(clamp, 0, collectorSink, 0);
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    compareBufferChunks<T>(
+        BlocksTests::stdVectorToBufferChunk(expectedOutputs),
+        collectorSink.call("getBuffer"));
 }
 
 POTHOS_TEST_BLOCK("/blocks/tests", test_clamp)
@@ -169,3 +233,17 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_clamp)
     testClamp<float>();
     testClamp<double>();
 }
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_clamp_simd_aligned)
+{
+    testClampSIMDAligned<std::int8_t>();
+    testClampSIMDAligned<std::int16_t>();
+    testClampSIMDAligned<std::int32_t>();
+    testClampSIMDAligned<std::int64_t>();
+    testClampSIMDAligned<std::uint8_t>();
+    testClampSIMDAligned<std::uint16_t>();
+    testClampSIMDAligned<std::uint32_t>();
+    testClampSIMDAligned<std::uint64_t>();
+    testClampSIMDAligned<float>();
+    testClampSIMDAligned<double>();
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <Pothos/Testing.hpp>
+
+#include <iostream>
+
+#include <json.hpp>
+
+using json = nlohmann::json;
+
+static void testCopier(
+    size_t nonTemporalThreshold,
+    size_t numHelperThreads,
+    size_t multiThreadThreshold)
+{
+    std::cout << "Testing non-temporal threshold " << nonTemporalThreshold
+              << ", " << numHelperThreads << " helper threads"
+              << ", multi-thread threshold " << multiThreadThreshold << "..." << std::endl;
+
+    auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+    auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+
+    auto copier = Pothos::BlockRegistry::make("/blocks/copier");
+    copier.call("setNonTemporalThreshold", nonTemporalThreshold);
+    copier.call("setNumHelperThreads", numHelperThreads);
+    copier.call("setMultiThreadThreshold", multiThreadThreshold);
+
+    POTHOS_TEST_EQUAL(nonTemporalThreshold, copier.call<size_t>("getNonTemporalThreshold"));
+    POTHOS_TEST_EQUAL(numHelperThreads, copier.call<size_t>("getNumHelperThreads"));
+    POTHOS_TEST_EQUAL(multiThreadThreshold, copier.call<size_t>("getMultiThreadThreshold"));
+
+    json testPlan;
+    testPlan["enableBuffers"] = true;
+    testPlan["enablePackets"] = true;
+    auto expected = feederSource.call("feedTestPlan", testPlan.dump());
+
+    {
+        Pothos::Topology topology;
+
+        topology.connect(feederSource, 0, copier, 0);
+        topology.connect(copier, 0, collectorSink, 0);
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    collectorSink.call("verifyTestPlan", expected);
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_copier)
+{
+    // Defaults
+    testCopier(1 << 20, 0, 4 << 20);
+
+    // Always non-temporal
+    testCopier(0, 0, 4 << 20);
+
+    // Always multi-threaded, with and without non-temporal stores
+    testCopier(1 << 20, 3, 0);
+    testCopier(0, 3, 0);
+}
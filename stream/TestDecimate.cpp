@@ -0,0 +1,113 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "common/Testing.hpp"
+
+#include <Pothos/Framework.hpp>
+#include <Pothos/Testing.hpp>
+
+#include <complex>
+#include <iostream>
+#include <vector>
+
+//
+// Utility
+//
+
+static constexpr size_t BufferLen = 1000;
+
+template <typename T>
+static inline T makeValue(size_t index)
+{
+    return T(index % 100);
+}
+
+template <>
+inline std::complex<float> makeValue<std::complex<float>>(size_t index)
+{
+    return {float(index % 100), -float(index % 100)};
+}
+
+template <>
+inline std::complex<double> makeValue<std::complex<double>>(size_t index)
+{
+    return {double(index % 100), -double(index % 100)};
+}
+
+//
+// Test implementation
+//
+
+template <typename T>
+static void testDecimate(size_t factor)
+{
+    const Pothos::DType dtype(typeid(T));
+    std::cout << "Testing " << dtype.name() << " (factor " << factor << ")..." << std::endl;
+
+    // Split the input across two buffers to test the phase between calls to work().
+    std::vector<T> inputs0, inputs1, expectedOutputs;
+    for(size_t elem = 0; elem < BufferLen; ++elem)
+    {
+        const auto value = makeValue<T>(elem);
+
+        if(elem < (BufferLen / 3)) inputs0.emplace_back(value);
+        else                       inputs1.emplace_back(value);
+
+        if(0 == (elem % factor)) expectedOutputs.emplace_back(value);
+    }
+
+    auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    feederSource.call("feedBuffer", BlocksTests::stdVectorToBufferChunk(inputs0));
+    feederSource.call("feedBuffer", BlocksTests::stdVectorToBufferChunk(inputs1));
+    feederSource.call("feedLabel", Pothos::Label("lbl0", 0, 0));
+    feederSource.call("feedLabel", Pothos::Label("lbl1", 1, (factor * 7) + 1));
+
+    auto decimate = Pothos::BlockRegistry::make("/blocks/decimate", dtype, factor);
+    POTHOS_TEST_EQUAL(factor, decimate.call<size_t>("factor"));
+
+    auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+    {
+        Pothos::Topology topology;
+
+        topology.connect(feederSource, 0, decimate, 0);
+        topology.connect(decimate, 0, collectorSink, 0);
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    BlocksTests::testBufferChunksEqual<T>(
+        BlocksTests::stdVectorToBufferChunk(expectedOutputs),
+        collectorSink.call("getBuffer"));
+
+    // Labels should move to the next kept element.
+    const auto labels = collectorSink.call<std::vector<Pothos::Label>>("getLabels");
+    POTHOS_TEST_EQUAL(2, labels.size());
+    POTHOS_TEST_EQUAL("lbl0", labels[0].id);
+    POTHOS_TEST_EQUAL(0, labels[0].index);
+    POTHOS_TEST_EQUAL("lbl1", labels[1].id);
+    POTHOS_TEST_EQUAL(8, labels[1].index);
+}
+
+template <typename T>
+static void testDecimate()
+{
+    testDecimate<T>(1);
+    testDecimate<T>(2);
+    testDecimate<T>(3);
+    testDecimate<T>(4);
+    testDecimate<T>(7);
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_decimate)
+{
+    testDecimate<std::int8_t>();
+    testDecimate<std::int16_t>();
+    testDecimate<std::int32_t>();
+    testDecimate<std::int64_t>();
+    testDecimate<float>();
+    testDecimate<double>();
+    testDecimate<std::complex<float>>();
+    testDecimate<std::complex<double>>();
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <Pothos/Testing.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+static constexpr size_t NumBuffers = 10;
+static constexpr size_t BufferLen = 100;
+static constexpr size_t NumMessages = 3;
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_flow_profiler)
+{
+    const Pothos::DType dtype("int32");
+
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    auto profiler = Pothos::BlockRegistry::make("/blocks/flow_profiler");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+    for (size_t i = 0; i < NumBuffers; ++i)
+    {
+        Pothos::BufferChunk buffer(dtype, BufferLen);
+        for (size_t elem = 0; elem < BufferLen; ++elem) buffer.as<int*>()[elem] = int(i*BufferLen + elem);
+        feeder.call("feedBuffer", buffer);
+    }
+    for (size_t i = 0; i < NumMessages; ++i) feeder.call("feedMessage", Pothos::Object(std::to_string(i)));
+    feeder.call("feedLabel", Pothos::Label("id", "data", 150));
+
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, profiler, 0);
+        topology.connect(profiler, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    // The profiler must forward everything untouched.
+    const auto output = collector.call<Pothos::BufferChunk>("getBuffer");
+    POTHOS_TEST_EQUAL(NumBuffers*BufferLen, output.elements());
+    for (size_t elem = 0; elem < output.elements(); ++elem) POTHOS_TEST_EQUAL(int(elem), output.as<const int*>()[elem]);
+    POTHOS_TEST_EQUAL(NumMessages, collector.call<std::vector<Pothos::Object>>("getMessages").size());
+
+    const auto labels = collector.call<std::vector<Pothos::Label>>("getLabels");
+    POTHOS_TEST_EQUAL(1, labels.size());
+    POTHOS_TEST_EQUAL(150, labels[0].index);
+
+    POTHOS_TEST_EQUAL(NumBuffers*BufferLen, profiler.call<unsigned long long>("totalElements"));
+    POTHOS_TEST_EQUAL(NumMessages, profiler.call<unsigned long long>("totalMessages"));
+
+    const auto totalBuffers = profiler.call<unsigned long long>("totalBuffers");
+    POTHOS_TEST_TRUE(totalBuffers > 0);
+    POTHOS_TEST_TRUE(totalBuffers <= NumBuffers);
+    POTHOS_TEST_TRUE(profiler.call<double>("bufferSizeP50") >= BufferLen);
+    POTHOS_TEST_TRUE(profiler.call<double>("waitP50") <= profiler.call<double>("waitP99"));
+    POTHOS_TEST_TRUE(profiler.call<double>("waitP99") <= profiler.call<double>("maxWait"));
+
+    for (const std::string fraction: {"outputWaitFraction", "busyFraction"})
+    {
+        const auto value = profiler.call<double>(fraction);
+        std::cout << fraction << ": " << value << std::endl;
+        POTHOS_TEST_TRUE(value >= 0.0);
+        POTHOS_TEST_TRUE(value <= 1.0);
+    }
+
+    profiler.call("reset");
+    POTHOS_TEST_EQUAL(0, profiler.call<unsigned long long>("totalBuffers"));
+}
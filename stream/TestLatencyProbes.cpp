@@ -0,0 +1,131 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <Pothos/Testing.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static constexpr size_t NumElements = 10000;
+static constexpr size_t Interval = 100;
+static constexpr size_t NumPackets = 5;
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_latency_probes)
+{
+    const Pothos::DType dtype("int32");
+
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    auto inserter = Pothos::BlockRegistry::make("/blocks/latency_probe_inserter");
+    auto tap = Pothos::BlockRegistry::make("/blocks/latency_probe_tap");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+    inserter.call("setInterval", Interval);
+    inserter.call("setLabelID", "timestamp");
+    tap.call("setLabelID", "timestamp");
+
+    feeder.call("feedBuffer", Pothos::BufferChunk(dtype, NumElements));
+    for (size_t i = 0; i < NumPackets; ++i)
+    {
+        Pothos::Packet packet;
+        packet.payload = Pothos::BufferChunk(dtype, Interval);
+        feeder.call("feedPacket", packet);
+    }
+
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, inserter, 0);
+        topology.connect(inserter, 0, tap, 0);
+        topology.connect(tap, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    // Every Interval elements gets a timestamp, and so does each packet,
+    // since each packet's payload is one interval long.
+    const auto expectedCount = (NumElements / Interval) + NumPackets;
+    POTHOS_TEST_EQUAL(expectedCount, tap.call<unsigned long long>("count"));
+
+    const auto minLatency = tap.call<double>("minLatency");
+    const auto p50 = tap.call<double>("p50");
+    const auto p99 = tap.call<double>("p99");
+    const auto p999 = tap.call<double>("p999");
+    const auto maxLatency = tap.call<double>("maxLatency");
+    std::cout << "p50: " << p50 << "s, p99: " << p99 << "s, p99.9: " << p999 << "s" << std::endl;
+
+    POTHOS_TEST_TRUE(minLatency >= 0.0);
+    POTHOS_TEST_TRUE(minLatency <= p50);
+    POTHOS_TEST_TRUE(p50 <= p99);
+    POTHOS_TEST_TRUE(p99 <= p999);
+    POTHOS_TEST_TRUE(p999 <= maxLatency);
+
+    // The timestamp labels are forwarded with the stream.
+    const auto labels = collector.call<std::vector<Pothos::Label>>("getLabels");
+    POTHOS_TEST_EQUAL(
+        (NumElements / Interval),
+        size_t(std::count_if(
+            labels.begin(),
+            labels.end(),
+            [](const Pothos::Label& label){return (label.id == "timestamp");})));
+    for (const auto& label: labels) POTHOS_TEST_EQUAL(0, (label.index % Interval));
+
+    tap.call("reset");
+    POTHOS_TEST_EQUAL(0, tap.call<unsigned long long>("count"));
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_latency_probes_packets)
+{
+    const Pothos::DType dtype("int32");
+
+    // Packets get a timestamp when an interval starts within their payload,
+    // whether or not their size divides the interval.
+    struct PacketCase
+    {
+        size_t packetElems;
+        size_t numPackets;
+        size_t expectedCount;
+    };
+    static const std::vector<PacketCase> cases =
+    {
+        {30, 10, 3},  // Intervals start in packets 0, 3, and 6
+        {250, 4, 4},  // Every packet holds the start of an interval
+        {100, 5, 5},
+    };
+
+    for (const auto& packetCase: cases)
+    {
+        std::cout << "Testing " << packetCase.numPackets << " packets of "
+                  << packetCase.packetElems << " elements..." << std::endl;
+
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+        auto inserter = Pothos::BlockRegistry::make("/blocks/latency_probe_inserter");
+        auto tap = Pothos::BlockRegistry::make("/blocks/latency_probe_tap");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+        inserter.call("setInterval", Interval);
+
+        for (size_t i = 0; i < packetCase.numPackets; ++i)
+        {
+            Pothos::Packet packet;
+            packet.payload = Pothos::BufferChunk(dtype, packetCase.packetElems);
+            feeder.call("feedPacket", packet);
+        }
+
+        {
+            Pothos::Topology topology;
+            topology.connect(feeder, 0, inserter, 0);
+            topology.connect(inserter, 0, tap, 0);
+            topology.connect(tap, 0, collector, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+
+        POTHOS_TEST_EQUAL(packetCase.expectedCount, tap.call<unsigned long long>("count"));
+
+        const auto packets = collector.call<std::vector<Pothos::Packet>>("getPackets");
+        POTHOS_TEST_EQUAL(packetCase.numPackets, packets.size());
+        POTHOS_TEST_EQUAL(1, packets[0].metadata.count("latency"));
+    }
+}
@@ -0,0 +1,159 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "common/Testing.hpp"
+
+#include <Pothos/Framework.hpp>
+#include <Pothos/Testing.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//
+// Utility
+//
+
+static constexpr size_t NumRepetitions = 100;
+
+struct Crossing
+{
+    std::string id;
+    unsigned long long index;
+};
+
+// A simple reference implementation of the hysteresis state machine
+template <typename T>
+static std::vector<std::int8_t> getExpectedMask(
+    const std::vector<T>& inputs,
+    T low,
+    T high,
+    std::vector<Crossing>& crossings)
+{
+    std::vector<std::int8_t> mask;
+    bool state = false;
+
+    for(size_t elem = 0; elem < inputs.size(); ++elem)
+    {
+        if(!state && (inputs[elem] > high))
+        {
+            state = true;
+            crossings.push_back({"rise", elem});
+        }
+        else if(state && (inputs[elem] < low))
+        {
+            state = false;
+            crossings.push_back({"fall", elem});
+        }
+
+        mask.emplace_back(state ? 1 : 0);
+    }
+
+    return mask;
+}
+
+//
+// Test implementation
+//
+
+template <typename T>
+static void testThreshold(
+    const std::string& mode,
+    T low,
+    T high)
+{
+    const Pothos::DType dtype(typeid(T));
+    std::cout << "Testing " << dtype.name() << " (" << mode << ", "
+              << +low << ", " << +high << ")..." << std::endl;
+
+    // Long stretches without a crossing test the SIMD search.
+    std::vector<T> inputs;
+    for(size_t rep = 0; rep < NumRepetitions; ++rep)
+    {
+        const T value = T(rep % 20);
+        inputs.insert(inputs.end(), (rep % 7) + 1, value);
+    }
+
+    std::vector<Crossing> expectedCrossings;
+    const auto expectedMask = getExpectedMask(inputs, low, high, expectedCrossings);
+
+    // Make sure the test data has crossings both ways.
+    POTHOS_TEST_TRUE(expectedCrossings.size() >= 2);
+
+    auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    feederSource.call("feedBuffer", BlocksTests::stdVectorToBufferChunk(inputs));
+
+    auto threshold = Pothos::BlockRegistry::make("/blocks/threshold", dtype, mode);
+    threshold.call("setThresholds", low, high);
+    POTHOS_TEST_EQUAL(low, threshold.call<T>("lowThreshold"));
+    POTHOS_TEST_EQUAL(high, threshold.call<T>("highThreshold"));
+
+    const auto outputDType = ("MASK" == mode) ? Pothos::DType("int8") : dtype;
+    auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", outputDType);
+
+    {
+        Pothos::Topology topology;
+
+        topology.connect(feederSource, 0, threshold, 0);
+        topology.connect(threshold, 0, collectorSink, 0);
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    if("MASK" == mode)
+    {
+        BlocksTests::testBufferChunksEqual<std::int8_t>(
+            BlocksTests::stdVectorToBufferChunk(expectedMask),
+            collectorSink.call("getBuffer"));
+    }
+    else
+    {
+        BlocksTests::testBufferChunksEqual<T>(
+            BlocksTests::stdVectorToBufferChunk(inputs),
+            collectorSink.call("getBuffer"));
+    }
+
+    POTHOS_TEST_EQUAL(
+        expectedCrossings.size(),
+        threshold.call<unsigned long long>("numCrossings"));
+
+    const auto labels = collectorSink.call<std::vector<Pothos::Label>>("getLabels");
+    POTHOS_TEST_EQUAL(expectedCrossings.size(), labels.size());
+    for(size_t i = 0; i < labels.size(); ++i)
+    {
+        POTHOS_TEST_EQUAL(expectedCrossings[i].id, labels[i].id);
+        POTHOS_TEST_EQUAL(expectedCrossings[i].index, labels[i].index);
+        POTHOS_TEST_EQUAL(
+            expectedCrossings[i].index,
+            labels[i].data.template convert<unsigned long long>());
+    }
+}
+
+template <typename T>
+static void testThreshold()
+{
+    for(const std::string mode: {"MASK", "LABELS"})
+    {
+        // No hysteresis
+        testThreshold<T>(mode, T(10), T(10));
+
+        // Hysteresis
+        testThreshold<T>(mode, T(5), T(15));
+    }
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_threshold)
+{
+    testThreshold<std::int8_t>();
+    testThreshold<std::int16_t>();
+    testThreshold<std::int32_t>();
+    testThreshold<std::int64_t>();
+    testThreshold<std::uint8_t>();
+    testThreshold<std::uint16_t>();
+    testThreshold<std::uint32_t>();
+    testThreshold<std::uint64_t>();
+    testThreshold<float>();
+    testThreshold<double>();
+}
@@ -0,0 +1,324 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+// Generated at build-time
+#ifdef POTHOS_XSIMD
+#include "StreamBlocks_SIMD.hpp"
+#endif
+
+#include "ScalarKernels.hpp"
+#include "common/SIMDDispatch.hpp"
+
+#include <Pothos/Callable.hpp>
+#include <Pothos/Exception.hpp>
+#include <Pothos/Framework.hpp>
+
+#include <Poco/Format.h>
+#include <Poco/NumberFormatter.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//
+// Implementation getters to be called on class construction
+//
+
+template <typename T>
+using ThresholdFindFcn = size_t(*)(const T*, const T&, bool, size_t);
+
+#ifdef POTHOS_XSIMD
+
+template <typename T>
+static inline ThresholdFindFcn<T> getThresholdFindFcn()
+{
+    return PothosBlocksSIMD::thresholdFindDispatch<T>();
+}
+
+#else
+
+template <typename T>
+static inline ThresholdFindFcn<T> getThresholdFindFcn()
+{
+    return &thresholdFindScalar<T>;
+}
+
+#endif
+
+/***********************************************************************
+ * |PothosDoc Threshold
+ *
+ * Compares each input element against a threshold, with optional
+ * hysteresis. The output goes high when an input is above the high
+ * threshold, and goes low when an input is below the low threshold.
+ * With equal thresholds, an input equal to the threshold does not change
+ * the output. The output starts low when the block is activated.
+ *
+ * Each rising crossing is marked with a "rise" label, and each falling
+ * crossing with a "fall" label. The data of each label is the element's
+ * index since the block was activated.
+ *
+ * Buffers with no crossing are handled with one vectorized comparison
+ * pass that stops at the first crossing.
+ *
+ * |category /Stream
+ * |keywords threshold compare comparator hysteresis schmitt trigger crossing edge
+ *
+ * |param dtype[Data Type] The input data type.
+ * |widget DTypeChooser(int=1,uint=1,float=1)
+ * |default "float64"
+ * |preview disable
+ *
+ * |param mode[Mode] What the block outputs.
+ * <ul>
+ * <li><b>Mask:</b> An int8 stream with a 1 for each high element and a 0 for each low element.</li>
+ * <li><b>Labels:</b> The input buffers, forwarded without copying.</li>
+ * </ul>
+ * The crossing labels are posted in either mode.
+ * |widget ComboBox(editable=false)
+ * |option [Mask] "MASK"
+ * |option [Labels] "LABELS"
+ * |default "MASK"
+ * |preview enable
+ *
+ * |param lowThreshold[Low Threshold] The output goes low when an input is below this value.
+ * |widget LineEdit()
+ * |default 0
+ * |preview enable
+ *
+ * |param highThreshold[High Threshold] The output goes high when an input is above this value.
+ * |widget LineEdit()
+ * |default 0
+ * |preview enable
+ *
+ * |factory /blocks/threshold(dtype,mode)
+ * |setter setThresholds(lowThreshold,highThreshold)
+ **********************************************************************/
+
+template <typename T>
+class Threshold: public Pothos::Block
+{
+public:
+    using Class = Threshold<T>;
+
+    Threshold(bool maskMode):
+        Pothos::Block(),
+        _maskMode(maskMode),
+        _low(0),
+        _high(0),
+        _state(false),
+        _numCrossings(0),
+        _startIndex(0),
+        _fcn("thresholdFind", getThresholdFindFcn<T>(), &thresholdFindScalar<T>)
+    {
+        const Pothos::DType dtype(typeid(T));
+
+        this->setupInput(0, dtype);
+
+        // Unique domain due to buffer forwarding
+        if(_maskMode) this->setupOutput(0, "int8");
+        else          this->setupOutput(0, dtype, this->uid());
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, lowThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setLowThreshold));
+        this->registerProbe("lowThreshold");
+        this->registerSignal("lowThresholdChanged");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, highThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setHighThreshold));
+        this->registerProbe("highThreshold");
+        this->registerSignal("highThresholdChanged");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setThresholds));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setThreshold));
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, numCrossings));
+        this->registerProbe("numCrossings");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArchs));
+        this->registerProbe("simdArch");
+    }
+
+    T lowThreshold() const
+    {
+        return _low;
+    }
+
+    void setLowThreshold(const T& low)
+    {
+        validateThresholds(low, _high);
+
+        _low = low;
+        this->emitSignal("lowThresholdChanged", _low);
+    }
+
+    T highThreshold() const
+    {
+        return _high;
+    }
+
+    void setHighThreshold(const T& high)
+    {
+        validateThresholds(_low, high);
+
+        _high = high;
+        this->emitSignal("highThresholdChanged", _high);
+    }
+
+    // Set both at once to avoid an error when not in the GUI.
+    void setThresholds(const T& low, const T& high)
+    {
+        validateThresholds(low, high);
+
+        _low = low;
+        _high = high;
+
+        this->emitSignal("lowThresholdChanged", _low);
+        this->emitSignal("highThresholdChanged", _high);
+    }
+
+    // A single threshold, with no hysteresis
+    void setThreshold(const T& threshold)
+    {
+        this->setThresholds(threshold, threshold);
+    }
+
+    unsigned long long numCrossings() const
+    {
+        return _numCrossings;
+    }
+
+    std::string simdArch() const
+    {
+        return _fcn.arch();
+    }
+
+    void setSIMDArch(const std::string& arch)
+    {
+        _fcn.setArch(arch);
+    }
+
+    std::vector<std::string> simdArchs() const
+    {
+        return _fcn.archs();
+    }
+
+    void activate() override
+    {
+        _state = false;
+        _numCrossings = 0;
+        _startIndex = this->input(0)->totalElements();
+    }
+
+    void work() override
+    {
+        auto input = this->input(0);
+        auto output = this->output(0);
+
+        const auto elems = _maskMode ? this->workInfo().minElements : input->elements();
+        if(0 == elems) return;
+
+        const T* buffIn = input->buffer();
+        const auto index = input->totalElements() - _startIndex;
+
+        // Search for each crossing in turn. Only the comparison against the
+        // threshold that would change the state is needed.
+        for(size_t elem = 0; elem < elems;)
+        {
+            const auto next = elem + _fcn(
+                                         buffIn + elem,
+                                         (_state ? _low : _high),
+                                         !_state,
+                                         (elems - elem));
+
+            if(_maskMode)
+            {
+                std::int8_t* buffOut = output->buffer();
+                std::memset(buffOut + elem, (_state ? 1 : 0), (next - elem));
+            }
+            if(next == elems) break;
+
+            _state = !_state;
+            ++_numCrossings;
+
+            output->postLabel(
+                (_state ? "rise" : "fall"),
+                (index + next),
+                next);
+
+            elem = next;
+        }
+
+        if(_maskMode)
+        {
+            input->consume(elems);
+            output->produce(elems);
+        }
+        else
+        {
+            auto buffer = input->takeBuffer();
+            input->consume(elems);
+            output->postBuffer(std::move(buffer));
+        }
+    }
+
+private:
+    bool _maskMode;
+
+    T _low;
+    T _high;
+
+    bool _state;
+    unsigned long long _numCrossings;
+    unsigned long long _startIndex;
+
+    BlocksSIMD::SIMDFunction<ThresholdFindFcn<T>> _fcn;
+
+    static void validateThresholds(const T& low, const T& high)
+    {
+        if(low > high)
+        {
+            throw Pothos::InvalidArgumentException(
+                      "Low threshold > high threshold",
+                      Poco::format(
+                          "Low: %s, high: %s",
+                          Poco::NumberFormatter::format(low),
+                          Poco::NumberFormatter::format(high)));
+        }
+    }
+};
+
+static Pothos::Block* makeThreshold(const Pothos::DType& dtype, const std::string& mode)
+{
+    bool maskMode = false;
+    if("MASK" == mode)        maskMode = true;
+    else if("LABELS" != mode) throw Pothos::InvalidArgumentException("Invalid mode", mode);
+
+    #define ifTypeDeclareThreshold(T) \
+        if(dtype == Pothos::DType(typeid(T))) \
+        { \
+            return new Threshold<T>(maskMode); \
+        }
+
+    ifTypeDeclareThreshold(std::int8_t)
+    ifTypeDeclareThreshold(std::int16_t)
+    ifTypeDeclareThreshold(std::int32_t)
+    ifTypeDeclareThreshold(std::int64_t)
+    ifTypeDeclareThreshold(std::uint8_t)
+    ifTypeDeclareThreshold(std::uint16_t)
+    ifTypeDeclareThreshold(std::uint32_t)
+    ifTypeDeclareThreshold(std::uint64_t)
+    ifTypeDeclareThreshold(float)
+    ifTypeDeclareThreshold(double)
+
+    throw Pothos::InvalidArgumentException(
+              "Invalid or unsupported type",
+              dtype.name());
+}
+
+static Pothos::BlockRegistry registerThreshold(
+    "/blocks/threshold",
+    Pothos::Callable(&makeThreshold));
@@ -2,27 +2,136 @@
 //                    2020 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
+#include "StreamingTestPlan.hpp"
+#include "common/CRC32C.hpp"
+
 #include <Pothos/Framework.hpp>
 #include <Poco/Format.h>
 #include <Poco/Types.h>
+#include <cstdint>
 #include <cstring> //memcpy
+#include <deque>
+#include <memory>
 #include <vector>
 #include <algorithm> //min/max
 #include <json.hpp>
 
 using json = nlohmann::json;
 
+/***********************************************************************
+ * Running digest of one kind of input: a count and a CRC-32C
+ **********************************************************************/
+struct CollectorDigest
+{
+    CollectorDigest(void):
+        count(0),
+        crc(0)
+    {}
+
+    void update(const void *data, const size_t len)
+    {
+        crc = BlocksCRC::crc32c(crc, data, len);
+    }
+
+    void update(const std::uint64_t value)
+    {
+        this->update(&value, sizeof(value));
+    }
+
+    //length prefixed so that adjacent strings cannot alias
+    void update(const std::string &value)
+    {
+        this->update(std::uint64_t(value.size()));
+        this->update(value.data(), value.size());
+    }
+
+    json toJSON(void) const
+    {
+        json digest(json::object());
+        digest["count"] = count;
+        digest["crc32c"] = crc;
+        return digest;
+    }
+
+    unsigned long long count;
+    std::uint32_t crc;
+};
+
+/***********************************************************************
+ * Checks input against a streaming test plan as it arrives, by generating
+ * the plan again from its descriptor. The first mismatch is kept for
+ * finish() to report, since work() cannot throw it to the caller.
+ **********************************************************************/
+class StreamingTestPlanVerifier
+{
+public:
+    StreamingTestPlanVerifier(const json &plan, const Pothos::DType &dtype):
+        _plan(plan),
+        _expectedLeft(0),
+        _elements(0),
+        _labelsChecked(0),
+        _messagesChecked(0),
+        _packetsChecked(0)
+    {
+        if (not (dtype == _plan.dtype())) _error = Poco::format("Buffer type mismatch: expected %s -> actual %s",
+            _plan.dtype().toString(), dtype.toString());
+    }
+
+    void checkValues(const Pothos::BufferChunk &buffer);
+    void checkLabel(const Pothos::Label &label);
+    void checkMessage(const Pothos::Object &msg);
+    void checkPacket(const Pothos::Packet &packet);
+
+    //throws the first mismatch, or if any of the plan is missing
+    void finish(void);
+
+private:
+    std::string checkBytes(const char *expected, const char *actual, const size_t length, const unsigned long long firstElem) const;
+    static std::string checkLabelEquals(const Pothos::Label &expected, const Pothos::Label &actual, const size_t i);
+
+    StreamingTestPlan _plan;
+    std::string _error;
+
+    std::vector<char> _expected; //scratch for the regenerated values
+    size_t _expectedLeft; //elements of the expected buffer not checked yet
+    unsigned long long _elements;
+
+    std::deque<Pothos::Label> _expectedLabels;
+    unsigned long long _labelsChecked;
+    unsigned long long _messagesChecked;
+    unsigned long long _packetsChecked;
+};
+
+/***********************************************************************
+ * The collector sink stores everything it receives for later checks.
+ *
+ * Storage modes:
+ *  - BUFFER: append stream data into one contiguous buffer (default)
+ *  - CHUNKS: copy each input buffer into its own chunk, and only
+ *    concatenate them when getBuffer() is called
+ *  - DIGEST: keep only counts and CRC-32C digests of the stream, labels,
+ *    messages, and packets, so memory use is constant for long soak tests
+ *
+ * Calling expectTestPlan() with a streaming test plan checks the input
+ * against the plan as it arrives instead, and stores nothing, in any mode.
+ **********************************************************************/
 class CollectorSink : Pothos::Block
 {
 public:
-    CollectorSink(const Pothos::DType &dtype)
+    CollectorSink(const Pothos::DType &dtype):
+        _mode("BUFFER"),
+        _planStart(0)
     {
         this->setupInput(0, dtype);
+        this->registerCall(this, POTHOS_FCN_TUPLE(CollectorSink, setMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(CollectorSink, getMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(CollectorSink, getDigest));
         this->registerCall(this, POTHOS_FCN_TUPLE(CollectorSink, getBuffer));
         this->registerCall(this, POTHOS_FCN_TUPLE(CollectorSink, getLabels));
         this->registerCall(this, POTHOS_FCN_TUPLE(CollectorSink, getMessages));
         this->registerCall(this, POTHOS_FCN_TUPLE(CollectorSink, getPackets));
         this->registerCall(this, POTHOS_FCN_TUPLE(CollectorSink, verifyTestPlan));
+        this->registerCall(this, POTHOS_FCN_TUPLE(CollectorSink, expectTestPlan));
         this->registerCall(this, POTHOS_FCN_TUPLE(CollectorSink, clear));
     }
 
@@ -31,9 +140,48 @@ public:
         return new CollectorSink(dtype);
     }
 
+    void setMode(const std::string &mode)
+    {
+        if (mode == "BUFFER"){}
+        else if (mode == "CHUNKS"){}
+        else if (mode == "DIGEST"){}
+        else throw Pothos::InvalidArgumentException("CollectorSink::setMode("+mode+")", "unknown mode");
+        this->clear();
+        _mode = mode;
+    }
+
+    std::string getMode(void) const
+    {
+        return _mode;
+    }
+
     Pothos::BufferChunk getBuffer(void) const
     {
-        return _buffer;
+        if (_mode != "CHUNKS") return _buffer;
+
+        size_t length = 0;
+        for (const auto &chunk : _chunks) length += chunk.length;
+        if (length == 0) return Pothos::BufferChunk();
+
+        Pothos::BufferChunk buffer(this->input(0)->dtype(), length/this->input(0)->dtype().size());
+        size_t offset = 0;
+        for (const auto &chunk : _chunks)
+        {
+            std::memcpy(buffer.as<char *>()+offset, chunk.as<const void *>(), chunk.length);
+            offset += chunk.length;
+        }
+        return buffer;
+    }
+
+    //JSON object with a count and CRC-32C for values, labels, messages, and packets
+    std::string getDigest(void) const
+    {
+        json digest(json::object());
+        digest["values"] = _valuesDigest.toJSON();
+        digest["labels"] = _labelsDigest.toJSON();
+        digest["messages"] = _messagesDigest.toJSON();
+        digest["packets"] = _packetsDigest.toJSON();
+        return digest.dump();
     }
 
     std::vector<Pothos::Label> getLabels(void) const
@@ -52,18 +200,38 @@ public:
     }
 
     void verifyTestPlan(const std::string &expected);
+    void expectTestPlan(const std::string &expected);
+    void verifyStreamingTestPlan(const json &plan);
     static void verifyTestPlanExpectedValues(const json &expected, const Pothos::BufferChunk &buffer, const Pothos::DType &expectedDType);
     static void verifyTestPlanExpectedLabels(const json &expected, const std::vector<Pothos::Label> &labels);
     static void verifyTestPlanExpectedMessages(const json &expected, const std::vector<Pothos::Object> &messages);
     static void verifyTestPlanExpectedPackets(const json &expected, const std::vector<Pothos::Packet> &packets, const Pothos::DType &expectedDType);
+    void verifyTestPlanDigests(const json &expected) const;
 
     void work(void)
     {
         auto inputPort = this->input(0);
 
+        if (_verifier) return this->workStreamingTestPlan();
+
+        const bool digestMode = (_mode == "DIGEST");
+
         //accumulate the buffer into a bigger buffer
         const auto &buffer = inputPort->buffer();
-        if (buffer.length != 0) _buffer.append(buffer);
+        if (buffer.length == 0) {}
+        else if (digestMode)
+        {
+            _valuesDigest.update(buffer.as<const void *>(), buffer.length);
+            _valuesDigest.count += buffer.elements();
+        }
+        else if (_mode == "CHUNKS")
+        {
+            //copy so we don't hold upstream resources
+            Pothos::BufferChunk chunk(buffer.dtype, buffer.elements());
+            std::memcpy(chunk.as<void *>(), buffer.as<const void *>(), buffer.length);
+            _chunks.push_back(std::move(chunk));
+        }
+        else _buffer.append(buffer);
 
         //consume buffer
         inputPort->consume(inputPort->elements());
@@ -74,14 +242,24 @@ public:
             auto label = *inputPort->labels().begin();
             inputPort->removeLabel(label);
             label.index += inputPort->totalElements(); //rel -> abs
-            _labels.push_back(std::move(label));
+            if (digestMode) updateLabelDigest(_labelsDigest, label);
+            else _labels.push_back(std::move(label));
         }
 
         //store messages
         while (inputPort->hasMessage())
         {
             auto msg = inputPort->popMessage();
-            if (msg.type() == typeid(Pothos::Packet))
+            if (digestMode and msg.type() == typeid(Pothos::Packet))
+            {
+                updatePacketDigest(_packetsDigest, msg.extract<Pothos::Packet>());
+            }
+            else if (digestMode)
+            {
+                _messagesDigest.update(objectString(msg));
+                _messagesDigest.count++;
+            }
+            else if (msg.type() == typeid(Pothos::Packet))
             {
                 auto pkt = msg.extract<Pothos::Packet>();
                 const auto oldBuff = pkt.payload;
@@ -97,16 +275,86 @@ public:
     void clear(void)
     {
         _buffer = Pothos::BufferChunk();
+        _chunks.clear();
         _labels.clear();
         _messages.clear();
         _packets.clear();
+
+        _valuesDigest = CollectorDigest();
+        _labelsDigest = CollectorDigest();
+        _messagesDigest = CollectorDigest();
+        _packetsDigest = CollectorDigest();
+
+        _verifier.reset();
+        _planStart = this->input(0)->totalElements();
     }
 
 private:
+    void workStreamingTestPlan(void)
+    {
+        auto inputPort = this->input(0);
+
+        const auto &buffer = inputPort->buffer();
+        if (buffer.length != 0) _verifier->checkValues(buffer);
+        inputPort->consume(inputPort->elements());
+
+        //label indexes count from the start of the plan
+        while (inputPort->labels().begin() != inputPort->labels().end())
+        {
+            auto label = *inputPort->labels().begin();
+            inputPort->removeLabel(label);
+            label.index += inputPort->totalElements() - _planStart; //rel -> plan relative
+            _verifier->checkLabel(label);
+        }
+
+        while (inputPort->hasMessage())
+        {
+            const auto msg = inputPort->popMessage();
+            if (msg.type() == typeid(Pothos::Packet)) _verifier->checkPacket(msg.extract<Pothos::Packet>());
+            else _verifier->checkMessage(msg);
+        }
+    }
+
+    static std::string objectString(const Pothos::Object &obj)
+    {
+        if (obj.type() == typeid(std::string)) return obj.extract<std::string>();
+        return obj.toString();
+    }
+
+    static void updateLabelDigest(CollectorDigest &digest, const Pothos::Label &label)
+    {
+        digest.update(std::uint64_t(label.index));
+        digest.update(std::uint64_t(label.width));
+        digest.update(label.id);
+        digest.update(objectString(label.data));
+        digest.count++;
+    }
+
+    static void updatePacketDigest(CollectorDigest &digest, const Pothos::Packet &packet)
+    {
+        digest.update(std::uint64_t(packet.payload.length));
+        digest.update(packet.payload.as<const void *>(), packet.payload.length);
+        digest.update(std::uint64_t(packet.labels.size()));
+        CollectorDigest labelsDigest;
+        for (const auto &label : packet.labels) updateLabelDigest(labelsDigest, label);
+        digest.update(std::uint64_t(labelsDigest.crc));
+        digest.count++;
+    }
+
+    std::string _mode;
     Pothos::BufferChunk _buffer;
+    std::vector<Pothos::BufferChunk> _chunks;
     std::vector<Pothos::Label> _labels;
     std::vector<Pothos::Object> _messages;
     std::vector<Pothos::Packet> _packets;
+
+    CollectorDigest _valuesDigest;
+    CollectorDigest _labelsDigest;
+    CollectorDigest _messagesDigest;
+    CollectorDigest _packetsDigest;
+
+    std::unique_ptr<StreamingTestPlanVerifier> _verifier;
+    unsigned long long _planStart; //input elements before the last clear()
 };
 
 static Pothos::BlockRegistry registerCollectorSink(
@@ -120,9 +368,23 @@ void CollectorSink::verifyTestPlan(const std::string &expectedStr)
     const auto expected = json::parse(expectedStr);
     bool checked = false;
 
+    if (expected.count("streamingTestPlan"))
+    {
+        this->verifyStreamingTestPlan(expected["streamingTestPlan"]);
+        this->clear();
+        return;
+    }
+
+    if (_mode == "DIGEST")
+    {
+        this->verifyTestPlanDigests(expected);
+        this->clear();
+        return;
+    }
+
     if (expected.count("expectedValues"))
     {
-        verifyTestPlanExpectedValues(expected, _buffer, this->input(0)->dtype());
+        verifyTestPlanExpectedValues(expected, this->getBuffer(), this->input(0)->dtype());
         checked = true;
     }
 
@@ -273,3 +535,309 @@ void CollectorSink::verifyTestPlanExpectedPackets(const json &expected, const st
     if (packets.size() != expectedPackets.size()) throw Pothos::AssertionViolationException("CollectorSink::verifyTestPlan()",
         Poco::format("Check expected %z packets, actual %z packets", expectedPackets.size(), packets.size()));
 }
+
+/***********************************************************************
+ * Verify test plan helper -- compare digests
+ **********************************************************************/
+static Pothos::BufferChunk expectedValuesToBuffer(const json &expectedValues, const Pothos::DType &dtype)
+{
+    //mirror the element casts used by the feeder source
+    Pothos::BufferChunk buff(dtype, expectedValues.size());
+    for (size_t i = 0; i < expectedValues.size(); i++)
+    {
+        const float value = expectedValues[i];
+        if (dtype.size() == 1) buff.as<char *>()[i] = char(value);
+        else if (dtype.size() == 2) buff.as<short *>()[i] = short(value);
+        else if (dtype.size() == 4)
+        {
+            if (dtype.isFloat()) buff.as<float *>()[i] = value;
+            else buff.as<int *>()[i] = int(value);
+        }
+        else throw Pothos::AssertionViolationException("CollectorSink::verifyTestPlan()", "cant handle this dtype: " + dtype.toString());
+    }
+    return buff;
+}
+
+static std::vector<Pothos::Label> expectedLabelsToLabels(const json &expectedLabels)
+{
+    std::vector<Pothos::Label> labels;
+    for (const auto &expectedLabel : expectedLabels)
+    {
+        const std::string data = expectedLabel["data"];
+        const size_t index = expectedLabel["index"];
+        const std::string id = expectedLabel["id"];
+        labels.emplace_back(id, data, index);
+    }
+    return labels;
+}
+
+static void checkDigest(const std::string &what, const CollectorDigest &expected, const CollectorDigest &actual)
+{
+    if (expected.count != actual.count) throw Pothos::AssertionViolationException("CollectorSink::verifyTestPlan()",
+        Poco::format("Check expected %Lu %s, actual %Lu %s", Poco::UInt64(expected.count), what, Poco::UInt64(actual.count), what));
+    if (expected.crc != actual.crc) throw Pothos::AssertionViolationException("CollectorSink::verifyTestPlan()",
+        Poco::format("Digest check for %s: expected %08x -> actual %08x", what, unsigned(expected.crc), unsigned(actual.crc)));
+}
+
+void CollectorSink::verifyTestPlanDigests(const json &expected) const
+{
+    const auto dtype = this->input(0)->dtype();
+    bool checked = false;
+
+    if (expected.count("expectedValues"))
+    {
+        const auto buff = expectedValuesToBuffer(expected["expectedValues"], dtype);
+        CollectorDigest digest;
+        digest.update(buff.as<const void *>(), buff.length);
+        digest.count = buff.elements();
+        checkDigest("elements", digest, _valuesDigest);
+        checked = true;
+    }
+
+    if (expected.count("expectedLabels"))
+    {
+        CollectorDigest digest;
+        for (const auto &label : expectedLabelsToLabels(expected["expectedLabels"])) updateLabelDigest(digest, label);
+        checkDigest("labels", digest, _labelsDigest);
+        checked = true;
+    }
+
+    if (expected.count("expectedMessages"))
+    {
+        CollectorDigest digest;
+        for (const auto &message : expected["expectedMessages"])
+        {
+            digest.update(message.get<std::string>());
+            digest.count++;
+        }
+        checkDigest("messages", digest, _messagesDigest);
+        checked = true;
+    }
+
+    if (expected.count("expectedPackets"))
+    {
+        CollectorDigest digest;
+        for (const auto &expectedPacket : expected["expectedPackets"])
+        {
+            Pothos::Packet packet;
+            packet.payload = expectedValuesToBuffer(expectedPacket.value("expectedValues", json::array()), dtype);
+            packet.labels = expectedLabelsToLabels(expectedPacket.value("expectedLabels", json::array()));
+            updatePacketDigest(digest, packet);
+        }
+        checkDigest("packets", digest, _packetsDigest);
+        checked = true;
+    }
+
+    if (not checked) throw Pothos::AssertionViolationException("CollectorSink::verifyTestPlan()", "nothing checked!");
+}
+
+/***********************************************************************
+ * Streaming test plans -- check input as it arrives
+ **********************************************************************/
+void CollectorSink::expectTestPlan(const std::string &expectedStr)
+{
+    const auto expected = json::parse(expectedStr);
+    if (not expected.count("streamingTestPlan")) throw Pothos::InvalidArgumentException(
+        "CollectorSink::expectTestPlan()", "only streaming test plans can be checked as they arrive");
+
+    this->clear();
+    _verifier.reset(new StreamingTestPlanVerifier(expected["streamingTestPlan"], this->input(0)->dtype()));
+}
+
+void CollectorSink::verifyStreamingTestPlan(const json &plan)
+{
+    //check what was stored when the plan was not expected up front
+    if (not _verifier)
+    {
+        if (_mode == "DIGEST") throw Pothos::AssertionViolationException("CollectorSink::verifyTestPlan()",
+            "digests cannot be checked against a streaming test plan, use expectTestPlan()");
+
+        _verifier.reset(new StreamingTestPlanVerifier(plan, this->input(0)->dtype()));
+        const auto buffer = this->getBuffer();
+        if (buffer.length != 0) _verifier->checkValues(buffer);
+        for (auto label : _labels)
+        {
+            label.index -= _planStart; //abs -> plan relative
+            _verifier->checkLabel(label);
+        }
+        for (const auto &msg : _messages) _verifier->checkMessage(msg);
+        for (const auto &packet : _packets) _verifier->checkPacket(packet);
+    }
+
+    _verifier->finish();
+}
+
+static std::string elementString(const Pothos::DType &dtype, const char *elem)
+{
+    //mirror the element casts used by the feeder source
+    if (dtype.size() == 1) return std::to_string(int(*reinterpret_cast<const char *>(elem)));
+    if (dtype.size() == 2) return std::to_string(*reinterpret_cast<const short *>(elem));
+    if (dtype.isFloat()) return Poco::format("%f", *reinterpret_cast<const float *>(elem));
+    return std::to_string(*reinterpret_cast<const int *>(elem));
+}
+
+std::string StreamingTestPlanVerifier::checkBytes(const char *expected, const char *actual, const size_t length, const unsigned long long firstElem) const
+{
+    if (std::memcmp(expected, actual, length) == 0) return "";
+
+    const size_t elemSize = _plan.dtype().size();
+    size_t offset = 0;
+    while (std::memcmp(expected+offset, actual+offset, elemSize) == 0) offset += elemSize;
+    return Poco::format("Value check for element %Lu: expected %s -> actual %s",
+        Poco::UInt64(firstElem + offset/elemSize),
+        elementString(_plan.dtype(), expected+offset),
+        elementString(_plan.dtype(), actual+offset));
+}
+
+std::string StreamingTestPlanVerifier::checkLabelEquals(const Pothos::Label &expected, const Pothos::Label &actual, const size_t i)
+{
+    if (actual.data.type() != typeid(std::string)) return "cant handle this label type: " + actual.data.getTypeString();
+    const auto value = expected.data.extract<std::string>();
+    const auto data = actual.data.extract<std::string>();
+    if (actual.width != 1) return Poco::format("Value check for label width %z: expected %d -> actual %z", i, int(1), actual.width);
+    if (actual.index != expected.index) return Poco::format("Value check for label index %z: expected %Lu -> actual %Lu",
+        i, Poco::UInt64(expected.index), Poco::UInt64(actual.index));
+    if (actual.id != expected.id) return Poco::format("Value check for label id %z: expected '%s' -> actual '%s'", i, expected.id, actual.id);
+    if (data != value) return Poco::format("Value check for label data %z: expected '%s' -> actual '%s'", i, value, data);
+    return "";
+}
+
+void StreamingTestPlanVerifier::checkValues(const Pothos::BufferChunk &buffer)
+{
+    const size_t elemSize = _plan.dtype().size();
+    const auto *actual = buffer.as<const char *>();
+    size_t numElems = buffer.length/elemSize;
+
+    while (_error.empty() and numElems != 0)
+    {
+        if (_expectedLeft == 0)
+        {
+            if (_plan.buffers() and _plan.nextBuffer(_expectedLeft)) continue;
+            _error = Poco::format("Check expected %Lu elements, actual more elements", Poco::UInt64(_elements));
+            return;
+        }
+
+        const size_t num = std::min(numElems, _expectedLeft);
+        _expected.resize(num*elemSize);
+        _plan.nextValues(_expected.data(), num);
+        _error = this->checkBytes(_expected.data(), actual, num*elemSize, _elements);
+        _expectedLeft -= num;
+        _elements += num;
+        actual += num*elemSize;
+        numElems -= num;
+    }
+}
+
+void StreamingTestPlanVerifier::checkLabel(const Pothos::Label &label)
+{
+    if (not _error.empty()) return;
+
+    //skip over buffers without labels
+    while (_expectedLabels.empty())
+    {
+        std::vector<Pothos::Label> labels;
+        unsigned long long offset = 0;
+        if (not _plan.buffers() or not _plan.nextLabels(labels, offset))
+        {
+            _error = Poco::format("Check expected %Lu labels, actual more labels", Poco::UInt64(_labelsChecked));
+            return;
+        }
+        for (auto &expected : labels)
+        {
+            expected.index += offset; //buffer -> plan relative
+            _expectedLabels.push_back(std::move(expected));
+        }
+    }
+
+    _error = checkLabelEquals(_expectedLabels.front(), label, _labelsChecked);
+    _expectedLabels.pop_front();
+    _labelsChecked++;
+}
+
+void StreamingTestPlanVerifier::checkMessage(const Pothos::Object &msg)
+{
+    if (not _error.empty()) return;
+
+    std::string value;
+    if (not _plan.nextMessage(value))
+    {
+        _error = Poco::format("Check expected %Lu messages, actual more messages", Poco::UInt64(_messagesChecked));
+        return;
+    }
+    if (msg.type() != typeid(std::string)) _error = "cant handle this message type: " + msg.getTypeString();
+    else if (msg.extract<std::string>() != value) _error = Poco::format("Value check for message %Lu: expected %s -> actual %s",
+        Poco::UInt64(_messagesChecked), value, msg.extract<std::string>());
+    _messagesChecked++;
+}
+
+void StreamingTestPlanVerifier::checkPacket(const Pothos::Packet &packet)
+{
+    if (not _error.empty()) return;
+
+    const size_t elemSize = _plan.dtype().size();
+    size_t numElems = 0;
+    std::vector<Pothos::Label> labels;
+    unsigned long long offset = 0;
+    if (not _plan.packets() or not _plan.nextBuffer(numElems) or not _plan.nextLabels(labels, offset))
+    {
+        _error = Poco::format("Check expected %Lu packets, actual more packets", Poco::UInt64(_packetsChecked));
+        return;
+    }
+
+    std::string error;
+    if (numElems*elemSize != packet.payload.length) error = Poco::format("Check expected %z elements, actual %z elements",
+        numElems, packet.payload.length/elemSize);
+    else
+    {
+        _expected.resize(numElems*elemSize);
+        _plan.nextValues(_expected.data(), numElems);
+        error = this->checkBytes(_expected.data(), packet.payload.as<const char *>(), numElems*elemSize, 0);
+    }
+
+    if (error.empty() and packet.labels.size() != labels.size()) error = Poco::format("Check expected %z labels, actual %z labels",
+        labels.size(), packet.labels.size());
+    for (size_t i = 0; error.empty() and i < labels.size(); i++) error = checkLabelEquals(labels[i], packet.labels[i], i);
+
+    if (not error.empty()) _error = Poco::format("packet%Lu -- %s", Poco::UInt64(_packetsChecked), error);
+    _packetsChecked++;
+}
+
+void StreamingTestPlanVerifier::finish(void)
+{
+    if (not _error.empty()) throw Pothos::AssertionViolationException("CollectorSink::verifyTestPlan()", _error);
+
+    //the rest of the plan is regenerated only to count what is missing
+    std::vector<Pothos::Label> labels;
+    unsigned long long offset = 0;
+    if (_plan.buffers())
+    {
+        unsigned long long expected = _elements + _expectedLeft;
+        size_t numElems = 0;
+        while (_plan.nextBuffer(numElems)) expected += numElems;
+        if (expected != _elements) throw Pothos::AssertionViolationException("CollectorSink::verifyTestPlan()",
+            Poco::format("Check expected %Lu elements, actual %Lu elements", Poco::UInt64(expected), Poco::UInt64(_elements)));
+
+        unsigned long long expectedLabels = _labelsChecked + _expectedLabels.size();
+        while (_plan.nextLabels(labels, offset)) expectedLabels += labels.size();
+        if (expectedLabels != _labelsChecked) throw Pothos::AssertionViolationException("CollectorSink::verifyTestPlan()",
+            Poco::format("Check expected %Lu labels, actual %Lu labels", Poco::UInt64(expectedLabels), Poco::UInt64(_labelsChecked)));
+    }
+
+    if (_plan.packets())
+    {
+        unsigned long long expected = _packetsChecked;
+        size_t numElems = 0;
+        while (_plan.nextBuffer(numElems)) expected++;
+        if (expected != _packetsChecked) throw Pothos::AssertionViolationException("CollectorSink::verifyTestPlan()",
+            Poco::format("Check expected %Lu packets, actual %Lu packets", Poco::UInt64(expected), Poco::UInt64(_packetsChecked)));
+    }
+
+    unsigned long long expectedMessages = _messagesChecked;
+    std::string message;
+    while (_plan.nextMessage(message)) expectedMessages++;
+    if (expectedMessages != _messagesChecked) throw Pothos::AssertionViolationException("CollectorSink::verifyTestPlan()",
+        Poco::format("Check expected %Lu messages, actual %Lu messages", Poco::UInt64(expectedMessages), Poco::UInt64(_messagesChecked)));
+
+    if (not _plan.buffers() and not _plan.packets() and not _plan.messages())
+        throw Pothos::AssertionViolationException("CollectorSink::verifyTestPlan()", "nothing checked!");
+}
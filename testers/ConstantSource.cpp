@@ -1,10 +1,16 @@
 // Copyright (c) 2020 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
+#include "FillPattern.hpp"
+#include "SharedSliceBufferManager.hpp"
+
 #include <Pothos/Framework.hpp>
 
+#include <algorithm>
 #include <complex>
+#include <cstdint>
 #include <cstring>
+#include <string>
 #include <vector>
 
 /***********************************************************************
@@ -12,6 +18,13 @@
  *
  * Generate a buffer filled with a single specified value.
  *
+ * By default, the constant is written into each output buffer. In zero-copy
+ * mode, the block fills one buffer with the constant whenever it changes and
+ * posts read-only slices of it downstream, so no copies happen per work call.
+ * Downstream blocks that need a writable buffer will make their own copy.
+ * Each slice holds one of the output pool's buffers until it is released,
+ * so the pool size bounds how many slices are downstream at once.
+ *
  * |category /Testers
  * |category /Sources
  * |keywords test constant source
@@ -26,8 +39,14 @@
  * |default 0
  * |preview enable
  *
+ * |param zeroCopy[Zero Copy] Post slices of a shared constant buffer instead of filling each output buffer.
+ * |widget ToggleSwitch(on="True",off="False")
+ * |default false
+ * |preview valid
+ *
  * |factory /blocks/constant_source(dtype)
  * |setter setConstant(constant)
+ * |setter setZeroCopy(zeroCopy)
  **********************************************************************/
 template <typename T>
 class ConstantSource: public Pothos::Block
@@ -35,11 +54,20 @@ class ConstantSource: public Pothos::Block
 public:
 
     using Class = ConstantSource<T>;
+    using Word = FillWord<T>;
+
+    // The size of each slice. The shared buffer has one more element,
+    // so slices can start at any element of a one-element period.
+    static constexpr size_t SliceElems = 2 << 13;
 
     ConstantSource(size_t dimension):
         Pothos::Block(),
         _constant(0),
-        _cache()
+        _zeroCopy(false),
+        _pattern(),
+        _sharedBuffer(),
+        _sliceManager(),
+        _fcn("fill", getFillFcn<Word>(), &fillScalar<Word>)
     {
         this->setupOutput(0, Pothos::DType(typeid(T), dimension));
 
@@ -48,9 +76,17 @@ public:
         this->registerProbe("constant");
         this->registerSignal("constantChanged");
 
-        // Create an initial cache so initial resizing won't need to
-        // happen on activation.
-        this->_updateCache(2 << 13);
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, zeroCopy));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setZeroCopy));
+        this->registerProbe("zeroCopy");
+        this->registerSignal("zeroCopyChanged");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArchs));
+        this->registerProbe("simdArch");
+
+        this->_updatePattern();
     }
 
     T constant() const
@@ -61,11 +97,52 @@ public:
     void setConstant(T constant)
     {
         _constant = constant;
-        this->_updateCache(_cache.size());
-        
+        this->_updatePattern();
+
         this->emitSignal("constantChanged", _constant);
     }
 
+    bool zeroCopy() const
+    {
+        return _zeroCopy;
+    }
+
+    void setZeroCopy(bool zeroCopy)
+    {
+        _zeroCopy = zeroCopy;
+        if(!_zeroCopy) this->_releaseSharedBuffer();
+
+        this->emitSignal("zeroCopyChanged", _zeroCopy);
+    }
+
+    std::string simdArch() const
+    {
+        return _fcn.arch();
+    }
+
+    void setSIMDArch(const std::string& arch)
+    {
+        _fcn.setArch(arch);
+    }
+
+    std::vector<std::string> simdArchs() const
+    {
+        return _fcn.archs();
+    }
+
+    Pothos::BufferManager::Sptr getOutputBufferManager(
+        const std::string& /*name*/,
+        const std::string& domain) override
+    {
+        // A fresh pool has no shared buffer yet.
+        _sharedBuffer = Pothos::BufferChunk();
+        _sliceManager.reset();
+        if(!domain.empty()) throw Pothos::PortDomainError(domain);
+
+        _sliceManager.reset(new SharedSliceBufferManager());
+        return _sliceManager;
+    }
+
     void work() override
     {
         auto output0 = this->output(0);
@@ -76,42 +153,71 @@ public:
             return;
         }
 
-        const auto N = elems * output0->dtype().dimension();
+        // Slices come from this block's own pool, so another pool means copies.
+        if(_zeroCopy && _sliceManager)
+        {
+            if(!_sharedBuffer)
+            {
+                _sharedBuffer = Pothos::BufferChunk(output0->dtype(), SliceElems + 1);
+                this->_fill(_sharedBuffer.as<void*>(), SliceElems + 1);
 
-        // This resizes our cache if necessary.
-        this->_updateCache(elems);
-        std::memcpy(
-            output0->buffer(),
-            _cache.data(),
-            (N * sizeof(T)));
+                const auto elemSize = output0->dtype().size();
+                _sliceManager->setSharedBuffer(_sharedBuffer, elemSize, SliceElems * elemSize);
 
-        output0->produce(elems);
+                // The front buffer is now a slice, so start over with its size.
+                return this->yield();
+            }
+
+            output0->produce(output0->elements());
+        }
+        else
+        {
+            this->_fill(output0->buffer(), elems);
+            output0->produce(elems);
+        }
     }
 
 private:
     T _constant;
-    std::vector<T> _cache;
+    bool _zeroCopy;
+
+    // One frame of the constant, as the words the fill function uses
+    std::vector<Word> _pattern;
 
-    void _updateCache(size_t size)
+    // Never written after being filled, since slices may be downstream
+    Pothos::BufferChunk _sharedBuffer;
+    SharedSliceBufferManager::SPtr _sliceManager;
+
+    BlocksSIMD::SIMDFunction<FillFcn<Word>> _fcn;
+
+    void _updatePattern()
     {
-        if(_cache.empty())
-        {
-            _cache.resize(size, _constant);
-        }
-        else
-        {
-            if(_constant != _cache[0])
-            {
-                _cache.clear();
-            }
-            if(_cache.size() < size)
-            {
-                _cache.resize(size, _constant);
-            }
-        }
+        const auto dimension = this->output(0)->dtype().dimension();
+        const std::vector<T> frame(dimension, _constant);
+
+        _pattern.resize((dimension * sizeof(T)) / sizeof(Word));
+        std::memcpy(_pattern.data(), frame.data(), (dimension * sizeof(T)));
+
+        this->_releaseSharedBuffer();
+    }
+
+    // The pool keeps the old buffer for any slices still downstream.
+    void _releaseSharedBuffer()
+    {
+        _sharedBuffer = Pothos::BufferChunk();
+        if(_sliceManager) _sliceManager->clearSharedBuffer();
+    }
+
+    void _fill(void* out, size_t elems)
+    {
+        const auto numWords = elems * _pattern.size();
+        _fcn(_pattern.data(), reinterpret_cast<Word*>(out), _pattern.size(), numWords);
     }
 };
 
+template <typename T>
+constexpr size_t ConstantSource<T>::SliceElems;
+
 static Pothos::Block* makeConstantSource(const Pothos::DType& dtype)
 {
     #define ifTypeDeclareFactory(T) \
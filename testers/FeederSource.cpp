@@ -2,7 +2,11 @@
 //                    2020 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
+#include "StreamingTestPlan.hpp"
+#include "common/Random.hpp"
+
 #include <Pothos/Framework.hpp>
+#include <cstdint>
 #include <random>
 #include <chrono>
 #include <thread>
@@ -15,7 +19,10 @@ using json = nlohmann::json;
 class FeederSource : Pothos::Block
 {
 public:
-    FeederSource(const Pothos::DType &dtype)
+    FeederSource(const Pothos::DType &dtype):
+        _planElems(0),
+        _planElemsLeft(0),
+        _planLabelIndex(0)
     {
         this->setupOutput(0, dtype, this->uid()); //unique domain to force copies
         this->registerCall(this, POTHOS_FCN_TUPLE(FeederSource, feedTestPlan));
@@ -23,6 +30,7 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(FeederSource, feedLabel));
         this->registerCall(this, POTHOS_FCN_TUPLE(FeederSource, feedMessage));
         this->registerCall(this, POTHOS_FCN_TUPLE(FeederSource, feedPacket));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FeederSource, setSeed));
     }
 
     static Block *make(const Pothos::DType &dtype)
@@ -32,6 +40,12 @@ public:
 
     std::string feedTestPlan(const std::string &testPlan);
 
+    //seeds the generator used by subsequent test plans
+    void setSeed(const std::uint64_t seed)
+    {
+        _gen.seed(seed);
+    }
+
     void feedBuffer(const Pothos::BufferChunk &buffer)
     {
         _buffers.push(buffer);
@@ -84,6 +98,20 @@ public:
             _packets.pop();
             return;
         }
+        if (not _plans.empty())
+        {
+            //only come back right away after doing something,
+            //otherwise a returned output buffer wakes the block
+            bool progress = false;
+            if (not this->workStreamingTestPlan(_plans.front(), progress))
+            {
+                _plans.pop();
+                _planElemsLeft = 0;
+                progress = true;
+            }
+            if (progress) this->yield();
+            return;
+        }
 
         //enter backoff + wait for additional user stimulus
         std::this_thread::sleep_for(std::chrono::nanoseconds(this->workInfo().maxTimeoutNs));
@@ -91,40 +119,31 @@ public:
     }
 
 private:
+    std::string feedStreamingTestPlan(const json &testPlan);
+    bool workStreamingTestPlan(StreamingTestPlan &plan, bool &progress);
+
     std::queue<Pothos::BufferChunk> _buffers;
     std::queue<Pothos::Label> _labels;
     std::queue<Pothos::Object> _messages;
     std::queue<Pothos::Packet> _packets;
+    BlocksRandom::Xoshiro256 _gen;
+
+    //streaming test plans, and the buffer being fed from the front one
+    std::queue<StreamingTestPlan> _plans;
+    size_t _planElems;
+    size_t _planElemsLeft; //elements of the buffer not produced yet
+    std::vector<Pothos::Label> _planLabels;
+    size_t _planLabelIndex;
 };
 
 static Pothos::BlockRegistry registerSocketSink(
     "/blocks/feeder_source", &FeederSource::make);
 
 
-//http://stackoverflow.com/questions/440133/how-do-i-create-a-random-alpha-numeric-string-in-c
-std::string random_string(size_t length)
-{
-    static const std::string alphanums =
-        "0123456789"
-        "abcdefghijklmnopqrstuvwxyz"
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-
-    static std::mt19937 rg(std::chrono::system_clock::now().time_since_epoch().count());
-    static std::uniform_int_distribution<> pick(0, alphanums.size() - 1);
-
-    std::string s;
-
-    s.reserve(length);
-
-    while(length--)
-        s += alphanums[pick(rg)];
-
-    return s;
-}
-
 std::string FeederSource::feedTestPlan(const std::string &testPlanStr)
 {
     const auto testPlan = json::parse(testPlanStr);
+    if (testPlan.value("streaming", false)) return this->feedStreamingTestPlan(testPlan);
 
     //test plan data
     json expectedResult(json::object());
@@ -140,8 +159,7 @@ std::string FeederSource::feedTestPlan(const std::string &testPlanStr)
     std::vector<Pothos::Packet> packets;
 
     //random generation
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    auto &gen = _gen;
 
     //defaults
     const bool enableBuffers = testPlan.value("enableBuffers", false);
@@ -264,7 +282,7 @@ std::string FeederSource::feedTestPlan(const std::string &testPlanStr)
         {
             Pothos::Label lbl;
             lbl.index = index;
-            auto data = random_string(dataSizeDist(gen));
+            auto data = random_string(gen, dataSizeDist(gen));
             lbl.data = Pothos::Object(data);
             lbl.id = "id"+std::to_string(lbl.index);
 
@@ -317,7 +335,7 @@ std::string FeederSource::feedTestPlan(const std::string &testPlanStr)
         const size_t numMessages = messageDist(gen);
         for (size_t msgno = 0; msgno < numMessages; msgno++)
         {
-            auto data = random_string(dataSizeDist(gen));
+            auto data = random_string(gen, dataSizeDist(gen));
             messages.emplace_back(data);
             expectedMessages.push_back(std::move(data));
         }
@@ -337,3 +355,73 @@ std::string FeederSource::feedTestPlan(const std::string &testPlanStr)
 
     return expectedResult.dump();
 }
+
+/***********************************************************************
+ * Streaming test plans -- generate one buffer at a time while producing
+ **********************************************************************/
+std::string FeederSource::feedStreamingTestPlan(const json &testPlan)
+{
+    const auto plan = makeStreamingTestPlan(testPlan, this->output(0)->dtype(), _gen());
+    _plans.emplace(plan);
+
+    json expectedResult(json::object());
+    expectedResult["streamingTestPlan"] = plan;
+    return expectedResult.dump();
+}
+
+bool FeederSource::workStreamingTestPlan(StreamingTestPlan &plan, bool &progress)
+{
+    auto outputPort = this->output(0);
+    bool active = false;
+
+    //interleave the messages with the buffers
+    std::string message;
+    if (plan.nextMessage(message))
+    {
+        outputPort->postMessage(Pothos::Object(message));
+        active = progress = true;
+    }
+
+    //the output pool bounds the buffers and packets downstream,
+    //and a returned buffer wakes the block up again
+    if (outputPort->elements() == 0) return true;
+
+    if (plan.packets())
+    {
+        Pothos::Packet packet;
+        size_t numElems = 0;
+        unsigned long long offset = 0;
+        if (not plan.nextBuffer(numElems)) return active;
+        plan.nextLabels(packet.labels, offset);
+        packet.payload = (numElems == 0)?Pothos::BufferChunk(outputPort->dtype(), 0):outputPort->getBuffer(outputPort->dtype(), numElems);
+        plan.nextValues(packet.payload.as<void *>(), numElems);
+        outputPort->postMessage(packet);
+        progress = true;
+        return true;
+    }
+
+    //start the next buffer once the last one is produced
+    while (_planElemsLeft == 0)
+    {
+        unsigned long long offset = 0;
+        if (not plan.nextBuffer(_planElems)) return active;
+        plan.nextLabels(_planLabels, offset);
+        _planElemsLeft = _planElems;
+        _planLabelIndex = 0;
+    }
+
+    //generate as much of it as fits straight into the output buffer
+    const size_t numElems = std::min(outputPort->elements(), _planElemsLeft);
+    const size_t firstElem = _planElems - _planElemsLeft;
+    while (_planLabelIndex < _planLabels.size() and _planLabels[_planLabelIndex].index < firstElem + numElems)
+    {
+        auto label = _planLabels[_planLabelIndex++];
+        label.index -= firstElem; //buffer -> output relative
+        outputPort->postLabel(label);
+    }
+    plan.nextValues(outputPort->buffer().as<void *>(), numElems);
+    outputPort->produce(numElems);
+    _planElemsLeft -= numElems;
+    progress = true;
+    return true;
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+// Generated at build-time
+#ifdef POTHOS_XSIMD
+#include "TesterBlocks_SIMD.hpp"
+#endif
+
+#include "common/SIMDDispatch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+//
+// Repeated-pattern fills shared by the tester sources
+//
+
+// Frames are filled as words of up to 64 bits, so complex types and
+// multi-dimensional frames still fill as a repeated pattern.
+template <typename T>
+using FillWord = typename std::conditional<(sizeof(T) >= 8), std::uint64_t,
+                 typename std::conditional<(sizeof(T) == 4), std::uint32_t,
+                 typename std::conditional<(sizeof(T) == 2), std::uint16_t,
+                 std::uint8_t>::type>::type>::type;
+
+template <typename W>
+using FillFcn = void(*)(const W*, W*, size_t, size_t);
+
+template <typename W>
+static void fillScalar(const W* pattern, W* out, size_t patternLen, size_t len)
+{
+    for(size_t elem = 0; elem < len; ++elem)
+    {
+        out[elem] = pattern[elem % patternLen];
+    }
+}
+
+//
+// Implementation getters to be called on class construction
+//
+
+#ifdef POTHOS_XSIMD
+
+template <typename W>
+static inline FillFcn<W> getFillFcn()
+{
+    return PothosBlocksSIMD::fillDispatch<W>();
+}
+
+#else
+
+template <typename W>
+static inline FillFcn<W> getFillFcn()
+{
+    return &fillScalar<W>;
+}
+
+#endif
@@ -1,8 +1,11 @@
 // Copyright (c) 2016-2017 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "common/Random.hpp"
+
 #include <Pothos/Framework.hpp>
 #include <iostream>
+#include <cstdint>
 #include <cstring>
 #include <random>
 
@@ -53,13 +56,13 @@ public:
         _alphanums("0123456789"
             "abcdefghijklmnopqrstuvwxyz"
             "ABCDEFGHIJKLMNOPQRSTUVWXYZ"),
-        _randomAlnum(std::uniform_int_distribution<size_t>(0, _alphanums.size()-1)),
-        _randomByte(std::uniform_int_distribution<size_t>(0, 255))
+        _randomAlnum(std::uniform_int_distribution<size_t>(0, _alphanums.size()-1))
     {
         this->setupOutput(0);
         this->registerCall(this, POTHOS_FCN_TUPLE(MessageGenerator, setType));
         this->registerCall(this, POTHOS_FCN_TUPLE(MessageGenerator, setMode));
         this->registerCall(this, POTHOS_FCN_TUPLE(MessageGenerator, setSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(MessageGenerator, setSeed));
     }
 
     static Block *make(void)
@@ -91,6 +94,11 @@ public:
         _randomInt = std::uniform_int_distribution<unsigned>(0, _size-1);
     }
 
+    void setSeed(const std::uint64_t seed)
+    {
+        _gen.seed(seed);
+    }
+
     void activate(void)
     {
         _counter = 0;
@@ -117,10 +125,8 @@ public:
         }
         else if (_mode == "RANDOM_BYTES")
         {
-            for (size_t i = 0; i < _size; i++)
-            {
-                strOut += uint8_t(_randomByte(_gen));
-            }
+            strOut.resize(_size);
+            _gen.fillBytes(&strOut[0], _size);
         }
 
         //produce the message
@@ -149,12 +155,10 @@ private:
 
     //state
     unsigned _counter;
-    std::random_device _rd;
-    std::mt19937 _gen;
+    BlocksRandom::Xoshiro256 _gen;
     std::uniform_int_distribution<unsigned> _randomInt;
     const std::string _alphanums;
     std::uniform_int_distribution<size_t> _randomAlnum;
-    std::uniform_int_distribution<size_t> _randomByte;
 };
 
 static Pothos::BlockRegistry registerMessageGenerator(
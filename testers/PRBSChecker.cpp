@@ -0,0 +1,720 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+// Generated at build-time
+#ifdef POTHOS_XSIMD
+#include "TesterBlocks_SIMD.hpp"
+#endif
+
+#include "RampPattern.hpp"
+
+#include "common/PRBS.hpp"
+#include "common/SIMDDispatch.hpp"
+
+#include <Pothos/Framework.hpp>
+
+#include <Poco/Format.h>
+
+#include <algorithm>
+#include <bitset>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//
+// Implementation getters to be called on class construction
+//
+
+using MismatchFindFcn = size_t(*)(const std::uint8_t*, const std::uint8_t*, size_t);
+
+static size_t mismatchFindScalar(const std::uint8_t* in, const std::uint8_t* expected, size_t len)
+{
+    for(size_t elem = 0; elem < len; ++elem)
+    {
+        if(in[elem] != expected[elem]) return elem;
+    }
+
+    return len;
+}
+
+#ifdef POTHOS_XSIMD
+
+static inline MismatchFindFcn getMismatchFindFcn()
+{
+    return PothosBlocksSIMD::mismatchFindDispatch<std::uint8_t>();
+}
+
+#else
+
+static inline MismatchFindFcn getMismatchFindFcn()
+{
+    return &mismatchFindScalar;
+}
+
+#endif
+
+static inline size_t countBitErrors(const std::uint8_t* in, const std::uint8_t* expected, size_t len)
+{
+    size_t errors = 0;
+    for(size_t byte = 0; byte < len; ++byte) errors += std::bitset<8>(in[byte] ^ expected[byte]).count();
+
+    return errors;
+}
+
+/***********************************************************************
+ * |PothosDoc PRBS Checker
+ *
+ * Check a received stream against a known test pattern, for bit-exact
+ * soak tests of links and transports. The patterns match those of the
+ * Pattern Source block, and the checker needs no settings in common with
+ * the sender beyond the pattern itself, since it synchronizes to the data.
+ * Memory use does not grow with the amount of data checked.
+ *
+ * <ul>
+ * <li><b>PRBS:</b> The register is loaded from received bytes, and the
+ * checker locks once the bytes after them match. Since any run of bytes
+ * determines the rest of the sequence, lost or repeated data can only be
+ * seen as a loss of lock, followed by a resync.</li>
+ * <li><b>RAMP:</b> Each value of the ramp identifies its position, so the
+ * checker locks once several values in a row continue the ramp. While locked,
+ * a value that belongs somewhere else in the ramp counts as a gap, along with
+ * how many values were skipped, and any other value counts as an error.
+ * The ramp values should be unique within the ramp length, and gaps
+ * of a whole number of ramps cannot be seen.</li>
+ * </ul>
+ *
+ * Errors are counted per bit, and per element of the input type.
+ * The counts are checked in windows of 8192 bits, and a window with a bit error rate
+ * above the loss threshold drops the lock. The data of that window and the window
+ * before it, where the loss may have started, is not counted.
+ * Input packets are checked the same way as the input stream.
+ * The counts start over when the block is activated, or when reset() is called.
+ *
+ * |category /Testers
+ * |category /Sinks
+ * |keywords test pattern prbs lfsr ramp counter ber bit error rate checker soak
+ *
+ * |param dtype[Data Type] The input data type.
+ * |widget DTypeChooser(int=1,uint=1,float=1,cint=1,cuint=1,cfloat=1,dim=1)
+ * |default "uint8"
+ * |preview disable
+ *
+ * |param pattern[Pattern] The pattern to check for.
+ * |option [PRBS] "PRBS"
+ * |option [Ramp] "RAMP"
+ * |default "PRBS"
+ * |preview enable
+ *
+ * |param prbsOrder[PRBS Order] The PRBS register length, which repeats every 2^order-1 bits.
+ * |option [PRBS7] 7
+ * |option [PRBS9] 9
+ * |option [PRBS11] 11
+ * |option [PRBS15] 15
+ * |option [PRBS20] 20
+ * |option [PRBS23] 23
+ * |option [PRBS29] 29
+ * |option [PRBS31] 31
+ * |default 31
+ * |preview valid
+ *
+ * |param rampStart[Ramp Start] The first value of each ramp.
+ * |default 0
+ * |preview valid
+ *
+ * |param rampStep[Ramp Step] The increment between ramp values.
+ * |default 1
+ * |preview valid
+ *
+ * |param rampLength[Ramp Length] The number of values before the ramp starts over.
+ * |widget SpinBox(minimum=1)
+ * |default 1024
+ * |preview valid
+ *
+ * |param lossThreshold[Loss Threshold] The bit error rate in one window that drops the lock.
+ * |default 0.1
+ * |preview valid
+ *
+ * |factory /blocks/prbs_checker(dtype)
+ * |setter setPattern(pattern)
+ * |setter setPRBSOrder(prbsOrder)
+ * |setter setRampStart(rampStart)
+ * |setter setRampStep(rampStep)
+ * |setter setRampLength(rampLength)
+ * |setter setLossThreshold(lossThreshold)
+ **********************************************************************/
+template <typename T>
+class PRBSChecker: public Pothos::Block
+{
+public:
+
+    using Class = PRBSChecker<T>;
+
+    // The PRBS locks once this many bytes follow the register as expected,
+    // and the ramp once this many values in a row continue it.
+    static constexpr size_t PRBSLockBytes = 8;
+    static constexpr size_t RampLockElems = 4;
+
+    static constexpr size_t WindowBytes = 1024;
+
+    // Short ramps are stored repeated up to this many values,
+    // so that comparisons are not dominated by per-period overhead
+    static constexpr size_t MinRampBufferLen = 4096;
+
+    PRBSChecker(size_t dimension):
+        Pothos::Block(),
+        _pattern("PRBS"),
+        _prbs(31),
+        _rampStart(0),
+        _rampStep(1),
+        _rampLength(1024),
+        _lossThreshold(0.1),
+        _expected(WindowBytes),
+        _fcn("mismatchFind", getMismatchFindFcn(), &mismatchFindScalar)
+    {
+        this->setupInput(0, Pothos::DType(typeid(T), dimension));
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, pattern));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setPattern));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, prbsOrder));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setPRBSOrder));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, rampStart));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setRampStart));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, rampStep));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setRampStep));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, rampLength));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setRampLength));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, lossThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setLossThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, reset));
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, locked));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, resyncs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, bitsChecked));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, bitErrors));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, bitErrorRate));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, elementsChecked));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, elementErrors));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, gaps));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, gapElements));
+        this->registerProbe("locked");
+        this->registerProbe("resyncs");
+        this->registerProbe("bitsChecked");
+        this->registerProbe("bitErrors");
+        this->registerProbe("bitErrorRate");
+        this->registerProbe("elementsChecked");
+        this->registerProbe("elementErrors");
+        this->registerProbe("gaps");
+        this->registerProbe("gapElements");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArchs));
+        this->registerProbe("simdArch");
+
+        this->_updateRamp();
+        this->reset();
+    }
+
+    std::string pattern() const
+    {
+        return _pattern;
+    }
+
+    void setPattern(const std::string& pattern)
+    {
+        if((pattern != "PRBS") && (pattern != "RAMP"))
+        {
+            throw Pothos::InvalidArgumentException("Invalid pattern", pattern);
+        }
+
+        _pattern = pattern;
+        this->_unlock();
+    }
+
+    size_t prbsOrder() const
+    {
+        return _prbs.order();
+    }
+
+    void setPRBSOrder(size_t order)
+    {
+        BlocksPRBS::Polynomial polynomial;
+        if(!BlocksPRBS::findPolynomial(order, polynomial))
+        {
+            throw Pothos::InvalidArgumentException("Unsupported PRBS order", Poco::format("%z", order));
+        }
+
+        _prbs = BlocksPRBS::Generator(order);
+        this->_unlock();
+    }
+
+    T rampStart() const
+    {
+        return _rampStart;
+    }
+
+    void setRampStart(T rampStart)
+    {
+        _rampStart = rampStart;
+        this->_updateRamp();
+    }
+
+    T rampStep() const
+    {
+        return _rampStep;
+    }
+
+    void setRampStep(T rampStep)
+    {
+        _rampStep = rampStep;
+        this->_updateRamp();
+    }
+
+    size_t rampLength() const
+    {
+        return _rampLength;
+    }
+
+    void setRampLength(size_t rampLength)
+    {
+        if(0 == rampLength)
+        {
+            throw Pothos::RangeException("PRBSChecker::setRampLength()", "ramp length must be positive");
+        }
+
+        _rampLength = rampLength;
+        this->_updateRamp();
+    }
+
+    double lossThreshold() const
+    {
+        return _lossThreshold;
+    }
+
+    void setLossThreshold(double lossThreshold)
+    {
+        if((lossThreshold <= 0.0) || (lossThreshold > 1.0))
+        {
+            throw Pothos::RangeException("PRBSChecker::setLossThreshold()", "loss threshold must be in (0, 1]");
+        }
+
+        _lossThreshold = lossThreshold;
+    }
+
+    // Clears the counts, and synchronizes again
+    void reset()
+    {
+        _hasLocked = false;
+        _resyncs = 0;
+        _totals = Counts();
+        _streamBytes = 0;
+        this->_unlock();
+    }
+
+    bool locked() const
+    {
+        return _locked;
+    }
+
+    unsigned long long resyncs() const
+    {
+        return _resyncs;
+    }
+
+    unsigned long long bitsChecked() const
+    {
+        return 8 * this->_counts().bytes;
+    }
+
+    unsigned long long bitErrors() const
+    {
+        return this->_counts().bitErrors;
+    }
+
+    double bitErrorRate() const
+    {
+        const auto bits = this->bitsChecked();
+        return (0 == bits) ? 0.0 : (double(this->bitErrors()) / double(bits));
+    }
+
+    unsigned long long elementsChecked() const
+    {
+        return this->_counts().bytes / sizeof(T);
+    }
+
+    unsigned long long elementErrors() const
+    {
+        return this->_counts().elementErrors;
+    }
+
+    unsigned long long gaps() const
+    {
+        return this->_counts().gaps;
+    }
+
+    unsigned long long gapElements() const
+    {
+        return this->_counts().gapElements;
+    }
+
+    std::string simdArch() const
+    {
+        return _fcn.arch();
+    }
+
+    void setSIMDArch(const std::string& arch)
+    {
+        _fcn.setArch(arch);
+    }
+
+    std::vector<std::string> simdArchs() const
+    {
+        return _fcn.archs();
+    }
+
+    void activate() override
+    {
+        this->reset();
+    }
+
+    void work() override
+    {
+        auto input0 = this->input(0);
+
+        if(input0->hasMessage())
+        {
+            const auto msg = input0->popMessage();
+            if(msg.type() == typeid(Pothos::Packet))
+            {
+                const auto& payload = msg.extract<Pothos::Packet>().payload;
+                this->_check(payload.as<const std::uint8_t*>(), (payload.length / sizeof(T)) * sizeof(T));
+            }
+        }
+
+        const auto elems = input0->elements();
+        if(0 == elems)
+        {
+            return;
+        }
+
+        this->_check(input0->buffer().template as<const std::uint8_t*>(), elems * input0->dtype().size());
+        input0->consume(elems);
+    }
+
+private:
+    struct Counts
+    {
+        unsigned long long bytes{0};
+        unsigned long long bitErrors{0};
+        unsigned long long elementErrors{0};
+        unsigned long long gaps{0};
+        unsigned long long gapElements{0};
+
+        Counts& operator+=(const Counts& other)
+        {
+            bytes += other.bytes;
+            bitErrors += other.bitErrors;
+            elementErrors += other.elementErrors;
+            gaps += other.gaps;
+            gapElements += other.gapElements;
+            return *this;
+        }
+    };
+
+    std::string _pattern;
+
+    BlocksPRBS::Generator _prbs;
+
+    T _rampStart;
+    T _rampStep;
+    size_t _rampLength;
+    std::vector<T> _ramp; // A whole number of ramps
+    std::unordered_map<std::string, size_t> _rampPhases;
+    size_t _rampPhase;
+
+    double _lossThreshold;
+
+    bool _locked;
+    bool _hasLocked;
+    unsigned long long _resyncs;
+
+    // Received bytes being tried as the PRBS register, and how many
+    // ramp values in a row have continued the ramp while unlocked
+    std::vector<std::uint8_t> _syncBytes;
+    size_t _syncMatches;
+
+    // Counts become totals once their window and the one after it pass
+    Counts _totals;
+    Counts _previous;
+    Counts _window;
+    unsigned long long _streamBytes;
+    unsigned long long _lastErrorElem;
+
+    std::vector<std::uint8_t> _expected;
+
+    BlocksSIMD::SIMDFunction<MismatchFindFcn> _fcn;
+
+    void _updateRamp()
+    {
+        generateRamp(_rampStart, _rampStep, _rampLength, MinRampBufferLen, _ramp);
+
+        // Repeated values keep their first phase.
+        _rampPhases.clear();
+        for(size_t phase = 0; phase < _rampLength; ++phase)
+        {
+            _rampPhases.emplace(this->_rampKey(reinterpret_cast<const std::uint8_t*>(&_ramp[phase])), phase);
+        }
+
+        this->_unlock();
+    }
+
+    void _unlock()
+    {
+        _locked = false;
+        _syncBytes.clear();
+        _syncMatches = 0;
+        _rampPhase = 0;
+        _previous = Counts();
+        _window = Counts();
+        _lastErrorElem = std::numeric_limits<unsigned long long>::max();
+    }
+
+    void _lock()
+    {
+        if(_hasLocked) ++_resyncs;
+        _hasLocked = true;
+        _locked = true;
+    }
+
+    void _check(const std::uint8_t* in, size_t len)
+    {
+        while(len > 0)
+        {
+            size_t used;
+            if(!_locked) used = ("PRBS" == _pattern) ? this->_syncPRBS(in, len) : this->_syncRamp(in, len);
+            else         used = ("PRBS" == _pattern) ? this->_checkPRBS(in, len) : this->_checkRamp(in, len);
+
+            in += used;
+            len -= used;
+            _streamBytes += used;
+        }
+    }
+
+    Counts _counts() const
+    {
+        auto counts = _totals;
+        counts += _previous;
+        counts += _window;
+        return counts;
+    }
+
+    // Ends the window if it is full, dropping the lock if it had too many
+    // errors. The window before it is dropped too, since a loss that starts
+    // near the end of a window may not push that window over the threshold.
+    void _closeWindow()
+    {
+        if(_window.bytes < WindowBytes) return;
+
+        if(double(_window.bitErrors) > (_lossThreshold * 8.0 * double(_window.bytes)))
+        {
+            this->_unlock();
+            return;
+        }
+
+        _totals += _previous;
+        _previous = _window;
+        _window = Counts();
+    }
+
+    void _countErrors(const std::uint8_t* in, const std::uint8_t* expected, size_t offset, size_t len)
+    {
+        const auto bitErrors = countBitErrors(in, expected, len);
+        if(0 == bitErrors) return;
+
+        _window.bitErrors += bitErrors;
+
+        // An element with several bad bytes is one error.
+        for(size_t byte = 0; byte < len; ++byte)
+        {
+            if(in[byte] == expected[byte]) continue;
+
+            const auto elem = (_streamBytes + offset + byte) / sizeof(T);
+            if(elem != _lastErrorElem) ++_window.elementErrors;
+            _lastErrorElem = elem;
+        }
+    }
+
+    //
+    // PRBS
+    //
+
+    // Returns the number of bytes used
+    size_t _syncPRBS(const std::uint8_t* in, size_t len)
+    {
+        const auto historyBytes = (_prbs.order() + 7) / 8;
+
+        for(size_t byte = 0; byte < len; ++byte)
+        {
+            _syncBytes.push_back(in[byte]);
+            if(_syncBytes.size() < (historyBytes + PRBSLockBytes)) continue;
+
+            std::uint64_t history = 0;
+            for(size_t i = 0; i < historyBytes; ++i) history = (history << 8) | _syncBytes[i];
+            _prbs.setHistory(history);
+
+            std::uint8_t expected[PRBSLockBytes];
+            _prbs.generateBytes(expected, PRBSLockBytes);
+            if(0 == std::memcmp(expected, _syncBytes.data() + historyBytes, PRBSLockBytes))
+            {
+                _syncBytes.clear();
+                this->_lock();
+                return byte + 1;
+            }
+
+            // Try again one byte later.
+            _syncBytes.erase(_syncBytes.begin());
+        }
+
+        return len;
+    }
+
+    size_t _checkPRBS(const std::uint8_t* in, size_t len)
+    {
+        const auto chunk = std::min(len, size_t(WindowBytes - _window.bytes));
+        _prbs.generateBytes(_expected.data(), chunk);
+
+        size_t offset = 0;
+        while(offset < chunk)
+        {
+            offset += _fcn(in + offset, _expected.data() + offset, chunk - offset);
+            if(offset >= chunk) break;
+
+            this->_countErrors(in + offset, _expected.data() + offset, offset, 1);
+            ++offset;
+        }
+
+        _window.bytes += chunk;
+        this->_closeWindow();
+
+        return chunk;
+    }
+
+    //
+    // Ramp
+    //
+
+    std::string _rampKey(const std::uint8_t* value) const
+    {
+        return std::string(reinterpret_cast<const char*>(value), sizeof(T));
+    }
+
+    bool _findRampPhase(const std::uint8_t* value, size_t& phase) const
+    {
+        const auto iter = _rampPhases.find(this->_rampKey(value));
+        if(_rampPhases.end() == iter) return false;
+
+        phase = iter->second;
+        return true;
+    }
+
+    const std::uint8_t* _expectedRamp() const
+    {
+        return reinterpret_cast<const std::uint8_t*>(_ramp.data() + _rampPhase);
+    }
+
+    size_t _syncRamp(const std::uint8_t* in, size_t len)
+    {
+        for(size_t byte = 0; byte < len; byte += sizeof(T))
+        {
+            size_t phase;
+            if((_syncMatches > 0) && (0 == std::memcmp(in + byte, this->_expectedRamp(), sizeof(T))))
+            {
+                ++_syncMatches;
+            }
+            else if(this->_findRampPhase(in + byte, phase))
+            {
+                _rampPhase = phase;
+                _syncMatches = 1;
+            }
+            else
+            {
+                _syncMatches = 0;
+                continue;
+            }
+
+            _rampPhase = (_rampPhase + 1) % _rampLength;
+            if(_syncMatches >= RampLockElems)
+            {
+                _syncMatches = 0;
+                this->_lock();
+                return byte + sizeof(T);
+            }
+        }
+
+        return len;
+    }
+
+    size_t _checkRamp(const std::uint8_t* in, size_t len)
+    {
+        const auto windowElems = std::max<size_t>(1, size_t(WindowBytes - _window.bytes) / sizeof(T));
+        const auto elems = std::min({(len / sizeof(T)), (_ramp.size() - _rampPhase), windowElems});
+        const auto chunk = elems * sizeof(T);
+
+        // Everything before the first mismatch is good.
+        const auto good = (_fcn(in, this->_expectedRamp(), chunk) / sizeof(T)) * sizeof(T);
+        _window.bytes += good;
+        _rampPhase = (_rampPhase + (good / sizeof(T))) % _ramp.size();
+
+        if(good < chunk)
+        {
+            const auto* value = in + good;
+
+            size_t phase;
+            if(this->_findRampPhase(value, phase))
+            {
+                ++_window.gaps;
+                _window.gapElements += ((phase + _rampLength) - (_rampPhase % _rampLength)) % _rampLength;
+                _rampPhase = phase;
+            }
+            else this->_countErrors(value, this->_expectedRamp(), good, sizeof(T));
+
+            _window.bytes += sizeof(T);
+            _rampPhase = (_rampPhase + 1) % _ramp.size();
+        }
+
+        const auto used = std::min(chunk, (good + sizeof(T)));
+        this->_closeWindow();
+
+        return used;
+    }
+};
+
+static Pothos::Block* makePRBSChecker(const Pothos::DType& dtype)
+{
+    #define ifTypeDeclareFactory(T) \
+        if(Pothos::DType::fromDType(dtype, 1) == Pothos::DType(typeid(T))) \
+            return new PRBSChecker<T>(dtype.dimension()); \
+        if(Pothos::DType::fromDType(dtype, 1) == Pothos::DType(typeid(std::complex<T>))) \
+            return new PRBSChecker<std::complex<T>>(dtype.dimension());
+
+    ifTypeDeclareFactory(std::int8_t)
+    ifTypeDeclareFactory(std::int16_t)
+    ifTypeDeclareFactory(std::int32_t)
+    ifTypeDeclareFactory(std::int64_t)
+    ifTypeDeclareFactory(std::uint8_t)
+    ifTypeDeclareFactory(std::uint16_t)
+    ifTypeDeclareFactory(std::uint32_t)
+    ifTypeDeclareFactory(std::uint64_t)
+    ifTypeDeclareFactory(float)
+    ifTypeDeclareFactory(double)
+
+    throw Pothos::InvalidArgumentException("Invalid type", dtype.name());
+}
+
+static Pothos::BlockRegistry registerPRBSChecker(
+    "/blocks/prbs_checker",
+    Pothos::Callable(&makePRBSChecker));
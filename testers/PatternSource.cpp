@@ -0,0 +1,495 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "FillPattern.hpp"
+#include "RampPattern.hpp"
+#include "SharedSliceBufferManager.hpp"
+
+#include "common/PRBS.hpp"
+#include "common/Random.hpp"
+
+#include <Pothos/Framework.hpp>
+
+#include <Poco/Format.h>
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+template <typename Scalar>
+static typename std::enable_if<std::is_integral<Scalar>::value>::type fillRandom(BlocksRandom::Xoshiro256& gen, Scalar* out, size_t len)
+{
+    gen.fillBytes(out, len * sizeof(Scalar));
+}
+
+// Floating-point values are uniform in [-1.0, 1.0).
+template <typename Scalar>
+static typename std::enable_if<std::is_floating_point<Scalar>::value>::type fillRandom(BlocksRandom::Xoshiro256& gen, Scalar* out, size_t len)
+{
+    double uniform[256];
+    while(len > 0)
+    {
+        const auto chunk = std::min(len, (sizeof(uniform) / sizeof(uniform[0])));
+        gen.fillUniform(uniform, chunk);
+        for(size_t elem = 0; elem < chunk; ++elem) out[elem] = Scalar((2.0 * uniform[elem]) - 1.0);
+
+        out += chunk;
+        len -= chunk;
+    }
+}
+
+/***********************************************************************
+ * |PothosDoc Pattern Source
+ *
+ * Generate a stream of typed test data, fast enough to load test
+ * downstream blocks at memory bandwidth.
+ *
+ * <ul>
+ * <li><b>RAMP:</b> Values count up from the ramp start by the ramp step,
+ * and start over every ramp length values. Integer ramps wrap around.</li>
+ * <li><b>CONSTANT:</b> Every value is the constant.</li>
+ * <li><b>PRBS:</b> A pseudo-random binary sequence from a linear feedback shift register,
+ * packed into the output bytes most significant bit first, for bit error rate testing.</li>
+ * <li><b>RANDOM:</b> Uniformly random values. Integer types use every bit,
+ * and floating-point types are uniform from -1.0 to 1.0.</li>
+ * </ul>
+ *
+ * Complex types apply the pattern to their real and imaginary parts separately.
+ * The random and PRBS patterns can be made repeatable with setSeed().
+ *
+ * In zero-copy mode, the block generates one period of the pattern, plus one
+ * slice, into a shared buffer whenever the settings change, and posts read-only
+ * slices of it downstream. Each slice starts where the last one ended, so the
+ * pattern continues between buffers, but generating the data costs nothing
+ * per work call. This applies to the ramp, constant, and PRBS patterns when
+ * one period fits in 32 MiB, such as PRBS orders up to 20 for scalar and
+ * complex types. Otherwise,
+ * the pattern is generated into each output buffer as usual. Each slice holds
+ * one of the output pool's buffers until it is released, so the pool size
+ * bounds how many slices are downstream at once.
+ *
+ * |category /Testers
+ * |category /Sources
+ * |keywords test pattern ramp constant prbs lfsr random load benchmark source
+ *
+ * |param dtype[Data Type] The output data type.
+ * |widget DTypeChooser(int=1,uint=1,float=1,cint=1,cuint=1,cfloat=1,dim=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param pattern[Pattern] The pattern to generate.
+ * |option [Ramp] "RAMP"
+ * |option [Constant] "CONSTANT"
+ * |option [PRBS] "PRBS"
+ * |option [Random] "RANDOM"
+ * |default "RAMP"
+ * |preview enable
+ *
+ * |param constant[Constant] The value for the constant pattern.
+ * |default 0
+ * |preview valid
+ *
+ * |param rampStart[Ramp Start] The first value of each ramp.
+ * |default 0
+ * |preview valid
+ *
+ * |param rampStep[Ramp Step] The increment between ramp values.
+ * |default 1
+ * |preview valid
+ *
+ * |param rampLength[Ramp Length] The number of values before the ramp starts over.
+ * |widget SpinBox(minimum=1)
+ * |default 1024
+ * |preview valid
+ *
+ * |param prbsOrder[PRBS Order] The PRBS register length, which repeats every 2^order-1 bits.
+ * |option [PRBS7] 7
+ * |option [PRBS9] 9
+ * |option [PRBS11] 11
+ * |option [PRBS15] 15
+ * |option [PRBS20] 20
+ * |option [PRBS23] 23
+ * |option [PRBS29] 29
+ * |option [PRBS31] 31
+ * |default 31
+ * |preview valid
+ *
+ * |param zeroCopy[Zero Copy] Post slices of a shared pre-generated buffer instead of filling each output buffer.
+ * |widget ToggleSwitch(on="True",off="False")
+ * |default false
+ * |preview valid
+ *
+ * |factory /blocks/pattern_source(dtype)
+ * |setter setPattern(pattern)
+ * |setter setConstant(constant)
+ * |setter setRampStart(rampStart)
+ * |setter setRampStep(rampStep)
+ * |setter setRampLength(rampLength)
+ * |setter setPRBSOrder(prbsOrder)
+ * |setter setZeroCopy(zeroCopy)
+ **********************************************************************/
+template <typename T>
+class PatternSource: public Pothos::Block
+{
+public:
+
+    using Class = PatternSource<T>;
+    using Word = FillWord<T>;
+    using Scalar = typename PatternTraits<T>::Scalar;
+    static constexpr size_t Components = PatternTraits<T>::Components;
+
+    // The size of each zero-copy slice, and the largest shared buffer
+    static constexpr size_t SliceElems = 2 << 13;
+    static constexpr size_t MaxSharedBufferBytes = 1 << 25;
+
+    // Short ramps are stored repeated up to this many values,
+    // so that copying them out is not dominated by per-period overhead
+    static constexpr size_t MinRampBufferLen = 4096;
+
+    PatternSource(size_t dimension):
+        Pothos::Block(),
+        _pattern("RAMP"),
+        _constant(0),
+        _rampStart(0),
+        _rampStep(1),
+        _rampLength(1024),
+        _rampPhase(0),
+        _seed(BlocksRandom::randomSeed()),
+        _prbs(31, _seed),
+        _gen(_seed),
+        _zeroCopy(false),
+        _sliceManager(),
+        _fcn("fill", getFillFcn<Word>(), &fillScalar<Word>)
+    {
+        this->setupOutput(0, Pothos::DType(typeid(T), dimension));
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, pattern));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setPattern));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, constant));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setConstant));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, rampStart));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setRampStart));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, rampStep));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setRampStep));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, rampLength));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setRampLength));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, prbsOrder));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setPRBSOrder));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSeed));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, zeroCopy));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setZeroCopy));
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSIMDArch));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, simdArchs));
+        this->registerProbe("simdArch");
+
+        this->_updateRamp();
+    }
+
+    std::string pattern() const
+    {
+        return _pattern;
+    }
+
+    void setPattern(const std::string& pattern)
+    {
+        if((pattern != "RAMP") && (pattern != "CONSTANT") && (pattern != "PRBS") && (pattern != "RANDOM"))
+        {
+            throw Pothos::InvalidArgumentException("Invalid pattern", pattern);
+        }
+
+        _pattern = pattern;
+        this->_restart();
+    }
+
+    T constant() const
+    {
+        return _constant;
+    }
+
+    void setConstant(T constant)
+    {
+        _constant = constant;
+        this->_restart();
+    }
+
+    T rampStart() const
+    {
+        return _rampStart;
+    }
+
+    void setRampStart(T rampStart)
+    {
+        _rampStart = rampStart;
+        this->_updateRamp();
+    }
+
+    T rampStep() const
+    {
+        return _rampStep;
+    }
+
+    void setRampStep(T rampStep)
+    {
+        _rampStep = rampStep;
+        this->_updateRamp();
+    }
+
+    size_t rampLength() const
+    {
+        return _rampLength;
+    }
+
+    void setRampLength(size_t rampLength)
+    {
+        if(0 == rampLength)
+        {
+            throw Pothos::RangeException("PatternSource::setRampLength()", "ramp length must be positive");
+        }
+
+        _rampLength = rampLength;
+        this->_updateRamp();
+    }
+
+    size_t prbsOrder() const
+    {
+        return _prbs.order();
+    }
+
+    void setPRBSOrder(size_t order)
+    {
+        BlocksPRBS::Polynomial polynomial;
+        if(!BlocksPRBS::findPolynomial(order, polynomial))
+        {
+            throw Pothos::InvalidArgumentException("Unsupported PRBS order", Poco::format("%z", order));
+        }
+
+        _prbs = BlocksPRBS::Generator(order, _seed);
+        this->_restart();
+    }
+
+    void setSeed(std::uint64_t seed)
+    {
+        _seed = seed;
+        this->_restart();
+    }
+
+    bool zeroCopy() const
+    {
+        return _zeroCopy;
+    }
+
+    void setZeroCopy(bool zeroCopy)
+    {
+        _zeroCopy = zeroCopy;
+        this->_releaseSharedBuffer();
+    }
+
+    std::string simdArch() const
+    {
+        return _fcn.arch();
+    }
+
+    void setSIMDArch(const std::string& arch)
+    {
+        _fcn.setArch(arch);
+    }
+
+    std::vector<std::string> simdArchs() const
+    {
+        return _fcn.archs();
+    }
+
+    Pothos::BufferManager::Sptr getOutputBufferManager(
+        const std::string& /*name*/,
+        const std::string& domain) override
+    {
+        // A fresh pool has no shared buffer yet.
+        _sharedBuffer = Pothos::BufferChunk();
+        _sliceManager.reset();
+        if(!domain.empty()) throw Pothos::PortDomainError(domain);
+
+        _sliceManager.reset(new SharedSliceBufferManager());
+        return _sliceManager;
+    }
+
+    void work() override
+    {
+        auto output0 = this->output(0);
+
+        const auto elems = output0->elements();
+        if(0 == elems)
+        {
+            return;
+        }
+
+        const auto dimension = output0->dtype().dimension();
+        const auto elemSize = output0->dtype().size();
+
+        // Slices come from this block's own pool, so another pool means copies.
+        if(_zeroCopy && _sliceManager && !_sharedBuffer)
+        {
+            const auto periodBytes = this->_periodBytes(elemSize);
+            if(periodBytes > 0)
+            {
+                const auto sharedElems = (periodBytes / elemSize) + SliceElems;
+                _sharedBuffer = Pothos::BufferChunk(output0->dtype(), sharedElems);
+                this->_generate(_sharedBuffer.as<T*>(), sharedElems * dimension);
+                _sliceManager->setSharedBuffer(_sharedBuffer, periodBytes, SliceElems * elemSize);
+
+                // The front buffer is now a slice, so start over with its size.
+                return this->yield();
+            }
+        }
+
+        if(_zeroCopy && _sharedBuffer)
+        {
+            output0->produce(elems);
+        }
+        else
+        {
+            this->_generate(output0->buffer().template as<T*>(), elems * dimension);
+            output0->produce(elems);
+        }
+    }
+
+private:
+    std::string _pattern;
+
+    T _constant;
+
+    T _rampStart;
+    T _rampStep;
+    size_t _rampLength;
+    std::vector<T> _ramp; // A whole number of ramps
+    size_t _rampPhase;
+
+    std::uint64_t _seed;
+    BlocksPRBS::Generator _prbs;
+    BlocksRandom::Xoshiro256 _gen;
+
+    bool _zeroCopy;
+
+    // Never written after being generated, since slices may be downstream
+    Pothos::BufferChunk _sharedBuffer;
+    SharedSliceBufferManager::SPtr _sliceManager;
+
+    BlocksSIMD::SIMDFunction<FillFcn<Word>> _fcn;
+
+    // Starts the pattern over, such as after a settings change.
+    void _restart()
+    {
+        _rampPhase = 0;
+        _prbs.seed(_seed);
+        _gen.seed(_seed);
+        this->_releaseSharedBuffer();
+    }
+
+    // The pool keeps the old buffer for any slices still downstream.
+    void _releaseSharedBuffer()
+    {
+        _sharedBuffer = Pothos::BufferChunk();
+        if(_sliceManager) _sliceManager->clearSharedBuffer();
+    }
+
+    void _updateRamp()
+    {
+        generateRamp(_rampStart, _rampStep, _rampLength, MinRampBufferLen, _ramp);
+        this->_restart();
+    }
+
+    // The number of bytes after which the pattern repeats, as a whole number
+    // of output elements, or 0 if it doesn't fit in the shared buffer.
+    size_t _periodBytes(size_t elemSize) const
+    {
+        size_t patternBytes = 0;
+        if("RAMP" == _pattern) patternBytes = _rampLength * sizeof(T);
+        else if("CONSTANT" == _pattern) patternBytes = sizeof(T);
+        else if("PRBS" == _pattern) patternBytes = (std::uint64_t(1) << _prbs.order()) - 1;
+
+        const auto maxBytes = MaxSharedBufferBytes - (SliceElems * elemSize);
+        if((0 == patternBytes) || (patternBytes > maxBytes)) return 0;
+
+        // The least common multiple of the pattern and element sizes
+        size_t a = patternBytes;
+        size_t b = elemSize;
+        while(b > 0)
+        {
+            const auto rem = a % b;
+            a = b;
+            b = rem;
+        }
+        const auto periodBytes = (patternBytes / a) * elemSize;
+
+        return (periodBytes <= maxBytes) ? periodBytes : 0;
+    }
+
+    void _generate(T* out, size_t len)
+    {
+        if("RAMP" == _pattern)
+        {
+            while(len > 0)
+            {
+                const auto chunk = std::min(len, (_ramp.size() - _rampPhase));
+                std::memcpy(out, _ramp.data() + _rampPhase, chunk * sizeof(T));
+
+                out += chunk;
+                len -= chunk;
+                _rampPhase = (_rampPhase + chunk) % _ramp.size();
+            }
+        }
+        else if("CONSTANT" == _pattern)
+        {
+            Word pattern[sizeof(T) / sizeof(Word)];
+            std::memcpy(pattern, &_constant, sizeof(T));
+
+            static constexpr size_t patternLen = sizeof(T) / sizeof(Word);
+            _fcn(pattern, reinterpret_cast<Word*>(out), patternLen, len * patternLen);
+        }
+        else if("PRBS" == _pattern)
+        {
+            _prbs.generateBytes(out, len * sizeof(T));
+        }
+        else
+        {
+            fillRandom(_gen, reinterpret_cast<Scalar*>(out), len * Components);
+        }
+    }
+};
+
+template <typename T>
+constexpr size_t PatternSource<T>::SliceElems;
+
+template <typename T>
+constexpr size_t PatternSource<T>::MaxSharedBufferBytes;
+
+static Pothos::Block* makePatternSource(const Pothos::DType& dtype)
+{
+    #define ifTypeDeclareFactory(T) \
+        if(Pothos::DType::fromDType(dtype, 1) == Pothos::DType(typeid(T))) \
+            return new PatternSource<T>(dtype.dimension()); \
+        if(Pothos::DType::fromDType(dtype, 1) == Pothos::DType(typeid(std::complex<T>))) \
+            return new PatternSource<std::complex<T>>(dtype.dimension());
+
+    ifTypeDeclareFactory(std::int8_t)
+    ifTypeDeclareFactory(std::int16_t)
+    ifTypeDeclareFactory(std::int32_t)
+    ifTypeDeclareFactory(std::int64_t)
+    ifTypeDeclareFactory(std::uint8_t)
+    ifTypeDeclareFactory(std::uint16_t)
+    ifTypeDeclareFactory(std::uint32_t)
+    ifTypeDeclareFactory(std::uint64_t)
+    ifTypeDeclareFactory(float)
+    ifTypeDeclareFactory(double)
+
+    throw Pothos::InvalidArgumentException("Invalid type", dtype.name());
+}
+
+static Pothos::BlockRegistry registerPatternSource(
+    "/blocks/pattern_source",
+    Pothos::Callable(&makePatternSource));
@@ -0,0 +1,71 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+//
+// Ramps shared by the pattern source and checker, so that both sides
+// compute bit-identical values
+//
+
+// Per-component helpers, so complex types apply patterns to both parts
+template <typename T>
+struct PatternTraits
+{
+    using Scalar = T;
+    static constexpr size_t Components = 1;
+};
+
+template <typename T>
+struct PatternTraits<std::complex<T>>
+{
+    using Scalar = T;
+    static constexpr size_t Components = 2;
+};
+
+// Integers wrap around instead of overflowing.
+template <typename Scalar>
+static typename std::enable_if<std::is_integral<Scalar>::value, Scalar>::type rampValue(Scalar start, Scalar step, size_t phase)
+{
+    return Scalar(std::uint64_t(start) + (std::uint64_t(step) * std::uint64_t(phase)));
+}
+
+template <typename Scalar>
+static typename std::enable_if<std::is_floating_point<Scalar>::value, Scalar>::type rampValue(Scalar start, Scalar step, size_t phase)
+{
+    return Scalar(double(start) + (double(step) * double(phase)));
+}
+
+// Fills the output with whole ramps, repeated to at least minLen values.
+template <typename T>
+static void generateRamp(const T& start, const T& step, size_t rampLength, size_t minLen, std::vector<T>& out)
+{
+    using Scalar = typename PatternTraits<T>::Scalar;
+    static constexpr size_t Components = PatternTraits<T>::Components;
+
+    Scalar startComps[Components];
+    Scalar stepComps[Components];
+    std::memcpy(startComps, &start, sizeof(T));
+    std::memcpy(stepComps, &step, sizeof(T));
+
+    const auto numRamps = (minLen + rampLength - 1) / rampLength;
+    out.resize(numRamps * rampLength);
+
+    Scalar value[Components];
+    for(size_t phase = 0; phase < rampLength; ++phase)
+    {
+        for(size_t comp = 0; comp < Components; ++comp) value[comp] = rampValue(startComps[comp], stepComps[comp], phase);
+        std::memcpy(&out[phase], value, sizeof(T));
+    }
+    for(size_t ramp = 1; ramp < numRamps; ++ramp)
+    {
+        std::copy(out.begin(), out.begin() + rampLength, out.begin() + (ramp * rampLength));
+    }
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <xsimd/xsimd.hpp>
+#include <Pothos/Util/XSIMDTraits.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+#include "common/SIMDRegistry.hpp"
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+#include "common/SIMDAlignment.hpp"
+
+namespace PothosBlocksSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    template <typename T>
+    static void fillUnoptimized(const T* pattern, T* out, size_t patternLen, size_t phase, size_t len)
+    {
+        for(size_t elem = 0; elem < len; ++elem)
+        {
+            out[elem] = pattern[(phase + elem) % patternLen];
+        }
+    }
+
+    // Only patterns that evenly divide a register can be repeated with
+    // a single register, so anything else is filled manually.
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, void> fill(const T* pattern, T* out, size_t patternLen, size_t len)
+    {
+        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+        if((0 == patternLen) || (0 != (simdSize % patternLen)))
+        {
+            fillUnoptimized(pattern, out, patternLen, 0, len);
+            return;
+        }
+
+        const auto split = splitForSIMD(out, out, len);
+        fillUnoptimized(pattern, out, patternLen, 0, split.head);
+
+        // The register starts wherever the head left the pattern.
+        T frame[simdSize];
+        fillUnoptimized(pattern, frame, patternLen, split.head, simdSize);
+        const auto frameReg = xsimd::load_unaligned(frame);
+
+        T* bodyOut = out + split.head;
+        if(split.outAligned)
+        {
+            for(size_t elem = 0; elem < split.body; elem += simdSize) frameReg.store_aligned(bodyOut + elem);
+        }
+        else
+        {
+            for(size_t elem = 0; elem < split.body; elem += simdSize) frameReg.store_unaligned(bodyOut + elem);
+        }
+
+        const auto tailOffset = split.head + split.body;
+        fillUnoptimized(pattern, out + tailOffset, patternLen, tailOffset, split.tail);
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, void> fill(const T* pattern, T* out, size_t patternLen, size_t len)
+    {
+        fillUnoptimized(pattern, out, patternLen, 0, len);
+    }
+}
+
+// Fills the output with the pattern repeated, with the given lengths in words.
+template <typename T>
+void fill(const T* pattern, T* out, size_t patternLen, size_t len)
+{
+    detail::fill<T>(pattern, out, patternLen, len);
+}
+
+#define FILL(T) \
+    template void fill<T>(const T*, T*, size_t, size_t); \
+    BLOCKS_SIMD_REGISTER("fill", fill<T>)
+FILL(std::uint8_t)
+FILL(std::uint16_t)
+FILL(std::uint32_t)
+FILL(std::uint64_t)
+
+}}
@@ -0,0 +1,98 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <xsimd/xsimd.hpp>
+#include <Pothos/Util/XSIMDTraits.hpp>
+
+#include <cstdint>
+
+#include "common/SIMDRegistry.hpp"
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+#include "common/SIMDAlignment.hpp"
+
+namespace PothosBlocksSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    template <typename T>
+    static size_t mismatchFindUnoptimized(const T* in, const T* expected, size_t len)
+    {
+        for(size_t elem = 0; elem < len; ++elem)
+        {
+            if(in[elem] != expected[elem]) return elem;
+        }
+
+        return len;
+    }
+
+    // Returns the offset of the first frame with a mismatch, or len if there is none.
+    template <typename T, typename InMode, typename ExpectedMode>
+    static size_t mismatchFindBody(const T* in, const T* expected, size_t len)
+    {
+        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+
+        for(size_t elem = 0; elem < len; elem += simdSize)
+        {
+            const auto inReg = simdLoad(in + elem, InMode());
+            const auto expectedReg = simdLoad(expected + elem, ExpectedMode());
+            if(xsimd::any(inReg != expectedReg)) return elem;
+        }
+
+        return len;
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, size_t> mismatchFind(const T* in, const T* expected, size_t len)
+    {
+        const auto split = splitForSIMD(in, expected, len);
+
+        const auto headIndex = mismatchFindUnoptimized(in, expected, split.head);
+        if(headIndex < split.head) return headIndex;
+
+        const auto* bodyIn = in + split.head;
+        const auto* bodyExpected = expected + split.head;
+
+        size_t bodyOffset;
+        if(split.inAligned)
+        {
+            bodyOffset = split.outAligned ? mismatchFindBody<T, AlignedMode, AlignedMode>(bodyIn, bodyExpected, split.body)
+                                          : mismatchFindBody<T, AlignedMode, UnalignedMode>(bodyIn, bodyExpected, split.body);
+        }
+        else
+        {
+            bodyOffset = split.outAligned ? mismatchFindBody<T, UnalignedMode, AlignedMode>(bodyIn, bodyExpected, split.body)
+                                          : mismatchFindBody<T, UnalignedMode, UnalignedMode>(bodyIn, bodyExpected, split.body);
+        }
+
+        // Find the exact index in the mismatched frame, or search the
+        // remaining elements manually.
+        const size_t offset = split.head + bodyOffset;
+
+        return offset + mismatchFindUnoptimized(in + offset, expected + offset, (len - offset));
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, size_t> mismatchFind(const T* in, const T* expected, size_t len)
+    {
+        return mismatchFindUnoptimized(in, expected, len);
+    }
+}
+
+// Returns the index of the first element that differs from the expected
+// element, or len if there is none.
+template <typename T>
+size_t mismatchFind(const T* in, const T* expected, size_t len)
+{
+    return detail::mismatchFind<T>(in, expected, len);
+}
+
+#define MISMATCH_FIND(T) \
+    template size_t mismatchFind<T>(const T*, const T*, size_t); \
+    BLOCKS_SIMD_REGISTER("mismatchFind", mismatchFind<T>)
+MISMATCH_FIND(std::uint8_t)
+
+}}
@@ -0,0 +1,111 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "SharedSliceBufferManager.hpp"
+
+SharedSliceBufferManager::SharedSliceBufferManager():
+    Pothos::BufferManager(),
+    _periodBytes(0),
+    _sliceBytes(0),
+    _offset(0)
+{}
+
+SharedSliceBufferManager::~SharedSliceBufferManager(){}
+
+void SharedSliceBufferManager::init(const Pothos::BufferManagerArgs& args)
+{
+    Pothos::BufferManager::init(args);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _sharedBySlab.resize(args.numBuffers);
+    for(size_t slab = 0; slab < args.numBuffers; ++slab)
+    {
+        Pothos::ManagedBuffer managedBuffer;
+        managedBuffer.reset(
+            this->shared_from_this(),
+            Pothos::SharedBuffer::make(args.bufferSize, args.nodeAffinity),
+            slab);
+        _queue.push_back(managedBuffer);
+    }
+
+    this->_updateFront();
+}
+
+bool SharedSliceBufferManager::empty() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _queue.empty();
+}
+
+void SharedSliceBufferManager::pop(const size_t numBytes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if(_queue.empty()) throw Pothos::LogicException("SharedSliceBufferManager::pop() with no buffers");
+
+    _sharedBySlab[_queue.front().getSlabIndex()] = _shared;
+    _queue.pop_front();
+    if(_shared) _offset = (_offset + numBytes) % _periodBytes;
+
+    this->_updateFront();
+}
+
+void SharedSliceBufferManager::push(const Pothos::ManagedBuffer& managedBuffer)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Every slice of this pool buffer has been released.
+    _sharedBySlab[managedBuffer.getSlabIndex()] = Pothos::BufferChunk();
+    _queue.push_back(managedBuffer);
+
+    if(1 == _queue.size()) this->_updateFront();
+}
+
+void SharedSliceBufferManager::setSharedBuffer(const Pothos::BufferChunk& shared, size_t periodBytes, size_t sliceBytes)
+{
+    if((0 == periodBytes) || (shared.length < (periodBytes + sliceBytes)))
+    {
+        throw Pothos::RangeException("SharedSliceBufferManager::setSharedBuffer()", "shared buffer too short for its period");
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _shared = shared;
+    _periodBytes = periodBytes;
+    _sliceBytes = sliceBytes;
+    _offset = 0;
+
+    this->_updateFront();
+}
+
+void SharedSliceBufferManager::clearSharedBuffer()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _shared = Pothos::BufferChunk();
+    _periodBytes = 0;
+    _sliceBytes = 0;
+    _offset = 0;
+
+    this->_updateFront();
+}
+
+void SharedSliceBufferManager::_updateFront()
+{
+    if(_queue.empty())
+    {
+        this->setFrontBuffer(Pothos::BufferChunk::null());
+        return;
+    }
+
+    Pothos::BufferChunk front(_queue.front());
+    if(_shared)
+    {
+        front.address = _shared.address + _offset;
+        front.length = _sliceBytes;
+    }
+
+    this->setFrontBuffer(front);
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <Pothos/Framework.hpp>
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+//
+// Output buffer pool for the tester sources' zero-copy mode
+//
+// Without a shared buffer, this is a plain pool. With one, each front buffer
+// is a slice of the shared buffer, starting where the last one ended, modulo
+// the period. The pool buffers still travel downstream with the slices and
+// come back when released, so the pool size bounds how many slices are
+// downstream, and a released slice wakes the block, with no polling.
+//
+// A slice shares the pool buffer's container, which the pool also holds, so
+// it is never unique downstream, and blocks that work in-place make their
+// own copy instead of writing to the shared buffer.
+//
+
+class SharedSliceBufferManager: public Pothos::BufferManager
+{
+    public:
+        using SPtr = std::shared_ptr<SharedSliceBufferManager>;
+
+        SharedSliceBufferManager();
+        virtual ~SharedSliceBufferManager();
+
+        void init(const Pothos::BufferManagerArgs& args) override;
+        bool empty() const override;
+        void pop(const size_t numBytes) override;
+        void push(const Pothos::ManagedBuffer& managedBuffer) override;
+
+        // The shared buffer must hold a slice past the end of its last period.
+        // It is kept alive until every slice of it has been released.
+        void setSharedBuffer(const Pothos::BufferChunk& shared, size_t periodBytes, size_t sliceBytes);
+        void clearSharedBuffer();
+
+    private:
+        mutable std::mutex _mutex;
+
+        std::deque<Pothos::ManagedBuffer> _queue;
+
+        // The shared buffer each pool buffer's slice points into
+        std::vector<Pothos::BufferChunk> _sharedBySlab;
+
+        Pothos::BufferChunk _shared;
+        size_t _periodBytes;
+        size_t _sliceBytes;
+        size_t _offset;
+
+        void _updateFront();
+};
@@ -1,9 +1,11 @@
 // Copyright (c) 2015-2017 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "common/Random.hpp"
+
 #include <Pothos/Framework.hpp>
+#include <cstdint>
 #include <iostream>
-#include <random>
 
 /***********************************************************************
  * |PothosDoc Sporadic Dropper
@@ -12,6 +14,8 @@
  * to output port 0 while randomly dropping entire buffers or messages.
  * This block is mainly used for recovery tolerance testing.
  *
+ * The generator is randomly seeded. Call setSeed() for reproducible runs.
+ *
  * |category /Testers
  * |category /Random
  * |keywords random drop
@@ -32,14 +36,14 @@ public:
     }
 
     SporadicDropper(void):
-        _gen(_rd()),
-        _randomProb(0.0, 1.0),
+        _gen(),
         _probability(0.0)
     {
         this->setupInput(0);
         this->setupOutput(0, "", this->uid()); //unique domain because of buffer forwarding
         this->registerCall(this, POTHOS_FCN_TUPLE(SporadicDropper, setProbability));
         this->registerCall(this, POTHOS_FCN_TUPLE(SporadicDropper, getProbability));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SporadicDropper, setSeed));
     }
 
     void setProbability(const double prob)
@@ -54,13 +58,18 @@ public:
         return _probability;
     }
 
+    void setSeed(const std::uint64_t seed)
+    {
+        _gen.seed(seed);
+    }
+
     void work(void)
     {
         auto inputPort = this->input(0);
         auto outputPort = this->output(0);
 
         //calculate if a drop will occur
-        const bool drop = (_randomProb(_gen) <= _probability);
+        const bool drop = (_gen.uniform() < _probability);
 
         //randomly drop the input message if available
         if (inputPort->hasMessage())
@@ -85,9 +94,7 @@ public:
     }
 
 private:
-    std::random_device _rd;
-    std::mt19937 _gen;
-    std::uniform_real_distribution<double> _randomProb;
+    BlocksRandom::Xoshiro256 _gen;
 
     double _probability;
 };
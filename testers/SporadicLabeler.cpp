@@ -1,8 +1,12 @@
 // Copyright (c) 2014-2017 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "common/Random.hpp"
+
 #include <Pothos/Framework.hpp>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <random>
 
 /***********************************************************************
@@ -12,6 +16,10 @@
  * to output port 0 while randomly inserts labels at irregular intervals.
  * This block is mainly used for testing other blocks that deal with labels.
  *
+ * Rather than drawing a random number per element, the labeler draws the
+ * distance to the next label, so the cost scales with the number of labels.
+ * Use setSeed() to get the same labels on every run.
+ *
  * |category /Testers
  * |category /Random
  * |category /Labels
@@ -38,9 +46,9 @@ public:
     }
 
     SporadicLabeler(void):
-        _gen(_rd()),
-        _randomProb(0.0, 1.0),
-        _probability(0.0)
+        _gen(),
+        _probability(0.0),
+        _untilLabel(std::numeric_limits<size_t>::max())
     {
         this->setupInput(0);
         this->setupOutput(0, "", this->uid()); //unique domain because of buffer forwarding
@@ -48,6 +56,7 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(SporadicLabeler, getProbability));
         this->registerCall(this, POTHOS_FCN_TUPLE(SporadicLabeler, setIdList));
         this->registerCall(this, POTHOS_FCN_TUPLE(SporadicLabeler, getIdList));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SporadicLabeler, setSeed));
     }
 
     void setProbability(const double prob)
@@ -55,6 +64,7 @@ public:
         if (prob > 1.0 or prob < 0.0) throw Pothos::RangeException(
             "SporadicLabeler::setProbability("+std::to_string(prob)+")", "probability not in [0.0, 1.0]");
         _probability = prob;
+        _untilLabel = _gen.geometric(_probability);
     }
 
     double getProbability(void) const
@@ -74,6 +84,12 @@ public:
         return _ids;
     }
 
+    void setSeed(const std::uint64_t seed)
+    {
+        _gen.seed(seed);
+        _untilLabel = _gen.geometric(_probability);
+    }
+
     void work(void)
     {
         auto inputPort = this->input(0);
@@ -88,31 +104,34 @@ public:
         const auto &buffer = inputPort->takeBuffer();
         if (buffer.length != 0)
         {
-            inputPort->consume(inputPort->elements());
+            const size_t elems = inputPort->elements();
+            inputPort->consume(elems);
 
-            for (size_t i = 0; i < inputPort->elements(); i++)
+            //jump from label to label, carrying the distance across buffers
+            while (_untilLabel < elems)
             {
-                if (_randomProb(_gen) <= _probability)
-                {
-                    Pothos::Label label;
-                    label.index = i;
-                    label.width = buffer.dtype.size();
-                    if (not _ids.empty()) label.id = _ids.at(_randomId(_gen));
-                    outputPort->postLabel(std::move(label));
-                }
+                Pothos::Label label;
+                label.index = _untilLabel;
+                label.width = buffer.dtype.size();
+                if (not _ids.empty()) label.id = _ids.at(_randomId(_gen));
+                outputPort->postLabel(std::move(label));
+
+                const size_t skip = _gen.geometric(_probability);
+                _untilLabel = (skip < std::numeric_limits<size_t>::max() - _untilLabel - 1)?
+                    (_untilLabel + 1 + skip) : std::numeric_limits<size_t>::max();
             }
+            if (_untilLabel != std::numeric_limits<size_t>::max()) _untilLabel -= elems;
 
             outputPort->postBuffer(std::move(buffer));
         }
     }
 
 private:
-    std::random_device _rd;
-    std::mt19937 _gen;
+    BlocksRandom::Xoshiro256 _gen;
     std::uniform_int_distribution<size_t> _randomId;
-    std::uniform_real_distribution<double> _randomProb;
 
     double _probability;
+    size_t _untilLabel; //elements before the next label
     std::vector<std::string> _ids;
 };
 
@@ -1,11 +1,13 @@
 // Copyright (c) 2020 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
+#include "common/Random.hpp"
+
 #include <Pothos/Framework.hpp>
 
+#include <cstdint>
 #include <cstring>
 #include <limits>
-#include <random>
 
 template <typename T>
 using CheckFcn = bool(*)(T);
@@ -27,8 +29,7 @@ class SporadicSubnormal: public Pothos::Block
 {
 public:
     SporadicSubnormal(T subVal, CheckFcn<T> checkFcn, const std::string& subName):
-        _gen(_rd()),
-        _randomProb(0.0, 1.0),
+        _gen(),
         _subVal(subVal),
         _checkFcn(checkFcn),
         _probability(0.0),
@@ -42,6 +43,7 @@ public:
         this->setupOutput(0, dtype);
         this->registerCall(this, POTHOS_FCN_TUPLE(Class, probability));
         this->registerCall(this, POTHOS_FCN_TUPLE(Class, setProbability));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Class, setSeed));
 
         // Generate the getter/setter function names to expose.
 
@@ -81,6 +83,11 @@ public:
         _numSubs = numSubs;
     }
 
+    void setSeed(std::uint64_t seed)
+    {
+        _gen.seed(seed);
+    }
+
     void work() override
     {
         auto inputPort = this->input(0);
@@ -98,7 +105,7 @@ public:
             outBuff.length);
 
         // Calculate if a NaN will be injected.
-        const bool insertNaN = (_randomProb(_gen) <= _probability);
+        const bool insertNaN = (_gen.uniform() < _probability);
         if(insertNaN)
         {
             // Scatter NaNs around the buffer.
@@ -108,7 +115,7 @@ public:
                 size_t index = 0;
                 do
                 {
-                    index = static_cast<size_t>(outBuff.elements() * _randomProb(_gen));
+                    index = static_cast<size_t>(outBuff.elements() * _gen.uniform());
                 } while(_checkFcn(outBuff.template as<T*>()[index]));
 
                 outBuff.template as<T*>()[index] = _subVal;
@@ -122,9 +129,7 @@ public:
     }
 
 private:
-    std::random_device _rd;
-    std::mt19937 _gen;
-    std::uniform_real_distribution<double> _randomProb;
+    BlocksRandom::Xoshiro256 _gen;
 
     T _subVal;
     CheckFcn<T> _checkFcn;
@@ -0,0 +1,331 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include "common/Random.hpp"
+
+#include <Pothos/Framework.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <json.hpp>
+
+//http://stackoverflow.com/questions/440133/how-do-i-create-a-random-alpha-numeric-string-in-c
+static std::string random_string(BlocksRandom::Xoshiro256 &rg, size_t length)
+{
+    static const std::string alphanums =
+        "0123456789"
+        "abcdefghijklmnopqrstuvwxyz"
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    std::string s;
+
+    s.reserve(length);
+
+    while(length--)
+        s += alphanums[rg.below(alphanums.size())];
+
+    return s;
+}
+
+/***********************************************************************
+ * Streaming test plans generate the same kinds of data as regular test
+ * plans, but a buffer at a time, from a seed and the plan parameters.
+ * The feeder source generates the data as it produces output, and the
+ * collector sink generates it again to check its input as it arrives,
+ * so neither side ever holds more than one buffer of the plan.
+ *
+ * The expected result is the descriptor from makeStreamingTestPlan():
+ * the seed, and the parameters with their defaults filled in.
+ *
+ * Buffer sizes, values, labels, and messages each come from their own
+ * generator, so each kind can be regenerated without the others.
+ * Labels are spread over the buffers as they are generated, instead of
+ * over the whole stream at once.
+ *
+ * Every draw comes straight from the xoshiro256++ bits, not from the
+ * standard distributions, whose results differ between standard
+ * libraries, so a descriptor means the same data on any host.
+ * Floating point values are integers scaled by 1/256, so they match too.
+ **********************************************************************/
+inline nlohmann::json makeStreamingTestPlan(const nlohmann::json &testPlan, const Pothos::DType &dtype, const std::uint64_t seed)
+{
+    //defaults, the same as for regular test plans,
+    //except that values cover the whole range of the type
+    const int minTrials = testPlan.value("minTrials", 10);
+    const int maxTrials = testPlan.value("maxTrials", 100);
+    const int minSize = testPlan.value("minSize", 10);
+    const int maxSize = testPlan.value("maxSize", 100);
+    const double valueSize = std::ldexp(1.0, int(dtype.size()*8));
+    const double signedOff = dtype.isSigned()?valueSize/2:0;
+
+    nlohmann::json plan(nlohmann::json::object());
+    plan["seed"] = seed;
+    plan["dtype"] = dtype.toMarkup();
+    plan["enableBuffers"] = testPlan.value("enableBuffers", false);
+    plan["enableLabels"] = testPlan.value("enableLabels", false);
+    plan["enableMessages"] = testPlan.value("enableMessages", false);
+    plan["enablePackets"] = testPlan.value("enablePackets", false);
+    plan["minBuffers"] = testPlan.value("minBuffers", minTrials);
+    plan["maxBuffers"] = testPlan.value("maxBuffers", maxTrials);
+    plan["minBufferElements"] = testPlan.value("minBufferSize", minSize)/int(dtype.size());
+    plan["maxBufferElements"] = testPlan.value("maxBufferSize", maxSize)/int(dtype.size());
+    plan["minValue"] = testPlan.value("minValue", -signedOff);
+    plan["maxValue"] = testPlan.value("maxValue", valueSize-signedOff-1);
+    plan["totalMultiple"] = testPlan.value("totalMultiple", 1);
+    plan["bufferMultiple"] = testPlan.value("bufferMultiple", 1);
+    plan["minLabels"] = testPlan.value("minLabels", minTrials);
+    plan["maxLabels"] = testPlan.value("maxLabels", maxTrials);
+    plan["minLabelSize"] = testPlan.value("minLabelSize", minSize);
+    plan["maxLabelSize"] = testPlan.value("maxLabelSize", maxSize);
+    plan["minMessages"] = testPlan.value("minMessages", minTrials);
+    plan["maxMessages"] = testPlan.value("maxMessages", maxTrials);
+    plan["minMessageSize"] = testPlan.value("minMessageSize", minSize);
+    plan["maxMessageSize"] = testPlan.value("maxMessageSize", maxSize);
+    return plan;
+}
+
+class StreamingTestPlan
+{
+public:
+    StreamingTestPlan(const nlohmann::json &plan):
+        _totals(plan),
+        _dtype(plan["dtype"].get<std::string>()),
+        _enableBuffers(plan["enableBuffers"]),
+        _enableLabels(plan["enableLabels"]),
+        _enableMessages(plan["enableMessages"]),
+        _enablePackets(plan["enablePackets"]),
+        _valueSizes(plan, _totals.numBuffers, _totals.seed+1),
+        _valueGen(_totals.seed+2),
+        _valuesLeft(0),
+        _labelSizes(plan, _totals.numBuffers, _totals.seed+1),
+        _labelGen(_totals.seed+3),
+        _minLabelSize(plan["minLabelSize"]),
+        _maxLabelSize(plan["maxLabelSize"]),
+        _labelsLeft(_totals.numLabels),
+        _messageGen(_totals.seed+4),
+        _minMessageSize(plan["minMessageSize"]),
+        _maxMessageSize(plan["maxMessageSize"]),
+        _messagesLeft(_totals.numMessages)
+    {
+        //integers are drawn directly, floats in steps of 1/256
+        const double scale = _dtype.isFloat()?256.0:1.0;
+        _minValue = std::int64_t(std::ceil(plan["minValue"].get<double>()*scale));
+        _maxValue = std::max(_minValue, std::int64_t(std::floor(plan["maxValue"].get<double>()*scale)));
+
+        if (_dtype.size() != 1 and _dtype.size() != 2 and _dtype.size() != 4) throw Pothos::AssertionViolationException(
+            "StreamingTestPlan()", "cant handle this dtype: " + _dtype.toString());
+    }
+
+    const Pothos::DType &dtype(void) const
+    {
+        return _dtype;
+    }
+
+    //buffers go out as packet payloads when packets are enabled
+    bool buffers(void) const
+    {
+        return _enableBuffers and not _enablePackets;
+    }
+
+    bool packets(void) const
+    {
+        return _enablePackets;
+    }
+
+    bool labels(void) const
+    {
+        return _enableLabels;
+    }
+
+    bool messages(void) const
+    {
+        return _enableMessages;
+    }
+
+    //starts the next buffer, false after the last buffer,
+    //any values left in the previous buffer are skipped
+    bool nextBuffer(size_t &numElems)
+    {
+        int num = 0;
+        if (not _valueSizes.next(num)) return false;
+        numElems = size_t(num);
+        _valuesLeft = numElems;
+        return true;
+    }
+
+    //generates the next values of the current buffer,
+    //no more than are left in it, into out
+    void nextValues(void *out, const size_t numElems)
+    {
+        if (numElems > _valuesLeft) throw Pothos::AssertionViolationException(
+            "StreamingTestPlan::nextValues()", "past the end of the buffer");
+        _valuesLeft -= numElems;
+
+        const auto range = std::uint64_t(_maxValue - _minValue) + 1;
+        for (size_t i = 0; i < numElems; i++)
+        {
+            const auto value = _minValue + std::int64_t(_valueGen.below(range));
+            if (_dtype.size() == 1) static_cast<char *>(out)[i] = char(value);
+            else if (_dtype.size() == 2) static_cast<short *>(out)[i] = short(value);
+            else if (_dtype.isFloat()) static_cast<float *>(out)[i] = float(value)/256.0f;
+            else static_cast<int *>(out)[i] = int(value);
+        }
+    }
+
+    //the labels of the next buffer, indexed from the start of the buffer,
+    //and where the buffer starts in the plan, false after the last buffer
+    bool nextLabels(std::vector<Pothos::Label> &labels, unsigned long long &offset)
+    {
+        labels.clear();
+        offset = _labelSizes.total();
+
+        const size_t buffersLeft = _labelSizes.remaining();
+        int numElems = 0;
+        if (not _labelSizes.next(numElems)) return false;
+        if (_labelsLeft == 0 or numElems == 0) return true;
+
+        //about an even share of the labels that are left,
+        //and the last buffer takes whatever remains
+        size_t numLabels = _labelsLeft;
+        if (buffersLeft > 1) numLabels = std::min(_labelsLeft, size_t(_labelGen.below(2*_labelsLeft/buffersLeft + 1)));
+        _labelsLeft -= numLabels;
+
+        //generate random label indexes and sort them
+        std::vector<size_t> indexes;
+        for (size_t lblno = 0; lblno < numLabels; lblno++) indexes.push_back(_labelGen.below(numElems));
+        std::sort(indexes.begin(), indexes.end());
+        indexes.erase(std::unique(indexes.begin(), indexes.end()), indexes.end());
+
+        for (const auto index : indexes)
+        {
+            auto data = random_string(_labelGen, drawBetween(_labelGen, _minLabelSize, _maxLabelSize));
+            labels.emplace_back("id"+std::to_string(offset+index), data, index);
+        }
+        return true;
+    }
+
+    //false after the last message
+    bool nextMessage(std::string &message)
+    {
+        if (_messagesLeft == 0) return false;
+        _messagesLeft--;
+        message = random_string(_messageGen, drawBetween(_messageGen, _minMessageSize, _maxMessageSize));
+        return true;
+    }
+
+private:
+    //uniform in [min, max]
+    static int drawBetween(BlocksRandom::Xoshiro256 &gen, const int min, const int max)
+    {
+        if (max <= min) return min;
+        return min + int(gen.below(std::uint64_t(max - min) + 1));
+    }
+
+    //the totals come first from the seed, so every generator agrees on them
+    struct Totals
+    {
+        Totals(const nlohmann::json &plan):
+            seed(plan["seed"])
+        {
+            BlocksRandom::Xoshiro256 gen(seed);
+            const size_t buffers = drawBetween(gen, plan["minBuffers"], plan["maxBuffers"]);
+            const size_t labels = drawBetween(gen, plan["minLabels"], plan["maxLabels"]);
+            const size_t messages = drawBetween(gen, plan["minMessages"], plan["maxMessages"]);
+            numBuffers = (plan["enableBuffers"].get<bool>() or plan["enablePackets"].get<bool>())?buffers:0;
+            numLabels = plan["enableLabels"].get<bool>()?labels:0;
+            numMessages = plan["enableMessages"].get<bool>()?messages:0;
+        }
+
+        std::uint64_t seed;
+        size_t numBuffers;
+        size_t numLabels;
+        size_t numMessages;
+    };
+
+    //the number of elements in each buffer
+    class BufferSizes
+    {
+    public:
+        BufferSizes(const nlohmann::json &plan, const size_t numBuffers, const std::uint64_t seed):
+            _gen(seed),
+            _minElements(plan["minBufferElements"]),
+            _maxElements(plan["maxBufferElements"]),
+            _numBuffers(numBuffers),
+            _bufno(0),
+            _total(0),
+            _totalMultiple(plan["totalMultiple"]),
+            _bufferMultiple(plan["bufferMultiple"])
+        {}
+
+        bool next(int &numElems)
+        {
+            if (_bufno == _numBuffers) return false;
+            numElems = drawBetween(_gen, _minElements, _maxElements);
+
+            //round up to multiple and re-enforce the bounds
+            numElems = ((numElems + _bufferMultiple - 1)/_bufferMultiple)*_bufferMultiple;
+            if (numElems > _maxElements) numElems -= _bufferMultiple;
+            if (numElems < _minElements) numElems += _bufferMultiple;
+
+            //pad last buffer to multiple when specified
+            if ((_bufno+1) == _numBuffers)
+            {
+                const size_t extra = (_total + numElems) % _totalMultiple;
+                if (extra != 0) numElems += _totalMultiple - extra;
+            }
+
+            _total += numElems;
+            _bufno++;
+            return true;
+        }
+
+        size_t remaining(void) const
+        {
+            return _numBuffers - _bufno;
+        }
+
+        unsigned long long total(void) const
+        {
+            return _total;
+        }
+
+    private:
+        BlocksRandom::Xoshiro256 _gen;
+        int _minElements;
+        int _maxElements;
+        size_t _numBuffers;
+        size_t _bufno;
+        unsigned long long _total;
+        int _totalMultiple;
+        int _bufferMultiple;
+    };
+
+    const Totals _totals;
+
+    Pothos::DType _dtype;
+    bool _enableBuffers;
+    bool _enableLabels;
+    bool _enableMessages;
+    bool _enablePackets;
+
+    BufferSizes _valueSizes;
+    BlocksRandom::Xoshiro256 _valueGen;
+    std::int64_t _minValue;
+    std::int64_t _maxValue;
+    size_t _valuesLeft;
+
+    BufferSizes _labelSizes;
+    BlocksRandom::Xoshiro256 _labelGen;
+    int _minLabelSize;
+    int _maxLabelSize;
+    size_t _labelsLeft;
+
+    BlocksRandom::Xoshiro256 _messageGen;
+    int _minMessageSize;
+    int _maxMessageSize;
+    size_t _messagesLeft;
+};
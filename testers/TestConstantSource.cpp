@@ -9,17 +9,21 @@
 
 #include <algorithm>
 #include <complex>
+#include <cstdint>
 #include <iostream>
+#include <vector>
 
 template <typename T>
-static void testConstantSource(const T& constant)
+static void testConstantSource(const T& constant, size_t dimension, bool zeroCopy)
 {
-    const Pothos::DType dtype(typeid(T));
+    const Pothos::DType dtype(typeid(T), dimension);
     const T Zero(0);
 
-    std::cout << "Testing " << dtype.name() << "..." << std::endl;
+    std::cout << "Testing " << dtype.name() << " (zero copy: " << zeroCopy << ")..." << std::endl;
 
     auto constantSource = Pothos::BlockRegistry::make("/blocks/constant_source", dtype);
+    constantSource.call("setZeroCopy", zeroCopy);
+    POTHOS_TEST_EQUAL(zeroCopy, constantSource.call<bool>("zeroCopy"));
 
     // Test the default value.
     POTHOS_TEST_EQUAL(Zero, constantSource.call<T>("constant"));
@@ -54,7 +58,7 @@ static void testConstantSource(const T& constant)
     POTHOS_TEST_TRUE(buffer.elements() > 0);
 
     const auto* begin = buffer.as<const T*>();
-    const auto* end = buffer.as<const T*>() + buffer.elements();
+    const auto* end = buffer.as<const T*>() + (buffer.elements() * dimension);
     auto iter = std::find_if(
                     begin,
                     end,
@@ -67,6 +71,18 @@ static void testConstantSource(const T& constant)
     POTHOS_TEST_EQUAL(constant, messages[0].extract<T>());
 }
 
+template <typename T>
+static void testConstantSource(const T& constant)
+{
+    for(bool zeroCopy: {false, true})
+    {
+        testConstantSource<T>(constant, 1, zeroCopy);
+
+        // Odd dimensions keep the fill pattern from evenly dividing a register.
+        testConstantSource<T>(constant, 3, zeroCopy);
+    }
+}
+
 POTHOS_TEST_BLOCK("/blocks/tests", test_constant_source)
 {
     testConstantSource<std::int8_t>(-123);
@@ -91,3 +107,47 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_constant_source)
     testConstantSource<std::complex<float>>({0.123456789f,0.987654321f});
     testConstantSource<std::complex<double>>({0.987654321,0.123456789});
 }
+
+// Slices are shared, so a block downstream that works in-place must copy them
+// instead of rewriting the constant under later slices.
+POTHOS_TEST_BLOCK("/blocks/tests", test_constant_source_in_place_downstream)
+{
+    const Pothos::DType dtype("uint16");
+    const std::uint16_t constant = 0x1234;
+    const std::uint16_t swapped = 0x3412;
+
+    auto constantSource = Pothos::BlockRegistry::make("/blocks/constant_source", dtype);
+    constantSource.call("setZeroCopy", true);
+    constantSource.call("setConstant", constant);
+
+    auto streamToPacket = Pothos::BlockRegistry::make("/blocks/stream_to_packet");
+    auto byteSwap = Pothos::BlockRegistry::make("/blocks/byteswap", dtype);
+    auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+    {
+        Pothos::Topology topology;
+
+        topology.connect(constantSource, 0, streamToPacket, 0);
+        topology.connect(streamToPacket, 0, byteSwap, 0);
+        topology.connect(byteSwap, 0, collectorSink, 0);
+
+        topology.commit();
+        Poco::Thread::sleep(10);
+    }
+
+    const auto packets = collectorSink.call<std::vector<Pothos::Packet>>("getPackets");
+    POTHOS_TEST_TRUE(packets.size() > 1);
+
+    for(const auto& packet: packets)
+    {
+        POTHOS_TEST_TRUE(packet.payload.elements() > 0);
+
+        const auto* begin = packet.payload.as<const std::uint16_t*>();
+        const auto* end = begin + packet.payload.elements();
+        auto iter = std::find_if(
+                        begin,
+                        end,
+                        [&swapped](std::uint16_t val){return (val != swapped);});
+        POTHOS_TEST_EQUAL(end, iter);
+    }
+}
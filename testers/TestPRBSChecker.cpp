@@ -0,0 +1,162 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "RampPattern.hpp"
+
+#include "common/PRBS.hpp"
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static void runChecker(const Pothos::Proxy& source, const Pothos::Proxy& checker)
+{
+    Pothos::Topology topology;
+    topology.connect(source, 0, checker, 0);
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_prbs_checker_prbs)
+{
+    static constexpr size_t NumBytes = 100000;
+    static constexpr size_t GapIndex = 50000;
+    static constexpr size_t GapBytes = 6;
+
+    std::vector<std::uint8_t> bytes(NumBytes);
+    BlocksPRBS::Generator generator(23, 1234);
+    generator.generateBytes(bytes.data(), bytes.size());
+
+    // Single bit errors well before and after the gap, where the checker is locked
+    size_t numFlips = 0;
+    for(size_t byte = 10000; byte < 20000; byte += 997, ++numFlips) bytes[byte] ^= 0x04;
+    for(size_t byte = 80000; byte < 90000; byte += 1009, ++numFlips) bytes[byte] ^= 0x80;
+
+    bytes.erase(bytes.begin() + GapIndex, bytes.begin() + GapIndex + GapBytes);
+
+    Pothos::BufferChunk input("uint16", bytes.size() / 2);
+    std::memcpy(input.as<void*>(), bytes.data(), input.length);
+
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint16");
+    feeder.call("feedBuffer", input);
+
+    auto checker = Pothos::BlockRegistry::make("/blocks/prbs_checker", "uint16");
+    checker.call("setPRBSOrder", 23);
+    POTHOS_TEST_THROWS(checker.call("setPRBSOrder", 8), Pothos::InvalidArgumentException);
+    POTHOS_TEST_THROWS(checker.call("setPattern", "SQUARE"), Pothos::InvalidArgumentException);
+    POTHOS_TEST_THROWS(checker.call("setLossThreshold", 0.0), Pothos::RangeException);
+
+    runChecker(feeder, checker);
+
+    std::cout << "Bits checked: " << checker.call<unsigned long long>("bitsChecked") << std::endl;
+    POTHOS_TEST_TRUE(checker.call<bool>("locked"));
+    POTHOS_TEST_EQUAL(1, checker.call<unsigned long long>("resyncs"));
+    POTHOS_TEST_EQUAL(numFlips, checker.call<unsigned long long>("bitErrors"));
+    POTHOS_TEST_EQUAL(numFlips, checker.call<unsigned long long>("elementErrors"));
+    POTHOS_TEST_TRUE(checker.call<unsigned long long>("bitsChecked") > (8 * (NumBytes / 2)));
+    POTHOS_TEST_TRUE(checker.call<double>("bitErrorRate") > 0.0);
+
+    checker.call("reset");
+    POTHOS_TEST_TRUE(!checker.call<bool>("locked"));
+    POTHOS_TEST_EQUAL(0, checker.call<unsigned long long>("bitsChecked"));
+    POTHOS_TEST_EQUAL(0, checker.call<unsigned long long>("bitErrors"));
+
+    //
+    // Zero-copy output from the pattern source continues between buffers
+    //
+
+    auto patternSource = Pothos::BlockRegistry::make("/blocks/pattern_source", "uint16");
+    patternSource.call("setPattern", "PRBS");
+    patternSource.call("setPRBSOrder", 15);
+    patternSource.call("setZeroCopy", true);
+    checker.call("setPRBSOrder", 15);
+    {
+        Pothos::Topology topology;
+        topology.connect(patternSource, 0, checker, 0);
+        topology.commit();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    POTHOS_TEST_TRUE(checker.call<bool>("locked"));
+    POTHOS_TEST_TRUE(checker.call<unsigned long long>("bitsChecked") > 0);
+    POTHOS_TEST_EQUAL(0, checker.call<unsigned long long>("resyncs"));
+    POTHOS_TEST_EQUAL(0, checker.call<unsigned long long>("bitErrors"));
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_prbs_checker_ramp)
+{
+    static constexpr size_t RampLength = 300;
+
+    const std::int16_t rampStart = -100;
+    const std::int16_t rampStep = 3;
+
+    auto checker = Pothos::BlockRegistry::make("/blocks/prbs_checker", "int16");
+    checker.call("setPattern", "RAMP");
+    checker.call("setRampStart", rampStart);
+    checker.call("setRampStep", rampStep);
+    checker.call("setRampLength", RampLength);
+
+    //
+    // A gapless ramp from the pattern source
+    //
+
+    auto patternSource = Pothos::BlockRegistry::make("/blocks/pattern_source", "int16");
+    patternSource.call("setRampStart", rampStart);
+    patternSource.call("setRampStep", rampStep);
+    patternSource.call("setRampLength", RampLength);
+    {
+        Pothos::Topology topology;
+        topology.connect(patternSource, 0, checker, 0);
+        topology.commit();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    POTHOS_TEST_TRUE(checker.call<bool>("locked"));
+    POTHOS_TEST_TRUE(checker.call<unsigned long long>("elementsChecked") > 0);
+    POTHOS_TEST_EQUAL(0, checker.call<unsigned long long>("bitErrors"));
+    POTHOS_TEST_EQUAL(0, checker.call<unsigned long long>("gaps"));
+
+    //
+    // A ramp with known gaps and errors, starting mid-ramp
+    //
+
+    std::vector<std::int16_t> ramp;
+    generateRamp(rampStart, rampStep, RampLength, 1, ramp);
+
+    std::vector<std::int16_t> values;
+    size_t phase = 123;
+    for(size_t elem = 0; elem < 20000; ++elem)
+    {
+        values.push_back(ramp[phase]);
+        phase = (phase + 1) % RampLength;
+
+        if(5000 == elem) phase = (phase + 10) % RampLength;
+        if(12000 == elem) phase = (phase + (RampLength - 1)) % RampLength;
+    }
+    // Ramp values are all 2 mod 3, so these errors can't be mistaken for gaps.
+    values[8000] ^= 0x0001;
+    values[9000] ^= 0x0002;
+    values[15000] ^= 0x0001;
+
+    Pothos::BufferChunk input("int16", values.size());
+    std::memcpy(input.as<void*>(), values.data(), input.length);
+
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int16");
+    feeder.call("feedBuffer", input);
+
+    runChecker(feeder, checker);
+
+    POTHOS_TEST_TRUE(checker.call<bool>("locked"));
+    POTHOS_TEST_EQUAL(0, checker.call<unsigned long long>("resyncs"));
+    POTHOS_TEST_EQUAL(3, checker.call<unsigned long long>("bitErrors"));
+    POTHOS_TEST_EQUAL(3, checker.call<unsigned long long>("elementErrors"));
+    POTHOS_TEST_EQUAL(2, checker.call<unsigned long long>("gaps"));
+    POTHOS_TEST_EQUAL(10 + (RampLength - 1), checker.call<unsigned long long>("gapElements"));
+}
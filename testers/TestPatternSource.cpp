@@ -0,0 +1,173 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "common/PRBS.hpp"
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static Pothos::BufferChunk runPatternSource(const Pothos::Proxy& patternSource, const Pothos::DType& dtype)
+{
+    auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+    {
+        Pothos::Topology topology;
+        topology.connect(patternSource, 0, collectorSink, 0);
+        topology.commit();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    auto buffer = collectorSink.call<Pothos::BufferChunk>("getBuffer");
+    POTHOS_TEST_TRUE(buffer.dtype == dtype);
+    POTHOS_TEST_TRUE(buffer.elements() > 0);
+
+    return buffer;
+}
+
+template <typename T>
+static void testPatternSource(const T& rampStart, const T& rampStep, bool zeroCopy)
+{
+    const Pothos::DType dtype(typeid(T));
+    static constexpr size_t RampLength = 100;
+
+    std::cout << "Testing " << dtype.name() << " (zero copy: " << zeroCopy << ")..." << std::endl;
+
+    auto patternSource = Pothos::BlockRegistry::make("/blocks/pattern_source", dtype);
+    patternSource.call("setZeroCopy", zeroCopy);
+    POTHOS_TEST_EQUAL("RAMP", patternSource.call<std::string>("pattern"));
+    POTHOS_TEST_THROWS(patternSource.call("setPattern", "SQUARE"), Pothos::InvalidArgumentException);
+    POTHOS_TEST_THROWS(patternSource.call("setRampLength", 0), Pothos::RangeException);
+    POTHOS_TEST_THROWS(patternSource.call("setPRBSOrder", 8), Pothos::InvalidArgumentException);
+
+    //
+    // Ramp
+    //
+
+    patternSource.call("setRampStart", rampStart);
+    patternSource.call("setRampStep", rampStep);
+    patternSource.call("setRampLength", RampLength);
+
+    auto buffer = runPatternSource(patternSource, dtype);
+
+    // The pattern continues between buffers, with or without zero copy.
+    const auto* rampOut = buffer.as<const T*>();
+    for(size_t elem = 0; elem < buffer.elements(); ++elem)
+    {
+        const auto phase = elem % RampLength;
+        POTHOS_TEST_EQUAL(T(rampStart + (rampStep * T(phase))), rampOut[elem]);
+    }
+
+    //
+    // Constant
+    //
+
+    const T constant = rampStart + rampStep;
+    patternSource.call("setPattern", "CONSTANT");
+    patternSource.call("setConstant", constant);
+
+    buffer = runPatternSource(patternSource, dtype);
+    for(size_t elem = 0; elem < buffer.elements(); ++elem)
+    {
+        POTHOS_TEST_EQUAL(constant, buffer.as<const T*>()[elem]);
+    }
+
+    //
+    // PRBS
+    //
+
+    static constexpr std::uint64_t Seed = 12345;
+    patternSource.call("setPattern", "PRBS");
+    patternSource.call("setPRBSOrder", 15);
+    patternSource.call("setSeed", Seed);
+    POTHOS_TEST_EQUAL(15, patternSource.call<size_t>("prbsOrder"));
+
+    buffer = runPatternSource(patternSource, dtype);
+
+    std::vector<std::uint8_t> expectedBytes(buffer.length);
+    BlocksPRBS::Generator generator(15, Seed);
+    generator.generateBytes(expectedBytes.data(), expectedBytes.size());
+    POTHOS_TEST_EQUALA(expectedBytes.data(), buffer.as<const std::uint8_t*>(), expectedBytes.size());
+
+    //
+    // Random, which repeats with the same seed
+    //
+
+    patternSource.call("setPattern", "RANDOM");
+    patternSource.call("setSeed", Seed);
+    const auto random0 = runPatternSource(patternSource, dtype);
+    patternSource.call("setSeed", Seed);
+    const auto random1 = runPatternSource(patternSource, dtype);
+
+    const auto commonLength = std::min(random0.length, random1.length);
+    POTHOS_TEST_EQUAL(0, std::memcmp(random0.as<const void*>(), random1.as<const void*>(), commonLength));
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_pattern_source)
+{
+    for(bool zeroCopy: {false, true})
+    {
+        testPatternSource<std::int8_t>(-50, 3, zeroCopy);
+        testPatternSource<std::int16_t>(-1000, 17, zeroCopy);
+        testPatternSource<std::int32_t>(-100000, 33, zeroCopy);
+        testPatternSource<std::int64_t>(-1000000, 1001, zeroCopy);
+        testPatternSource<std::uint8_t>(5, 2, zeroCopy);
+        testPatternSource<std::uint16_t>(1000, 7, zeroCopy);
+        testPatternSource<std::uint32_t>(100000, 9, zeroCopy);
+        testPatternSource<std::uint64_t>(1000000, 11, zeroCopy);
+        testPatternSource<float>(-1.0f, 0.5f, zeroCopy);
+        testPatternSource<double>(-10.0, 0.25, zeroCopy);
+        testPatternSource<std::complex<float>>({-1.0f, 1.0f}, {0.5f, -0.25f}, zeroCopy);
+        testPatternSource<std::complex<double>>({-10.0, 10.0}, {0.25, -0.5}, zeroCopy);
+    }
+}
+
+// Slices are shared, so a block downstream that works in-place must copy them
+// instead of rewriting the ramp under later slices.
+POTHOS_TEST_BLOCK("/blocks/tests", test_pattern_source_in_place_downstream)
+{
+    const Pothos::DType dtype("uint16");
+    static constexpr std::uint16_t RampStart = 0x0100;
+    static constexpr size_t RampLength = 100;
+
+    auto patternSource = Pothos::BlockRegistry::make("/blocks/pattern_source", dtype);
+    patternSource.call("setZeroCopy", true);
+    patternSource.call("setRampStart", RampStart);
+    patternSource.call("setRampStep", 1);
+    patternSource.call("setRampLength", RampLength);
+
+    auto streamToPacket = Pothos::BlockRegistry::make("/blocks/stream_to_packet");
+    auto byteSwap = Pothos::BlockRegistry::make("/blocks/byteswap", dtype);
+    auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+    {
+        Pothos::Topology topology;
+        topology.connect(patternSource, 0, streamToPacket, 0);
+        topology.connect(streamToPacket, 0, byteSwap, 0);
+        topology.connect(byteSwap, 0, collectorSink, 0);
+        topology.commit();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    const auto packets = collectorSink.call<std::vector<Pothos::Packet>>("getPackets");
+    POTHOS_TEST_TRUE(packets.size() > 1);
+
+    // The packets continue the ramp, each value byteswapped once.
+    size_t elem = 0;
+    for(const auto& packet: packets)
+    {
+        const auto* values = packet.payload.as<const std::uint16_t*>();
+        for(size_t i = 0; i < packet.payload.elements(); ++i, ++elem)
+        {
+            const auto expected = std::uint16_t(RampStart + (elem % RampLength));
+            POTHOS_TEST_EQUAL(std::uint16_t((expected << 8) | (expected >> 8)), values[i]);
+        }
+    }
+}
@@ -103,3 +103,151 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_unit_testplans)
     POTHOS_TEST_TRUE(topology.waitInactive());
     collector.call("verifyTestPlan", expected1);
 }
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_seeded_testers)
+{
+    json testPlan;
+    testPlan["enableBuffers"] = true;
+    testPlan["enableLabels"] = true;
+    testPlan["enableMessages"] = true;
+
+    //run the same seeded test plan through a seeded labeler twice
+    std::vector<std::string> expected;
+    std::vector<std::vector<Pothos::Label>> labels;
+    for (size_t run = 0; run < 2; run++)
+    {
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+        auto labeler = Pothos::BlockRegistry::make("/blocks/sporadic_labeler");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+
+        feeder.call("setSeed", 12345);
+        labeler.call("setProbability", 0.1);
+        labeler.call("setIdList", std::vector<std::string>{"lbl0", "lbl1", "lbl2"});
+        labeler.call("setSeed", 67890);
+
+        expected.push_back(feeder.call<std::string>("feedTestPlan", testPlan.dump()));
+
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, labeler, 0);
+        topology.connect(labeler, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+
+        labels.push_back(collector.call<std::vector<Pothos::Label>>("getLabels"));
+    }
+
+    POTHOS_TEST_EQUAL(expected[0], expected[1]);
+    POTHOS_TEST_EQUAL(labels[0].size(), labels[1].size());
+    for (size_t i = 0; i < labels[0].size(); i++)
+    {
+        POTHOS_TEST_EQUAL(labels[0][i].id, labels[1][i].id);
+        POTHOS_TEST_EQUAL(labels[0][i].index, labels[1][i].index);
+    }
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_collector_sink_modes)
+{
+    for (const std::string mode : {"CHUNKS", "DIGEST"})
+    {
+        std::cout << "Testing collector sink mode " << mode << std::endl;
+
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+        collector.call("setMode", mode);
+        POTHOS_TEST_EQUAL(mode, collector.call<std::string>("getMode"));
+
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, collector, 0);
+
+        //stream test plan
+        json testPlan0;
+        testPlan0["enableBuffers"] = true;
+        testPlan0["enableLabels"] = true;
+        testPlan0["enableMessages"] = true;
+        auto expected0 = feeder.call("feedTestPlan", testPlan0.dump());
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+        collector.call("verifyTestPlan", expected0);
+
+        //packet test plan
+        json testPlan1;
+        testPlan1["enablePackets"] = true;
+        testPlan1["enableLabels"] = true;
+        testPlan1["enableMessages"] = true;
+        auto expected1 = feeder.call("feedTestPlan", testPlan1.dump());
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+        collector.call("verifyTestPlan", expected1);
+
+        //a different test plan must not verify
+        feeder.call("feedTestPlan", testPlan0.dump());
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+        bool mismatched = false;
+        try
+        {
+            collector.call("verifyTestPlan", expected0);
+        }
+        catch (const Pothos::Exception &)
+        {
+            mismatched = true;
+        }
+        POTHOS_TEST_TRUE(mismatched);
+    }
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_streaming_testplans)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+
+    Pothos::Topology topology;
+    topology.connect(feeder, 0, collector, 0);
+
+    //stream test plan, checked after it was collected
+    json testPlan0;
+    testPlan0["streaming"] = true;
+    testPlan0["enableBuffers"] = true;
+    testPlan0["enableLabels"] = true;
+    testPlan0["enableMessages"] = true;
+    auto expected0 = feeder.call<std::string>("feedTestPlan", testPlan0.dump());
+    std::cout << "Streaming test plan: " << expected0 << std::endl;
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+    collector.call("verifyTestPlan", expected0);
+
+    //packet test plan, checked after it was collected
+    json testPlan1;
+    testPlan1["streaming"] = true;
+    testPlan1["enablePackets"] = true;
+    testPlan1["enableLabels"] = true;
+    testPlan1["enableMessages"] = true;
+    auto expected1 = feeder.call<std::string>("feedTestPlan", testPlan1.dump());
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+    collector.call("verifyTestPlan", expected1);
+
+    //a long stream test plan, checked as it arrives
+    json testPlan2 = testPlan0;
+    testPlan2["minBuffers"] = 1000;
+    testPlan2["maxBuffers"] = 2000;
+    testPlan2["minBufferSize"] = 1000;
+    testPlan2["maxBufferSize"] = 10000;
+    auto expected2 = feeder.call<std::string>("feedTestPlan", testPlan2.dump());
+    collector.call("expectTestPlan", expected2);
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+    POTHOS_TEST_EQUAL(0, collector.call<Pothos::BufferChunk>("getBuffer").length);
+    collector.call("verifyTestPlan", expected2);
+
+    //a different test plan must not verify
+    collector.call("expectTestPlan", expected0);
+    feeder.call("feedTestPlan", testPlan0.dump());
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+    POTHOS_TEST_THROWS(collector.call("verifyTestPlan", expected0), Pothos::Exception);
+
+    //only streaming test plans can be checked as they arrive
+    auto expected3 = feeder.call<std::string>("feedTestPlan", json({{"enableBuffers", true}}).dump());
+    POTHOS_TEST_THROWS(collector.call("expectTestPlan", expected3), Pothos::Exception);
+}
@@ -0,0 +1,359 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+//
+// Measures how a representative processing chain scales with thread pools.
+//
+// Each chain is infinite_source -> reinterpret -> converter -> 2x clamp ->
+// interleaver -> copier -> black_hole, and several independent chains can
+// run side by side so that wide machines have enough blocks to keep busy.
+// The chains are run under:
+//
+//  * one shared pool of 1..N threads for the whole topology
+//  * one single-threaded pool per block
+//
+// each with and without CPU affinity. Every run reports its throughput,
+// and its efficiency against the single-threaded shared pool, as JSON so
+// curves can be plotted and compared between machines.
+//
+
+#include <Pothos/Framework.hpp>
+#include <Pothos/Init.hpp>
+#include <Pothos/Proxy.hpp>
+
+#include <json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using json = nlohmann::json;
+
+//
+// Options
+//
+
+struct BenchmarkOptions
+{
+    std::string outputPath;
+
+    std::vector<size_t> threadCounts; // Empty for powers of two up to the number of CPUs
+    size_t numChains{1};
+    double warmupSeconds{0.5};
+    double durationSeconds{3.0};
+    size_t sourceMTU{0};              // Bytes per source buffer, 0 for the whole buffer
+    std::string yieldMode{"CONDITION"};
+};
+
+static void printUsage(const char* argv0)
+{
+    std::cerr << "Usage: " << argv0 << " [options]" << std::endl
+              << "  --output <path>        Output file (default: stdout)" << std::endl
+              << "  --threads <n,n,...>    Shared pool sizes (default: powers of two up to the number of CPUs)" << std::endl
+              << "  --chains <n>           Independent chains to run at once (default: 1)" << std::endl
+              << "  --warmup <seconds>     Time to run before measuring (default: 0.5)" << std::endl
+              << "  --duration <seconds>   Time to measure each configuration (default: 3)" << std::endl
+              << "  --mtu <bytes>          Maximum bytes per source buffer (default: unlimited)" << std::endl
+              << "  --yield <mode>         Thread pool yield mode: CONDITION, HYBRID, or SPIN" << std::endl;
+}
+
+static std::vector<size_t> parseThreadCounts(const std::string& value)
+{
+    std::vector<size_t> threadCounts;
+
+    std::stringstream stream(value);
+    std::string token;
+    while(std::getline(stream, token, ','))
+    {
+        const auto numThreads = std::stoull(token);
+        if(0 == numThreads) throw std::invalid_argument("Thread counts must be positive");
+        threadCounts.push_back(size_t(numThreads));
+    }
+
+    return threadCounts;
+}
+
+static bool parseOptions(int argc, char** argv, BenchmarkOptions& options)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if(("--help" == arg) || ("-h" == arg)) return false;
+        if((i + 1) >= argc)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+
+        const std::string value(argv[++i]);
+        if("--output" == arg)        options.outputPath = value;
+        else if("--threads" == arg)  options.threadCounts = parseThreadCounts(value);
+        else if("--chains" == arg)   options.numChains = std::stoull(value);
+        else if("--warmup" == arg)   options.warmupSeconds = std::stod(value);
+        else if("--duration" == arg) options.durationSeconds = std::stod(value);
+        else if("--mtu" == arg)      options.sourceMTU = std::stoull(value);
+        else if("--yield" == arg)    options.yieldMode = value;
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if(0 == options.numChains)
+    {
+        std::cerr << "At least one chain is required" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+static size_t numCPUs()
+{
+    const auto numCPUs = std::thread::hardware_concurrency();
+    return (numCPUs > 0) ? numCPUs : 1;
+}
+
+static std::vector<size_t> defaultThreadCounts()
+{
+    std::vector<size_t> threadCounts;
+    for(size_t numThreads = 1; numThreads < numCPUs(); numThreads *= 2) threadCounts.push_back(numThreads);
+    threadCounts.push_back(numCPUs());
+
+    return threadCounts;
+}
+
+//
+// Chains
+//
+
+static const std::string SinkNamePrefix = "benchmark_sink_";
+
+struct Chain
+{
+    std::vector<Pothos::Proxy> blocks;
+};
+
+static Chain makeChain(Pothos::Topology& topology, size_t index, const BenchmarkOptions& options)
+{
+    static const std::string DType = "float32";
+
+    auto source = Pothos::BlockRegistry::make("/blocks/infinite_source");
+    source.call("enableBuffers", true);
+    source.call("setBufferMTU", options.sourceMTU);
+
+    // The source produces untyped bytes, so give them a type for the converter.
+    auto reinterpret = Pothos::BlockRegistry::make("/blocks/reinterpret", "int16");
+    auto converter = Pothos::BlockRegistry::make("/blocks/converter", DType);
+
+    auto clamp0 = Pothos::BlockRegistry::make("/blocks/clamp", DType);
+    auto clamp1 = Pothos::BlockRegistry::make("/blocks/clamp", DType);
+    for(auto& clamp: {clamp0, clamp1}) clamp.call("setMinAndMax", -1000.0f, 1000.0f);
+
+    auto interleaver = Pothos::BlockRegistry::make("/blocks/interleaver", DType, 2);
+    auto copier = Pothos::BlockRegistry::make("/blocks/copier");
+
+    auto sink = Pothos::BlockRegistry::make("/blocks/black_hole");
+    sink.call("setName", SinkNamePrefix + std::to_string(index));
+
+    topology.connect(source, 0, reinterpret, 0);
+    topology.connect(reinterpret, 0, converter, 0);
+    topology.connect(converter, 0, clamp0, 0);
+    topology.connect(converter, 0, clamp1, 0);
+    topology.connect(clamp0, 0, interleaver, 0);
+    topology.connect(clamp1, 0, interleaver, 1);
+    topology.connect(interleaver, 0, copier, 0);
+    topology.connect(copier, 0, sink, 0);
+
+    Chain chain;
+    chain.blocks = {source, reinterpret, converter, clamp0, clamp1, interleaver, copier, sink};
+
+    return chain;
+}
+
+//
+// Runs
+//
+
+struct RunConfig
+{
+    std::string poolMode; // "shared" or "per_block"
+    bool affinity;
+    size_t numThreads;    // Only set for shared pools
+};
+
+static Pothos::ThreadPoolArgs makePoolArgs(size_t numThreads, bool affinity, size_t firstCPU, const std::string& yieldMode)
+{
+    Pothos::ThreadPoolArgs args(numThreads);
+    args.yieldMode = yieldMode;
+    if(affinity)
+    {
+        args.affinityMode = "CPU";
+        for(size_t thread = 0; thread < numThreads; ++thread)
+        {
+            args.affinity.push_back((firstCPU + thread) % numCPUs());
+        }
+    }
+    else args.affinityMode = "ALL";
+
+    return args;
+}
+
+static unsigned long long sinkBytes(Pothos::Topology& topology)
+{
+    const auto stats = json::parse(topology.queryJSONStats());
+
+    unsigned long long total = 0;
+    for(auto it = stats.begin(); it != stats.end(); ++it)
+    {
+        const auto& blockStats = it.value();
+        if(0 != blockStats.value("blockName", std::string()).find(SinkNamePrefix)) continue;
+        for(const auto& portStats: blockStats.value("inputStats", json::array()))
+        {
+            total += portStats.value("totalElements", 0ULL);
+        }
+    }
+
+    return total;
+}
+
+static json runConfig(const RunConfig& config, const BenchmarkOptions& options)
+{
+    Pothos::Topology topology;
+
+    std::vector<Chain> chains;
+    for(size_t index = 0; index < options.numChains; ++index)
+    {
+        chains.push_back(makeChain(topology, index, options));
+    }
+
+    size_t totalThreads = config.numThreads;
+    if("shared" == config.poolMode)
+    {
+        topology.setThreadPool(Pothos::ThreadPool(makePoolArgs(config.numThreads, config.affinity, 0, options.yieldMode)));
+    }
+    else
+    {
+        // Each block gets its own thread, pinned round-robin across the CPUs.
+        totalThreads = 0;
+        for(auto& chain: chains)
+        {
+            for(auto& block: chain.blocks)
+            {
+                block.call("setThreadPool", Pothos::ThreadPool(makePoolArgs(1, config.affinity, totalThreads++, options.yieldMode)));
+            }
+        }
+    }
+
+    topology.commit();
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.warmupSeconds));
+
+    const auto startBytes = sinkBytes(topology);
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.durationSeconds));
+
+    const auto endBytes = sinkBytes(topology);
+    const auto elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    topology.disconnectAll();
+    topology.commit();
+
+    json result(json::object());
+    result["poolMode"] = config.poolMode;
+    result["affinity"] = config.affinity;
+    result["threads"] = totalThreads;
+    result["measuredSeconds"] = elapsedSeconds;
+    result["sinkBytes"] = endBytes - startBytes;
+    result["bytesPerSecond"] = (elapsedSeconds > 0.0) ? ((endBytes - startBytes) / elapsedSeconds) : 0.0;
+
+    return result;
+}
+
+//
+// Main
+//
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    try
+    {
+        if(!parseOptions(argc, argv, options))
+        {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << "Invalid option: " << ex.what() << std::endl;
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if(options.threadCounts.empty()) options.threadCounts = defaultThreadCounts();
+
+    std::vector<RunConfig> configs;
+    for(const bool affinity: {false, true})
+    {
+        for(const auto numThreads: options.threadCounts) configs.push_back(RunConfig{"shared", affinity, numThreads});
+        configs.push_back(RunConfig{"per_block", affinity, 0});
+    }
+
+    Pothos::ScopedInit init;
+
+    json runs(json::array());
+    for(const auto& config: configs)
+    {
+        std::cerr << "Running " << config.poolMode
+                  << (config.affinity ? " (CPU affinity)" : "")
+                  << ((config.numThreads > 0) ? (" with " + std::to_string(config.numThreads) + " threads") : "")
+                  << "..." << std::endl;
+        runs.push_back(runConfig(config, options));
+    }
+
+    // Efficiency is relative to the single-threaded shared pool with the same
+    // affinity, or without affinity when that was not run.
+    for(auto& run: runs)
+    {
+        double baseline = 0.0;
+        for(const auto& other: runs)
+        {
+            if(("shared" != other["poolMode"]) || (1 != other["threads"].get<size_t>())) continue;
+            if((0.0 == baseline) || (other["affinity"] == run["affinity"])) baseline = other["bytesPerSecond"];
+        }
+
+        const auto threads = run["threads"].get<size_t>();
+        run["speedup"] = (baseline > 0.0) ? (run["bytesPerSecond"].get<double>() / baseline) : 0.0;
+        run["efficiency"] = (threads > 0) ? (run["speedup"].get<double>() / threads) : 0.0;
+    }
+
+    json results(json::object());
+    results["cpus"] = numCPUs();
+    results["chains"] = options.numChains;
+    results["blocksPerChain"] = 8;
+    results["sourceMTU"] = options.sourceMTU;
+    results["yieldMode"] = options.yieldMode;
+    results["runs"] = runs;
+
+    std::ofstream file;
+    if(!options.outputPath.empty())
+    {
+        file.open(options.outputPath);
+        if(!file)
+        {
+            std::cerr << "Failed to open " << options.outputPath << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    auto& os = options.outputPath.empty() ? std::cout : file;
+    os << results.dump(4) << std::endl;
+
+    return EXIT_SUCCESS;
+}
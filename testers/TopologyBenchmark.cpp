@@ -0,0 +1,250 @@
+// Copyright (c) 2021 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+//
+// Runs a JSON topology under load and reports per-block statistics.
+//
+// The topology is loaded the same way as in TestJSONTopology. Each of its
+// input ports is fed by an infinite source and each of its output ports
+// drains into a black hole. It then runs for a fixed duration, or until the
+// black holes have consumed a given number of elements. Per-block work
+// counts and per-port element, buffer, label, and message totals come from
+// the framework's own statistics, and are written as JSON so results can be
+// compared between releases.
+//
+
+#include <Pothos/Framework.hpp>
+#include <Pothos/Init.hpp>
+#include <Pothos/Proxy.hpp>
+
+#include <json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using json = nlohmann::json;
+
+//
+// Options
+//
+
+struct BenchmarkOptions
+{
+    std::string topologyPath;
+    std::string outputPath;
+
+    double durationSeconds{10.0};
+    unsigned long long maxElements{0}; // 0 to only stop on the duration
+    size_t sourceMTU{0};               // Bytes per source buffer, 0 for the whole buffer
+    double pollSeconds{0.1};
+};
+
+static void printUsage(const char* argv0)
+{
+    std::cerr << "Usage: " << argv0 << " <topology.json> [options]" << std::endl
+              << "  --output <path>        Output file (default: stdout)" << std::endl
+              << "  --duration <seconds>   Maximum run time (default: 10)" << std::endl
+              << "  --elements <n>         Stop after the sinks consume this many elements" << std::endl
+              << "  --mtu <bytes>          Maximum bytes per source buffer (default: unlimited)" << std::endl
+              << "  --poll <seconds>       Interval between checks of the stop conditions" << std::endl;
+}
+
+static bool parseOptions(int argc, char** argv, BenchmarkOptions& options)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if(("--help" == arg) || ("-h" == arg)) return false;
+        if(0 != arg.find("--"))
+        {
+            options.topologyPath = arg;
+            continue;
+        }
+        if((i + 1) >= argc)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+
+        const std::string value(argv[++i]);
+        if("--output" == arg)        options.outputPath = value;
+        else if("--duration" == arg) options.durationSeconds = std::stod(value);
+        else if("--elements" == arg) options.maxElements = std::stoull(value);
+        else if("--mtu" == arg)      options.sourceMTU = std::stoull(value);
+        else if("--poll" == arg)     options.pollSeconds = std::stod(value);
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if(options.topologyPath.empty())
+    {
+        std::cerr << "No topology given" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+//
+// Statistics
+//
+
+static const std::string SinkNamePrefix = "benchmark_sink_";
+
+static json portTotals(const json& portStats)
+{
+    json totals(json::object());
+    totals["name"] = portStats.value("portName", std::string());
+    for(const auto& key: {"totalElements", "totalBuffers", "totalLabels", "totalMessages"})
+    {
+        totals[key] = portStats.value(key, 0ULL);
+    }
+
+    return totals;
+}
+
+// Reduces the output of Topology::queryJSONStats() to what we track.
+static json summarizeStats(const json& stats)
+{
+    json blocks(json::array());
+    for(auto it = stats.begin(); it != stats.end(); ++it)
+    {
+        const auto& blockStats = it.value();
+
+        json block(json::object());
+        block["uid"] = it.key();
+        block["name"] = blockStats.value("blockName", std::string());
+        block["workCalls"] = blockStats.value("numWorkCalls", 0ULL);
+
+        block["inputs"] = json::array();
+        for(const auto& portStats: blockStats.value("inputStats", json::array()))
+        {
+            block["inputs"].push_back(portTotals(portStats));
+        }
+
+        block["outputs"] = json::array();
+        for(const auto& portStats: blockStats.value("outputStats", json::array()))
+        {
+            block["outputs"].push_back(portTotals(portStats));
+        }
+
+        blocks.push_back(std::move(block));
+    }
+
+    return blocks;
+}
+
+static unsigned long long sinkElements(const json& blocks)
+{
+    unsigned long long total = 0;
+    for(const auto& block: blocks)
+    {
+        if(0 != block["name"].get<std::string>().find(SinkNamePrefix)) continue;
+        for(const auto& input: block["inputs"]) total += input["totalElements"].get<unsigned long long>();
+    }
+
+    return total;
+}
+
+//
+// Main
+//
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    if(!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream topologyFile(options.topologyPath);
+    if(!topologyFile)
+    {
+        std::cerr << "Failed to open " << options.topologyPath << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::stringstream topologyJSON;
+    topologyJSON << topologyFile.rdbuf();
+
+    Pothos::ScopedInit init;
+
+    auto benchmarked = Pothos::Topology::make(topologyJSON.str());
+
+    Pothos::Topology topology;
+    for(const auto& port: benchmarked->inputPortInfo())
+    {
+        auto source = Pothos::BlockRegistry::make("/blocks/infinite_source");
+        source.call("enableBuffers", true);
+        source.call("setBufferMTU", options.sourceMTU);
+        topology.connect(source, 0, benchmarked, port.name);
+    }
+    for(const auto& port: benchmarked->outputPortInfo())
+    {
+        auto sink = Pothos::BlockRegistry::make("/blocks/black_hole");
+        sink.call("setName", SinkNamePrefix + port.name);
+        topology.connect(benchmarked, port.name, sink, 0);
+    }
+
+    std::cerr << "Running " << options.topologyPath << "..." << std::endl;
+
+    const auto startTime = std::chrono::steady_clock::now();
+    topology.commit();
+
+    const auto poll = std::chrono::duration<double>(options.pollSeconds);
+    std::string stopReason = "duration";
+    json blocks;
+    double elapsedSeconds = 0.0;
+    while(true)
+    {
+        std::this_thread::sleep_for(poll);
+
+        blocks = summarizeStats(json::parse(topology.queryJSONStats()));
+        elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+        if((options.maxElements > 0) && (sinkElements(blocks) >= options.maxElements))
+        {
+            stopReason = "elements";
+            break;
+        }
+        if(elapsedSeconds >= options.durationSeconds) break;
+    }
+
+    topology.disconnectAll();
+    topology.commit();
+
+    const auto elements = sinkElements(blocks);
+
+    json results(json::object());
+    results["topology"] = options.topologyPath;
+    results["stopReason"] = stopReason;
+    results["wallSeconds"] = elapsedSeconds;
+    results["sinkElements"] = elements;
+    results["sinkElementsPerSecond"] = (elapsedSeconds > 0.0) ? (elements / elapsedSeconds) : 0.0;
+    results["blocks"] = blocks;
+
+    std::ofstream file;
+    if(!options.outputPath.empty())
+    {
+        file.open(options.outputPath);
+        if(!file)
+        {
+            std::cerr << "Failed to open " << options.outputPath << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    auto& os = options.outputPath.empty() ? std::cout : file;
+    os << results.dump(4) << std::endl;
+
+    return EXIT_SUCCESS;
+}